@@ -0,0 +1,115 @@
+// Sweeps term length x MTU over one channel and prints throughput / loopback latency as CSV.
+// Usage: epoch_cpp_channel_sweep [channel] [messages] [--embedded]
+#include "epoch/aeron_transport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct SweepResult {
+    double messages_per_second;
+    std::int64_t p50_ns;
+    std::int64_t p99_ns;
+    std::int64_t back_pressure;
+};
+
+SweepResult run_case(const epoch::AeronConfig &config, std::int64_t messages)
+{
+    epoch::AeronTransport transport(config);
+    std::pmr::vector<epoch::Message> inbound;
+    inbound.reserve(static_cast<std::size_t>(config.fragment_limit));
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(static_cast<std::size_t>(messages));
+
+    std::int64_t received = 0;
+    std::int64_t started = now_ns();
+    for (std::int64_t seq = 0; seq < messages; ++seq)
+    {
+        epoch::Message message{1, 1, 1, seq, 0, 0, now_ns()};
+        while (transport.try_send(message) != epoch::SendResult::Sent)
+        {
+            inbound.clear();
+            transport.poll_into(inbound, static_cast<std::size_t>(config.fragment_limit));
+            for (const auto &in : inbound)
+            {
+                latencies.push_back(now_ns() - in.payload);
+            }
+            received += static_cast<std::int64_t>(inbound.size());
+        }
+    }
+    while (received < messages && now_ns() - started < 10000000000LL)
+    {
+        inbound.clear();
+        transport.poll_into(inbound, static_cast<std::size_t>(config.fragment_limit));
+        for (const auto &in : inbound)
+        {
+            latencies.push_back(now_ns() - in.payload);
+        }
+        received += static_cast<std::int64_t>(inbound.size());
+    }
+    std::int64_t elapsed = std::max<std::int64_t>(1, now_ns() - started);
+
+    SweepResult result{static_cast<double>(received) * 1e9 / static_cast<double>(elapsed), 0, 0,
+                       transport.stats().offer_back_pressure};
+    if (!latencies.empty())
+    {
+        std::sort(latencies.begin(), latencies.end());
+        result.p50_ns = latencies[latencies.size() / 2];
+        result.p99_ns = latencies[latencies.size() * 99 / 100];
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string channel = argc > 1 ? argv[1] : "aeron:ipc";
+    std::int64_t messages = argc > 2 ? std::atoll(argv[2]) : 1000000;
+    bool embedded = argc > 3 && std::strcmp(argv[3], "--embedded") == 0;
+
+    const std::int32_t term_lengths[] = {64 * 1024, 1024 * 1024, 16 * 1024 * 1024};
+    const std::int32_t mtus[] = {1408, 4096, 8192};
+
+    std::printf("channel,term_length,mtu,messages_per_second,p50_ns,p99_ns,back_pressure\n");
+    for (std::int32_t term_length : term_lengths)
+    {
+        for (std::int32_t mtu : mtus)
+        {
+            epoch::AeronConfig config{channel, 1001, "", 256, 1};
+            config.channel_params.term_length = term_length;
+            config.channel_params.mtu_length = mtu;
+            config.embedded_driver.enabled = embedded;
+            config.embedded_driver.dir_delete_on_start = embedded;
+            auto status = epoch::validate_channel_params(config.channel, config.channel_params);
+            if (!status.ok())
+            {
+                std::fprintf(stderr, "skip term_length=%d mtu=%d: %s\n", term_length, mtu, status.message().c_str());
+                continue;
+            }
+            auto result = run_case(config, messages);
+            std::printf("%s,%d,%d,%.0f,%lld,%lld,%lld\n",
+                        channel.c_str(),
+                        term_length,
+                        mtu,
+                        result.messages_per_second,
+                        static_cast<long long>(result.p50_ns),
+                        static_cast<long long>(result.p99_ns),
+                        static_cast<long long>(result.back_pressure));
+        }
+    }
+    return 0;
+}
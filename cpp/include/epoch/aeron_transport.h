@@ -1,20 +1,48 @@
 #pragma once
 
+#include "epoch/channel_uri.h"
+#include "epoch/loss_report.h"
+#include "epoch/media_driver.h"
+#include "epoch/poll_budget.h"
+#include "epoch/status.h"
 #include "epoch/transport.h"
 
 #include <aeronc.h>
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace epoch {
 
+class Archive;
+
+// Broadcast fan-out splits the two halves: the sender only publishes (multicast group or MDC control
+// endpoint) and every receiver only subscribes, so the sender never polls its own stream.
+enum class AeronRole {
+    Duplex,
+    PublishOnly,
+    SubscribeOnly,
+};
+
 struct AeronConfig {
     std::string channel;
     std::int32_t stream_id;
     std::string aeron_directory;
     std::int32_t fragment_limit = 64;
     std::int32_t offer_max_attempts = 10;
+    // Appended to channel as URI parameters after validation (termBufferLength, mtuLength, lingerNs, ...).
+    ChannelParams channel_params{};
+    // When set, every inbound frame is recorded before it is decoded (archiveEnabled).
+    Archive *archive = nullptr;
+    // Launches the media driver in-process before connecting; aeron_directory (if set) is used for both.
+    EmbeddedDriverConfig embedded_driver{};
+    AeronRole role = AeronRole::Duplex;
+    // Sizes each subscription poll from image lag and the epoch deadline instead of the fixed fragment_limit.
+    PollBudgetConfig poll_budget{};
 };
 
 struct AeronStats {
@@ -26,10 +54,35 @@ struct AeronStats {
     std::int64_t offer_closed = 0;
     std::int64_t offer_max_position = 0;
     std::int64_t offer_failed = 0;
+    std::int64_t archive_failures = 0;
+    PollBudgetStats poll_budget;
+    // Image events from the client conductor, folded in on each poll.
+    std::int64_t images_available = 0;
+    std::int64_t images_unavailable = 0;
+    // Images that went unavailable before end of stream: the publisher timed out or disconnected.
+    std::int64_t images_lost = 0;
+    // Driver loss reports for this stream, refreshed by image_metrics().
+    std::int64_t loss_observations = 0;
+    std::int64_t bytes_lost = 0;
+};
+
+struct AeronImageMetrics {
+    std::int32_t session_id = 0;
+    std::int64_t correlation_id = 0;
+    std::int64_t join_position = 0;
+    std::int64_t position = 0;
+    // Receiver high-water mark (UDP) or publisher position (IPC); -1 without a counter, and then lag is -1 too.
+    std::int64_t receiver_position = -1;
+    std::int64_t lag_bytes = -1;
+    std::int64_t loss_observations = 0;
+    std::int64_t bytes_lost = 0;
+    bool end_of_stream = false;
+    std::string source_identity;
 };
 
 class AeronTransport final : public Transport {
 public:
+    // Throws std::runtime_error on failure; open() is the status-returning equivalent.
     explicit AeronTransport(AeronConfig config);
     ~AeronTransport() override;
 
@@ -38,21 +91,75 @@ public:
     AeronTransport(AeronTransport &&) = delete;
     AeronTransport &operator=(AeronTransport &&) = delete;
 
+    static Result<std::unique_ptr<AeronTransport>> open(AeronConfig config);
+
     void send(const Message &message) override;
+    SendResult try_send(const Message &message) override;
     std::vector<Message> poll(std::size_t max) override;
+    std::size_t poll_into(std::pmr::vector<Message> &out, std::size_t max) override;
     void close() override;
 
+    // Non-throwing variants for the hot loop; nothing allocates on failure.
+    Status send_status(const Message &message);
+    Result<std::size_t> try_poll(std::pmr::vector<Message> &out, std::size_t max);
+
     const AeronConfig &config() const;
     const AeronStats &stats() const;
+    // The channel URI actually used: config().channel plus channel_params.
+    const std::string &channel_uri() const;
+    // Non-null while an embedded driver launched by this transport is running.
+    const EmbeddedMediaDriver *embedded_driver() const;
+
+    // End of the current epoch on the steady clock (TickDriver::deadline_ns()); -1 = no deadline. Only the
+    // adaptive poll budget uses it.
+    void set_epoch_deadline(std::int64_t deadline_ns);
+    // Bytes received by the driver but not yet polled, summed over images (receiver high-water mark, or the
+    // publisher position for IPC, minus the image position); -1 while no image counter is known.
+    std::int64_t image_lag_bytes();
+    // One entry per connected image, with the driver's loss reports for its session; also refreshes the loss
+    // totals in stats(). Reads counters and the loss report file, so call it from a monitoring cadence (once per
+    // epoch or slower), on the polling thread.
+    std::size_t image_metrics(std::vector<AeronImageMetrics> &out);
 
 private:
+    struct Unconnected {};
+
+    AeronTransport(AeronConfig config, Unconnected);
+    Status connect();
+    std::size_t next_poll_limit(std::size_t max);
+    void finish_poll(std::size_t fragments, std::int64_t started_ns);
+    void refresh_image_counters();
+    const std::int64_t *image_counter(std::int32_t session_id);
+    void sync_image_events();
+
+    // Called on the client conductor thread.
+    static void on_available_image(void *clientd, aeron_subscription_t *subscription, aeron_image_t *image);
+    static void on_unavailable_image(void *clientd, aeron_subscription_t *subscription, aeron_image_t *image);
+
+    struct ImageEvents {
+        std::atomic<std::int64_t> available{0};
+        std::atomic<std::int64_t> unavailable{0};
+        std::atomic<std::int64_t> lost{0};
+    };
+
     AeronConfig config_;
+    std::string channel_uri_;
     AeronStats stats_;
     bool closed_ = false;
     aeron_context_t *context_ = nullptr;
     aeron_t *client_ = nullptr;
     aeron_publication_t *publication_ = nullptr;
     aeron_subscription_t *subscription_ = nullptr;
+    std::unique_ptr<EmbeddedMediaDriver> driver_;
+    PollBudget budget_;
+    std::int64_t deadline_ns_ = -1;
+    // session id -> position counter of that image's publisher side, rebuilt when the image count changes.
+    std::vector<std::pair<std::int32_t, const std::int64_t *>> image_counters_;
+    int image_count_ = -1;
+    ImageEvents image_events_;
+    // Directory the client connected to; the loss report lives there.
+    std::string directory_;
+    std::unique_ptr<LossReportReader> loss_report_;
 };
 
 namespace detail {
@@ -75,6 +182,17 @@ struct AeronHooks {
     int (*close)(aeron_t *);
     int (*context_close)(aeron_context_t *);
     const char *(*errmsg)();
+    int (*subscription_image_count)(aeron_subscription_t *);
+    void (*subscription_for_each_image)(aeron_subscription_t *, void (*)(aeron_image_t *, void *), void *);
+    int (*image_constants)(aeron_image_t *, aeron_image_constants_t *);
+    int64_t (*image_position)(aeron_image_t *);
+    aeron_counters_reader_t *(*counters_reader)(aeron_t *);
+    void (*counters_reader_foreach_counter)(aeron_counters_reader_t *,
+                                            aeron_counters_reader_foreach_counter_func_t,
+                                            void *);
+    int64_t *(*counters_reader_addr)(aeron_counters_reader_t *, int32_t);
+    bool (*image_is_end_of_stream)(aeron_image_t *);
+    const char *(*context_get_dir)(aeron_context_t *);
 };
 
 AeronHooks &aeron_hooks();
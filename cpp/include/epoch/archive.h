@@ -0,0 +1,114 @@
+#pragma once
+
+#include "epoch/status.h"
+#include "epoch/transport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace epoch {
+
+constexpr std::int64_t kArchiveEnd = -1;
+
+// Invoked once per recorded frame during replay; position is the byte offset of the frame in the recording.
+using ArchiveFrameHandler = void (*)(void *clientd, const std::uint8_t *frame, std::size_t length, std::int64_t position);
+
+// Durable record of an input stream, addressed by byte position like an Aeron recording.
+class Archive {
+public:
+    virtual ~Archive() = default;
+    // Appends one frame and returns its start position.
+    virtual Result<std::int64_t> record(const std::uint8_t *frame, std::size_t length) = 0;
+    // Replays frames whose start position lies in [from, to); to == kArchiveEnd means the current end.
+    virtual std::size_t replay(std::int64_t from, std::int64_t to, std::size_t max, ArchiveFrameHandler handler,
+                               void *clientd) = 0;
+    virtual std::int64_t stop_position() const = 0;
+    virtual Status flush() = 0;
+};
+
+// Local stand-in: frames are kept in memory and, when a path is given, appended to a journal file of raw v1
+// frames (positions are byte offsets, so the file is the recording). Opening an existing journal resumes it,
+// cutting a torn trailing frame off the file first.
+// The in-memory copy that replay reads comes from memory (default: the global heap), e.g. a PageMemoryResource.
+class LocalArchive final : public Archive {
+public:
+    explicit LocalArchive(std::pmr::memory_resource *memory = nullptr);
+    ~LocalArchive() override;
+
+    LocalArchive(const LocalArchive &) = delete;
+    LocalArchive &operator=(const LocalArchive &) = delete;
+
+    static Result<std::unique_ptr<LocalArchive>> open(const std::string &path,
+                                                      std::pmr::memory_resource *memory = nullptr);
+
+    // Sizes the in-memory copy for bytes of recording, so record() does not grow it while the loop runs.
+    void reserve(std::size_t bytes);
+
+    Result<std::int64_t> record(const std::uint8_t *frame, std::size_t length) override;
+    std::size_t replay(std::int64_t from, std::int64_t to, std::size_t max, ArchiveFrameHandler handler,
+                       void *clientd) override;
+    std::int64_t stop_position() const override;
+    Status flush() override;
+
+    const std::string &path() const;
+
+private:
+    std::pmr::vector<std::uint8_t> data_;
+    std::string path_;
+    std::FILE *journal_ = nullptr;
+};
+
+// Records every polled message into an archive before handing it to the caller.
+class RecordingTransport final : public Transport {
+public:
+    RecordingTransport(Transport &inner, Archive &archive);
+
+    void send(const Message &message) override;
+    SendResult try_send(const Message &message) override;
+    std::vector<Message> poll(std::size_t max) override;
+    std::size_t poll_into(std::pmr::vector<Message> &out, std::size_t max) override;
+    void close() override;
+
+    std::int64_t record_failures() const;
+
+private:
+    void record(const Message &message);
+
+    Transport &inner_;
+    Archive &archive_;
+    std::int64_t record_failures_ = 0;
+};
+
+// Replays a recorded position range as a Transport, so the runtime consumes it through the production path at
+// full speed. Sends are counted and dropped.
+class ReplayTransport final : public Transport {
+public:
+    ReplayTransport(Archive &archive, std::int64_t from = 0, std::int64_t to = kArchiveEnd);
+
+    void send(const Message &message) override;
+    SendResult try_send(const Message &message) override;
+    std::vector<Message> poll(std::size_t max) override;
+    std::size_t poll_into(std::pmr::vector<Message> &out, std::size_t max) override;
+    void close() override;
+
+    std::int64_t position() const;
+    bool done() const;
+    std::int64_t dropped_sends() const;
+
+private:
+    template <typename Vector>
+    std::size_t replay_into(Vector &out, std::size_t max);
+
+    Archive &archive_;
+    std::int64_t position_;
+    std::int64_t to_;
+    bool closed_ = false;
+    std::int64_t dropped_sends_ = 0;
+};
+
+} // namespace epoch
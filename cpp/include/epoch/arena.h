@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace epoch {
+
+// Monotonic per-epoch scratch memory. deallocate is a no-op; reset() rewinds to the first block in
+// O(1) and keeps every block for the next epoch, so the steady state never touches the upstream heap.
+class EpochArena final : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t kDefaultBlockSize = 1 << 20;
+
+    explicit EpochArena(std::size_t block_size = kDefaultBlockSize,
+                        std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+    ~EpochArena() override;
+
+    EpochArena(const EpochArena &) = delete;
+    EpochArena &operator=(const EpochArena &) = delete;
+
+    void reset();
+    // Allocates blocks up front until reserved() >= bytes, so the first epochs take no upstream allocation
+    // (and, with a prefaulting upstream, no page fault).
+    void reserve(std::size_t bytes);
+
+    std::size_t used() const;
+    std::size_t reserved() const;
+    std::size_t high_water() const;
+    std::size_t block_count() const;
+
+private:
+    struct Block {
+        std::byte *data;
+        std::size_t size;
+    };
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *, std::size_t, std::size_t) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    void *try_allocate(std::size_t bytes, std::size_t alignment);
+
+    std::pmr::memory_resource *upstream_;
+    std::size_t block_size_;
+    std::vector<Block> blocks_;
+    std::size_t current_ = 0;
+    std::size_t offset_ = 0;
+    std::size_t used_ = 0;
+    std::size_t reserved_ = 0;
+    std::size_t high_water_ = 0;
+};
+
+template <typename T>
+using ArenaVector = std::pmr::vector<T>;
+
+} // namespace epoch
@@ -0,0 +1,252 @@
+#pragma once
+
+#include "epoch/channel.h"
+#include "epoch/status.h"
+#include "epoch/transport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace epoch {
+
+template <typename T>
+class BroadcastReader;
+
+// Single-producer, many-reader ring. publish() never looks at readers, so its cost does not grow with the
+// number of subscribers; a reader that falls more than capacity() behind is lapped, skips to the oldest
+// retained entry and counts what it missed in lost(). Each slot carries a sequence (odd while being written,
+// 2 * (index + 1) once complete) so a reader can detect that its copy was overwritten underneath it.
+template <typename T>
+class BroadcastRing {
+    static_assert(std::is_trivially_copyable<T>::value, "BroadcastRing requires a trivially copyable type");
+
+public:
+    // Slots come from resource (default: the global heap).
+    explicit BroadcastRing(std::size_t capacity, std::pmr::memory_resource *resource = nullptr)
+        : resource_(resource == nullptr ? std::pmr::new_delete_resource() : resource)
+    {
+        if (capacity == 0)
+        {
+            EPOCH_THROW(std::invalid_argument("broadcast capacity must be positive"));
+        }
+        std::size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        slots_ = static_cast<Slot *>(resource_->allocate(size * sizeof(Slot), alignof(Slot)));
+        std::uninitialized_default_construct_n(slots_, size);
+        mask_ = size - 1;
+    }
+
+    ~BroadcastRing()
+    {
+        std::destroy_n(slots_, mask_ + 1);
+        resource_->deallocate(slots_, (mask_ + 1) * sizeof(Slot), alignof(Slot));
+    }
+
+    BroadcastRing(const BroadcastRing &) = delete;
+    BroadcastRing &operator=(const BroadcastRing &) = delete;
+
+    void publish(const T &value)
+    {
+        std::uint64_t index = tail_.load(std::memory_order_relaxed);
+        Slot &slot = slots_[index & mask_];
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.value = value;
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        tail_.store(index + 1, std::memory_order_release);
+    }
+
+    // Number of entries ever published; a new reader starts here.
+    std::uint64_t tail() const
+    {
+        return tail_.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    BroadcastReader<T> reader()
+    {
+        return BroadcastReader<T>(*this, tail());
+    }
+
+    BroadcastReader<T> reader_from_oldest()
+    {
+        std::uint64_t end = tail();
+        return BroadcastReader<T>(*this, end > capacity() ? end - capacity() : 0);
+    }
+
+private:
+    friend class BroadcastReader<T>;
+
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};
+        T value{};
+    };
+
+    std::pmr::memory_resource *resource_;
+    Slot *slots_ = nullptr;
+    std::size_t mask_ = 0;
+    alignas(kCacheLineSize) std::atomic<std::uint64_t> tail_{0};
+};
+
+// One per subscriber, used from a single thread; readers never write shared state.
+template <typename T>
+class BroadcastReader {
+public:
+    BroadcastReader(BroadcastRing<T> &ring, std::uint64_t cursor) : ring_(&ring), cursor_(cursor)
+    {
+    }
+
+    bool try_receive(T &value)
+    {
+        while (true)
+        {
+            const auto &slot = ring_->slots_[cursor_ & ring_->mask_];
+            std::uint64_t expected = 2 * cursor_ + 2;
+            std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before < expected)
+            {
+                return false;
+            }
+            if (before == expected)
+            {
+                value = slot.value;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == expected)
+                {
+                    cursor_++;
+                    return true;
+                }
+            }
+            catch_up();
+        }
+    }
+
+    template <typename Sink>
+    std::size_t receive(std::size_t max, Sink &&sink)
+    {
+        std::size_t count = 0;
+        T value{};
+        while (count < max && try_receive(value))
+        {
+            sink(value);
+            count++;
+        }
+        return count;
+    }
+
+    std::uint64_t position() const
+    {
+        return cursor_;
+    }
+
+    std::uint64_t lag() const
+    {
+        return ring_->tail() - cursor_;
+    }
+
+    std::int64_t lost() const
+    {
+        return lost_;
+    }
+
+private:
+    void catch_up()
+    {
+        std::uint64_t end = ring_->tail();
+        std::uint64_t oldest = end > ring_->capacity() ? end - ring_->capacity() : 0;
+        // If the slot at oldest is itself mid-overwrite the next read laps again; always make progress.
+        std::uint64_t resume = std::max(oldest, cursor_ + 1);
+        lost_ += static_cast<std::int64_t>(resume - cursor_);
+        cursor_ = resume;
+    }
+
+    BroadcastRing<T> *ring_;
+    std::uint64_t cursor_;
+    std::int64_t lost_ = 0;
+};
+
+// In-process fan-out of one epoch input stream: every BroadcastTransport on the same ring sees every message,
+// each at its own pace. send() must come from a single thread (the room's sequencer) and never blocks.
+class BroadcastTransport final : public Transport {
+public:
+    explicit BroadcastTransport(BroadcastRing<Message> &ring) : ring_(&ring), reader_(ring.reader())
+    {
+    }
+
+    void send(const Message &message) override
+    {
+        if (closed_)
+        {
+            EPOCH_THROW(std::runtime_error("broadcast transport is closed"));
+        }
+        ring_->publish(message);
+    }
+
+    SendResult try_send(const Message &message) override
+    {
+        if (closed_)
+        {
+            return SendResult::Closed;
+        }
+        ring_->publish(message);
+        return SendResult::Sent;
+    }
+
+    std::vector<Message> poll(std::size_t max) override
+    {
+        std::vector<Message> out;
+        take(out, max);
+        return out;
+    }
+
+    std::size_t poll_into(std::pmr::vector<Message> &out, std::size_t max) override
+    {
+        return take(out, max);
+    }
+
+    void close() override
+    {
+        closed_ = true;
+    }
+
+    std::uint64_t lag() const
+    {
+        return reader_.lag();
+    }
+
+    std::int64_t lost() const
+    {
+        return reader_.lost();
+    }
+
+private:
+    template <typename Vector>
+    std::size_t take(Vector &out, std::size_t max)
+    {
+        if (closed_)
+        {
+            return 0;
+        }
+        return reader_.receive(max, [&out](const Message &message) { out.push_back(message); });
+    }
+
+    BroadcastRing<Message> *ring_;
+    BroadcastReader<Message> reader_;
+    bool closed_ = false;
+};
+
+} // namespace epoch
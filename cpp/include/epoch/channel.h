@@ -0,0 +1,229 @@
+#pragma once
+
+#include "epoch/engine.h"
+#include "epoch/status.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+
+namespace epoch {
+
+constexpr std::size_t kCacheLineSize = 64;
+
+// Single-producer single-consumer ring; capacity is rounded up to a power of two. Slots come from resource
+// (default: the global heap), e.g. a NodeMemoryResource to keep them on the consumer's NUMA node.
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(std::size_t capacity, std::pmr::memory_resource *resource = nullptr)
+        : resource_(resource == nullptr ? std::pmr::new_delete_resource() : resource)
+    {
+        if (capacity == 0)
+        {
+            EPOCH_THROW(std::invalid_argument("ring capacity must be positive"));
+        }
+        std::size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        slots_ = static_cast<T *>(resource_->allocate(size * sizeof(T), kSlotAlignment));
+        std::uninitialized_default_construct_n(slots_, size);
+        mask_ = size - 1;
+    }
+
+    ~SpscRing()
+    {
+        std::destroy_n(slots_, mask_ + 1);
+        resource_->deallocate(slots_, (mask_ + 1) * sizeof(T), kSlotAlignment);
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    bool try_push(const T &value)
+    {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_)
+            {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T &value)
+    {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_)
+            {
+                return false;
+            }
+        }
+        value = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t size() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    std::size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+private:
+    static constexpr std::size_t kSlotAlignment = std::max(alignof(T), kCacheLineSize);
+
+    std::pmr::memory_resource *resource_;
+    T *slots_ = nullptr;
+    std::size_t mask_ = 0;
+    alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};
+    std::size_t cached_tail_ = 0;
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+    std::size_t cached_head_ = 0;
+};
+
+// QoS bands from protocol.md, highest first.
+enum class QosBand : std::uint8_t {
+    System = 0,
+    Control = 1,
+    Business = 2,
+    Default = 3,
+};
+
+constexpr std::size_t kQosBandCount = 4;
+
+constexpr QosBand qos_band(std::uint8_t qos)
+{
+    return qos >= 240   ? QosBand::System
+           : qos >= 128 ? QosBand::Control
+           : qos >= 1   ? QosBand::Business
+                        : QosBand::Default;
+}
+
+struct LaneConfig {
+    std::size_t capacity;
+    std::size_t budget;
+};
+
+struct PriorityInboxConfig {
+    std::array<LaneConfig, kQosBandCount> lanes{{{256, 64}, {1024, 256}, {8192, 1024}, {8192, 1024}}};
+    // Backing memory of the lane rings; null uses the global heap.
+    std::pmr::memory_resource *resource = nullptr;
+};
+
+struct LaneStats {
+    std::int64_t admitted = 0;
+    std::int64_t rejected = 0;
+    std::int64_t drained = 0;
+};
+
+// One SPSC ring per QoS band. drain() first takes up to each lane's budget in band order, then fills any
+// remaining room strictly by band, so a bulk flood cannot delay ops traffic and cannot starve itself either.
+class PriorityInbox {
+public:
+    explicit PriorityInbox(PriorityInboxConfig config = {})
+        : config_(config),
+          lanes_{SpscRing<Message>(config.lanes[0].capacity, config.resource),
+                 SpscRing<Message>(config.lanes[1].capacity, config.resource),
+                 SpscRing<Message>(config.lanes[2].capacity, config.resource),
+                 SpscRing<Message>(config.lanes[3].capacity, config.resource)}
+    {
+    }
+
+    bool try_push(const Message &message)
+    {
+        auto band = static_cast<std::size_t>(qos_band(message.qos));
+        if (!lanes_[band].try_push(message))
+        {
+            stats_[band].rejected++;
+            return false;
+        }
+        stats_[band].admitted++;
+        return true;
+    }
+
+    template <typename Sink>
+    std::size_t drain(std::size_t max, Sink &&sink)
+    {
+        std::size_t taken = 0;
+        for (std::size_t band = 0; band < kQosBandCount && taken < max; ++band)
+        {
+            taken += drain_lane(band, std::min(config_.lanes[band].budget, max - taken), sink);
+        }
+        for (std::size_t band = 0; band < kQosBandCount && taken < max; ++band)
+        {
+            taken += drain_lane(band, max - taken, sink);
+        }
+        return taken;
+    }
+
+    std::size_t size() const
+    {
+        std::size_t total = 0;
+        for (const auto &lane : lanes_)
+        {
+            total += lane.size();
+        }
+        return total;
+    }
+
+    std::size_t lane_size(QosBand band) const
+    {
+        return lanes_[static_cast<std::size_t>(band)].size();
+    }
+
+    const LaneStats &stats(QosBand band) const
+    {
+        return stats_[static_cast<std::size_t>(band)];
+    }
+
+    const PriorityInboxConfig &config() const
+    {
+        return config_;
+    }
+
+private:
+    template <typename Sink>
+    std::size_t drain_lane(std::size_t band, std::size_t limit, Sink &sink)
+    {
+        std::size_t taken = 0;
+        Message message{};
+        while (taken < limit && lanes_[band].try_pop(message))
+        {
+            sink(message);
+            taken++;
+        }
+        stats_[band].drained += static_cast<std::int64_t>(taken);
+        return taken;
+    }
+
+    PriorityInboxConfig config_;
+    std::array<SpscRing<Message>, kQosBandCount> lanes_;
+    std::array<LaneStats, kQosBandCount> stats_{};
+};
+
+} // namespace epoch
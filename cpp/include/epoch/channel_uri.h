@@ -0,0 +1,41 @@
+#pragma once
+
+#include "epoch/status.h"
+
+#include <cstdint>
+#include <string>
+
+namespace epoch {
+
+// Structured Aeron channel parameters; zero / negative values leave the URI parameter unset (driver default).
+struct ChannelParams {
+    std::string endpoint;
+    // term-length: power of two in [64 KiB, 1 GiB].
+    std::int32_t term_length = 0;
+    // mtu: multiple of 32 in [32, 65504].
+    std::int32_t mtu_length = 0;
+    // linger: nanoseconds a closed publication keeps draining; -1 = default.
+    std::int64_t linger_ns = -1;
+    // so-rcvbuf / so-sndbuf / rcv-wnd: UDP only.
+    std::int32_t socket_rcvbuf = 0;
+    std::int32_t socket_sndbuf = 0;
+    std::int32_t receiver_window = 0;
+    // Fan-out (UDP only). Multicast: endpoint is a class D group, interface/ttl pick the NIC and hop limit.
+    // MDC: the publisher sets control + control_mode ("dynamic" or "manual"); receivers set endpoint + control.
+    std::string control_endpoint;
+    std::string control_mode;
+    std::string network_interface;
+    std::int32_t ttl = 0;
+};
+
+constexpr std::int32_t kMinTermLength = 64 * 1024;
+constexpr std::int32_t kMaxTermLength = 1024 * 1024 * 1024;
+constexpr std::int32_t kMaxUdpPayloadLength = 65504;
+constexpr std::int32_t kFrameAlignment = 32;
+
+Status validate_channel_params(const std::string &base, const ChannelParams &params);
+// Appends the set parameters to base ("aeron:udp", "aeron:ipc?alias=x", ...). A parameter that base already
+// carries is rejected rather than silently overridden.
+Result<std::string> build_channel_uri(const std::string &base, const ChannelParams &params);
+
+} // namespace epoch
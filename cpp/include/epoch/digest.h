@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace epoch {
+
+// Hash of one (key, value) entry: mix64(fnv1a64(le64(key) || value)). See docs/guide/behavior.md.
+std::uint64_t digest_entry(std::uint64_t key, const void *value, std::size_t length);
+std::uint64_t digest_entry(std::uint64_t key, std::int64_t value);
+
+// Order-independent multiset digest: the sum (mod 2^64) of digest_entry over every live entry.
+// Each change costs one entry hash, so per-epoch work tracks the changes rather than the state size.
+class StateDigest {
+public:
+    void add(std::uint64_t key, const void *value, std::size_t length)
+    {
+        value_ += digest_entry(key, value, length);
+    }
+
+    void remove(std::uint64_t key, const void *value, std::size_t length)
+    {
+        value_ -= digest_entry(key, value, length);
+    }
+
+    void add(std::uint64_t key, std::int64_t value)
+    {
+        value_ += digest_entry(key, value);
+    }
+
+    void remove(std::uint64_t key, std::int64_t value)
+    {
+        value_ -= digest_entry(key, value);
+    }
+
+    void replace(std::uint64_t key, std::int64_t old_value, std::int64_t new_value)
+    {
+        value_ += digest_entry(key, new_value) - digest_entry(key, old_value);
+    }
+
+    void merge(const StateDigest &other)
+    {
+        value_ += other.value_;
+    }
+
+    void clear()
+    {
+        value_ = 0;
+    }
+
+    std::uint64_t value() const
+    {
+        return value_;
+    }
+
+    std::string hex() const;
+
+    bool operator==(const StateDigest &other) const
+    {
+        return value_ == other.value_;
+    }
+
+    bool operator!=(const StateDigest &other) const
+    {
+        return value_ != other.value_;
+    }
+
+private:
+    std::uint64_t value_ = 0;
+};
+
+} // namespace epoch
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "epoch/engine.h"
+#include "epoch/results.h"
+#include "epoch/status.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace epoch {
+
+// Shape of a generated vector. The message stream is a pure function of the spec (splitmix64 from seed), so
+// every implementation can be fed the same journal and compared on its results file.
+struct VectorSpec {
+    std::int64_t messages = 1000000;
+    std::int64_t epochs = 10000;
+    std::int64_t channels = 64;
+    std::int64_t sources = 256;
+    std::uint64_t seed = 1;
+};
+
+// Epochs, channels, sources, qos and payloads are random; source_seq counts up per source, so every message has
+// a distinct ordering key. The output is deliberately not in canonical order.
+std::vector<Message> generate_vector(const VectorSpec &spec);
+
+// Journal = raw v1 frames back to back, the same layout LocalArchive records.
+Status write_journal(const std::string &path, const std::vector<Message> &messages);
+Result<std::vector<Message>> read_journal(const std::string &path);
+
+// Sum-reducer results, computed on up to `threads` threads over contiguous epoch ranges: each range is sorted and
+// summed independently, then folded from the prefix sum of the ranges before it. Matches process_messages.
+std::vector<EpochRecord> process_parallel(const std::vector<Message> &messages, std::size_t threads);
+
+struct Divergence {
+    bool found = false;
+    // First record index that differs (or the shorter file's length when one is a prefix of the other).
+    std::size_t index = 0;
+    bool length_mismatch = false;
+    EpochRecord left{};
+    EpochRecord right{};
+    // Record pairs read to locate it: index + 1, or the common length when none differs.
+    std::size_t probes = 0;
+};
+
+// Sequential scan for the first differing record. Bisection is not valid here: a sum state depends only on the
+// payload total, so a run that goes wrong at one record can agree again at the next.
+Result<Divergence> first_divergence(ResultFileReader &left, ResultFileReader &right);
+
+} // namespace epoch
@@ -1,7 +1,14 @@
 #pragma once
 
+#include "epoch/arena.h"
+#include "epoch/trace.h"
+
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace epoch {
@@ -20,9 +27,176 @@ struct EpochResult {
     std::int64_t epoch;
     std::int64_t state;
     std::string hash;
+    std::string digest;
+};
+
+// Compact result for the arena path: the hash stays a raw fnv1a64 value until someone needs the hex string.
+struct EpochRecord {
+    std::int64_t epoch;
+    std::int64_t state;
+    std::uint64_t hash;
+    std::uint64_t digest;
 };
 
+std::uint64_t fnv1a64(const void *data, std::size_t length);
 std::string fnv1a64_hex(const std::string &input);
+std::string hash_hex(std::uint64_t hash);
+std::uint64_t state_hash(std::int64_t state);
+// StateDigest of the sum reducer: a single entry (key 0, state).
+std::uint64_t state_digest(std::int64_t state);
+
+// Canonical order: (epoch, channel_id, qos desc, source_id, source_seq).
+struct MessageOrder {
+    bool operator()(const Message &a, const Message &b) const
+    {
+        if (a.epoch != b.epoch)
+        {
+            return a.epoch < b.epoch;
+        }
+        if (a.channel_id != b.channel_id)
+        {
+            return a.channel_id < b.channel_id;
+        }
+        if (a.qos != b.qos)
+        {
+            return a.qos > b.qos;
+        }
+        if (a.source_id != b.source_id)
+        {
+            return a.source_id < b.source_id;
+        }
+        return a.source_seq < b.source_seq;
+    }
+};
+
+enum class SortPath {
+    Presorted,
+    Merged,
+    Sorted,
+};
+
+struct SortStats {
+    std::int64_t presorted = 0;
+    std::int64_t merged = 0;
+    std::int64_t sorted = 0;
+};
+
+// Batches with up to this many ascending runs are merged pairwise; anything more scrambled goes to std::sort.
+constexpr std::size_t kMaxMergeRuns = 32;
+
+// Puts [begin, end) into MessageOrder. One linear pass counts descents: none means the batch came presorted
+// (from a Sequencer, say) and nothing moves; a few (late high-qos messages) are fixed by merging the ascending
+// runs through scratch in O(n log runs). scratch only grows, so a reused one stops allocating.
+SortPath sort_messages(Message *begin, Message *end, std::pmr::vector<Message> &scratch);
+
+// Reducer contract: a State type, apply(State &, const Message &) and hash(const State &) -> uint64_t.
+// Both are called directly from the sorted loop, so they inline into it.
+struct SumReducer {
+    using State = std::int64_t;
+
+    static void apply(State &state, const Message &message)
+    {
+        state += message.payload;
+    }
+
+    static std::uint64_t hash(const State &state)
+    {
+        return state_hash(state);
+    }
+};
+
+// State persists across epochs; on_epoch(epoch, const State &, hash) fires once per epoch boundary.
+template <typename Reducer = SumReducer>
+class EpochEngine {
+public:
+    using State = typename Reducer::State;
+
+    explicit EpochEngine(Reducer reducer = Reducer{}, State initial = State{})
+        : reducer_(std::move(reducer)), state_(std::move(initial))
+    {
+    }
+
+    template <typename OnEpoch>
+    void fold(const Message *begin, const Message *end, OnEpoch &&on_epoch)
+    {
+        if (begin == end)
+        {
+            return;
+        }
+        EPOCH_TRACE_SCOPE(trace, TracePhase::Fold, end[-1].epoch);
+        EPOCH_TRACE_COUNT(trace, static_cast<std::size_t>(end - begin));
+        std::int64_t current_epoch = begin->epoch;
+        for (const Message *msg = begin; msg != end; ++msg)
+        {
+            if (msg->epoch != current_epoch)
+            {
+                on_epoch(current_epoch, static_cast<const State &>(state_), hash_state(current_epoch));
+                current_epoch = msg->epoch;
+            }
+            reducer_.apply(state_, *msg);
+        }
+        on_epoch(current_epoch, static_cast<const State &>(state_), hash_state(current_epoch));
+    }
+
+    template <typename OnEpoch>
+    void process(Message *begin, Message *end, OnEpoch &&on_epoch)
+    {
+        {
+            EPOCH_TRACE_SCOPE(trace, TracePhase::Sort, -1);
+            SortPath path = sort_messages(begin, end, scratch_);
+            EPOCH_TRACE_COUNT(trace, static_cast<std::size_t>(end - begin));
+            EPOCH_TRACE_EPOCH(trace, begin == end ? -1 : end[-1].epoch);
+            switch (path)
+            {
+            case SortPath::Presorted:
+                sort_stats_.presorted++;
+                break;
+            case SortPath::Merged:
+                sort_stats_.merged++;
+                break;
+            case SortPath::Sorted:
+                sort_stats_.sorted++;
+                break;
+            }
+        }
+        fold(begin, end, std::forward<OnEpoch>(on_epoch));
+    }
+
+    const SortStats &sort_stats() const
+    {
+        return sort_stats_;
+    }
+
+    const State &state() const
+    {
+        return state_;
+    }
+
+    State &state()
+    {
+        return state_;
+    }
+
+    Reducer &reducer()
+    {
+        return reducer_;
+    }
+
+private:
+    std::uint64_t hash_state([[maybe_unused]] std::int64_t epoch)
+    {
+        EPOCH_TRACE_SCOPE(trace, TracePhase::Hash, epoch);
+        return reducer_.hash(state_);
+    }
+
+    Reducer reducer_;
+    State state_;
+    std::pmr::vector<Message> scratch_;
+    SortStats sort_stats_;
+};
+
 std::vector<EpochResult> process_messages(std::vector<Message> messages);
+// Sorts a copy of the input inside the arena; the returned records live until the next arena.reset().
+ArenaVector<EpochRecord> process_messages(const Message *messages, std::size_t count, EpochArena &arena);
 
 } // namespace epoch
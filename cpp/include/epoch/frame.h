@@ -0,0 +1,44 @@
+#pragma once
+
+#include "epoch/engine.h"
+#include "epoch/schema.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace epoch {
+
+constexpr std::uint8_t kFrameVersion = 1;
+constexpr std::size_t kFrameLength = 56;
+constexpr std::size_t kFrameOffsetVersion = 0;
+
+using FrameLayout = Layout<
+    Field<&Message::qos, 1>,
+    Field<&Message::epoch, 8>,
+    Field<&Message::channel_id, 16>,
+    Field<&Message::source_id, 24>,
+    Field<&Message::source_seq, 32>,
+    Field<&Message::schema_id, 40>,
+    Field<&Message::payload, 48>>;
+
+static_assert(FrameLayout::size == kFrameLength, "frame layout must cover the v1 frame");
+
+inline void encode_frame(std::uint8_t *buffer, const Message &message)
+{
+    buffer[kFrameOffsetVersion] = kFrameVersion;
+    std::memset(buffer + 2, 0, 6);
+    FrameLayout::encode(message, buffer);
+}
+
+inline bool decode_frame(const std::uint8_t *buffer, std::size_t length, Message &message)
+{
+    if (length < kFrameLength || buffer[kFrameOffsetVersion] != kFrameVersion)
+    {
+        return false;
+    }
+    FrameLayout::decode(buffer, message);
+    return true;
+}
+
+} // namespace epoch
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "epoch/status.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace epoch {
+
+enum class HugePageMode : std::uint8_t {
+    Off,
+    // madvise(MADV_HUGEPAGE) on a 2 MB aligned mapping; the kernel backs it with huge pages when it can.
+    Transparent,
+    // MAP_HUGETLB from the reserved pool (vm.nr_hugepages, or hugepages-1048576kB for 1 GB). An empty pool
+    // falls back to Transparent instead of failing.
+    Explicit2M,
+    Explicit1G,
+};
+
+// Defaults keep today's behaviour: base pages, faulted in lazily.
+struct PageConfig {
+    HugePageMode huge_pages = HugePageMode::Off;
+    // Fault every page in when the mapping is made rather than on first access.
+    bool prefault = false;
+    // mlock the mapping so it is never reclaimed or swapped later; subject to RLIMIT_MEMLOCK.
+    bool lock = false;
+    // NUMA node to mbind anonymous memory to before it is faulted in; -1 leaves placement to first touch.
+    std::int32_t node = -1;
+};
+
+struct PageMapping {
+    void *data = nullptr;
+    std::size_t length = 0;
+    // Explicit huge pages were granted; false after a fallback to Transparent.
+    bool explicit_huge = false;
+    bool locked = false;
+};
+
+constexpr std::size_t kHugePage2M = std::size_t{1} << 21;
+constexpr std::size_t kHugePage1G = std::size_t{1} << 30;
+
+// Anonymous read/write mapping of at least length bytes laid out per config. Only a failed mmap is an error;
+// a refused mlock or mbind shows up as locked == false or is ignored, respectively.
+Result<PageMapping> map_pages(std::size_t length, const PageConfig &config);
+void unmap_pages(const PageMapping &mapping);
+
+// For a read-only file mapping made by the caller (mmap readers): MADV_HUGEPAGE where config asks for huge
+// pages (explicit modes cannot apply to regular files and are treated as Transparent), a read of every page
+// when prefault is set and mlock when lock is set. Fails only if the requested lock fails.
+Status prepare_file_mapping(const void *data, std::size_t length, const PageConfig &config);
+
+// allocations and bytes are what is currently mapped; the other counters cover every allocate().
+struct PageMemoryStats {
+    std::int64_t allocations = 0;
+    std::int64_t bytes = 0;
+    std::int64_t explicit_huge = 0;
+    // Explicit huge pages requested but the pool was empty.
+    std::int64_t fallbacks = 0;
+    std::int64_t lock_failures = 0;
+};
+
+// One mapping per allocation, sized up to the huge page (2 MB for Transparent), so it suits the few large,
+// long-lived buffers of a worker: inbox and broadcast rings, arena blocks, archive journals. With prefault set,
+// all page faults happen in allocate(), i.e. while the runtime is being built.
+class PageMemoryResource final : public std::pmr::memory_resource {
+public:
+    explicit PageMemoryResource(PageConfig config);
+    ~PageMemoryResource() override;
+
+    PageMemoryResource(const PageMemoryResource &) = delete;
+    PageMemoryResource &operator=(const PageMemoryResource &) = delete;
+
+    const PageConfig &config() const;
+    const PageMemoryStats &stats() const;
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    PageConfig config_;
+    PageMemoryStats stats_;
+    std::vector<PageMapping> mappings_;
+};
+
+} // namespace epoch
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "epoch/status.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace epoch {
+
+// The media driver's loss-report.dat: one entry per (session, stream, channel, source) that saw unrecoverable
+// loss, 64-byte aligned, appended in place; an entry is published by its observation count becoming positive.
+constexpr std::size_t kLossReportEntryAlignment = 64;
+constexpr const char *kLossReportFileName = "loss-report.dat";
+
+struct LossReportEntry {
+    std::int64_t observation_count = 0;
+    std::int64_t total_bytes_lost = 0;
+    std::int64_t first_observation_ns = 0;
+    std::int64_t last_observation_ns = 0;
+    std::int32_t session_id = 0;
+    std::int32_t stream_id = 0;
+    std::string_view channel;
+    std::string_view source;
+};
+
+using LossReportHandler = void (*)(void *clientd, const LossReportEntry &entry);
+
+namespace detail {
+
+// Acquire load of a 64-bit word the media driver stores with release semantics in one of its mapped files
+// (loss report, counters), where std::atomic cannot be used. Aligned 64-bit loads are single-copy atomic on
+// the supported targets; the fence orders the reads that follow.
+inline std::int64_t load_acquire(const std::int64_t *address)
+{
+    std::int64_t value = *static_cast<const volatile std::int64_t *>(address);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return value;
+}
+
+} // namespace detail
+
+// Returns the number of entries passed to handler; stops at the first unpublished or malformed entry.
+std::size_t read_loss_report(const std::uint8_t *buffer, std::size_t length, LossReportHandler handler, void *clientd);
+
+// Read-only mapping of a driver's loss report, kept open so repeated reads only touch the published entries.
+class LossReportReader {
+public:
+    ~LossReportReader();
+
+    LossReportReader(const LossReportReader &) = delete;
+    LossReportReader &operator=(const LossReportReader &) = delete;
+
+    // aeron_directory/loss-report.dat
+    static Result<std::unique_ptr<LossReportReader>> open(const std::string &aeron_directory);
+
+    std::size_t read(LossReportHandler handler, void *clientd) const;
+
+private:
+    LossReportReader() = default;
+
+    void *mapping_ = nullptr;
+    std::size_t length_ = 0;
+};
+
+} // namespace epoch
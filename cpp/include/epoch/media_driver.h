@@ -0,0 +1,98 @@
+#pragma once
+
+#include "epoch/status.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#if defined(EPOCH_EMBEDDED_DRIVER)
+extern "C" {
+#include <aeronmd.h>
+}
+#endif
+
+namespace epoch {
+
+enum class DriverThreadingMode {
+    // Conductor, sender and receiver each on their own thread.
+    Dedicated,
+    // Conductor on one thread, sender and receiver sharing another.
+    SharedNetwork,
+    // A single agent thread; lowest latency on a dedicated core for IPC-heavy single-binary deployments.
+    Shared,
+};
+
+struct EmbeddedDriverConfig {
+    bool enabled = false;
+    DriverThreadingMode threading_mode = DriverThreadingMode::Shared;
+    // 0 keeps the driver default (aeron.term.buffer.length / aeron.ipc.term.buffer.length).
+    std::size_t term_buffer_length = 0;
+    std::size_t ipc_term_buffer_length = 0;
+    // Off by default: with it on, launching against a directory another driver is still using wipes its files.
+    // Self-contained tests and benchmarks that own their directory opt in.
+    bool dir_delete_on_start = false;
+    bool dir_delete_on_shutdown = true;
+    bool pre_touch_mapped_memory = false;
+};
+
+// Aeron C media driver running inside this process. Requires the EPOCH_EMBEDDED_DRIVER CMake option;
+// otherwise launch() fails with ErrorCode::InvalidArgument.
+class EmbeddedMediaDriver {
+public:
+    ~EmbeddedMediaDriver();
+
+    EmbeddedMediaDriver(const EmbeddedMediaDriver &) = delete;
+    EmbeddedMediaDriver &operator=(const EmbeddedMediaDriver &) = delete;
+
+    // An empty directory uses the driver default (aeron.dir / AERON_DIR).
+    static Result<std::unique_ptr<EmbeddedMediaDriver>> launch(const std::string &directory,
+                                                              const EmbeddedDriverConfig &config);
+
+    const std::string &directory() const;
+    void close();
+
+private:
+    EmbeddedMediaDriver() = default;
+
+    std::string directory_;
+#if defined(EPOCH_EMBEDDED_DRIVER)
+    aeron_driver_context_t *context_ = nullptr;
+    aeron_driver_t *driver_ = nullptr;
+#endif
+};
+
+#if defined(EPOCH_EMBEDDED_DRIVER)
+namespace detail {
+
+struct DriverHooks {
+    int (*context_init)(aeron_driver_context_t **);
+    int (*context_set_dir)(aeron_driver_context_t *, const char *);
+    const char *(*context_get_dir)(aeron_driver_context_t *);
+    int (*context_set_threading_mode)(aeron_driver_context_t *, aeron_threading_mode_t);
+    int (*context_set_term_buffer_length)(aeron_driver_context_t *, size_t);
+    int (*context_set_ipc_term_buffer_length)(aeron_driver_context_t *, size_t);
+    int (*context_set_dir_delete_on_start)(aeron_driver_context_t *, bool);
+    int (*context_set_dir_delete_on_shutdown)(aeron_driver_context_t *, bool);
+    int (*context_set_pre_touch_mapped_memory)(aeron_driver_context_t *, bool);
+    int (*init)(aeron_driver_t **, aeron_driver_context_t *);
+    int (*start)(aeron_driver_t *, bool);
+    int (*close)(aeron_driver_t *);
+    int (*context_close)(aeron_driver_context_t *);
+};
+
+DriverHooks &driver_hooks();
+
+} // namespace detail
+
+#ifdef EPOCH_TESTING
+namespace test {
+
+detail::DriverHooks &driver_hooks();
+void reset_driver_hooks();
+
+} // namespace test
+#endif
+#endif
+
+} // namespace epoch
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "epoch/actor_id.h"
+#include "epoch/status.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace epoch {
+
+struct NumaNode {
+    std::int32_t id = 0;
+    std::vector<std::int32_t> cpus;
+};
+
+// CPUs grouped by memory node, limited to the CPUs this process may run on. Without NUMA support in the kernel
+// the machine reads as one node holding every CPU, so placement degrades to plain per-core pinning.
+class NumaTopology {
+public:
+    explicit NumaTopology(std::vector<NumaNode> nodes);
+
+    // sysfs_root/node<N>/cpulist; nodes without usable CPUs are left out.
+    static NumaTopology detect(const std::string &sysfs_root = "/sys/devices/system/node");
+    static NumaTopology single_node(std::int32_t cpu_count);
+
+    const std::vector<NumaNode> &nodes() const;
+    std::size_t cpu_count() const;
+    // -1 if the CPU is not part of the topology.
+    std::int32_t node_of_cpu(std::int32_t cpu) const;
+
+private:
+    std::vector<NumaNode> nodes_;
+};
+
+// Kernel cpulist syntax, e.g. "0-3,8-11,16".
+Result<std::vector<std::int32_t>> parse_cpu_list(std::string_view text);
+
+Status pin_current_thread(std::int32_t cpu);
+Status pin_current_thread(const std::vector<std::int32_t> &cpus);
+// set_mempolicy(MPOL_PREFERRED): later page faults of the calling thread are served from node while it has memory.
+Status prefer_node_memory(std::int32_t node);
+// mbind(MPOL_PREFERRED) for a page-aligned range that has not been touched yet.
+Status bind_memory(void *address, std::size_t length, std::int32_t node);
+// Writes one byte per page so the calling thread takes every fault now (first touch) instead of on the hot path.
+void touch_pages(void *address, std::size_t length);
+
+struct NodeMemoryStats {
+    std::int64_t allocations = 0;
+    std::int64_t bytes = 0;
+    // Allocations the kernel refused to mbind (no NUMA support); those are placed by first touch only.
+    std::int64_t unbound = 0;
+};
+
+// Whole-page mappings bound to one node and touched on allocation. Intended as the upstream of a worker's
+// EpochArena and inbox rings (RuntimeConfig::memory) when they are built outside the worker thread;
+// every allocation takes at least a page, so it is not a general-purpose heap.
+class NodeMemoryResource final : public std::pmr::memory_resource {
+public:
+    explicit NodeMemoryResource(std::int32_t node);
+
+    std::int32_t node() const;
+    const NodeMemoryStats &stats() const;
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    std::int32_t node_;
+    NodeMemoryStats stats_;
+};
+
+struct WorkerPlacement {
+    std::int32_t node = 0;
+    std::int32_t cpu = -1;
+    // Indexes into the actor list given to place_actors.
+    std::vector<std::size_t> actors;
+};
+
+struct ActorPlacement {
+    std::vector<WorkerPlacement> workers;
+    // worker_of[i]: the worker that owns actor i.
+    std::vector<std::size_t> worker_of;
+};
+
+// One worker per CPU (or workers_per_node per node). Actors sharing (region, server) stay on one node: groups go,
+// largest first, to the node with the fewest actors per worker, then round-robin over that node's workers.
+// Deterministic for a given actor list and topology.
+ActorPlacement place_actors(const std::vector<ActorIdParts> &actors,
+                            const NumaTopology &topology,
+                            std::size_t workers_per_node = 0);
+
+// Thread-per-core runner: each thread pins itself and prefers its node's memory before calling body, so the actor
+// state, EpochRuntime rings and arena that body builds are all faulted in node-locally.
+class PinnedWorkers {
+public:
+    using Body = std::function<void(std::size_t worker, const WorkerPlacement &placement)>;
+
+    PinnedWorkers() = default;
+    ~PinnedWorkers();
+
+    PinnedWorkers(const PinnedWorkers &) = delete;
+    PinnedWorkers &operator=(const PinnedWorkers &) = delete;
+
+    void start(const std::vector<WorkerPlacement> &workers, Body body);
+    void join();
+
+    // After join(): workers that could not pin or set their memory policy; they still ran, unplaced.
+    std::size_t placement_failures() const;
+
+private:
+    std::vector<std::thread> threads_;
+    std::vector<WorkerPlacement> workers_;
+    std::vector<Status> placement_;
+};
+
+} // namespace epoch
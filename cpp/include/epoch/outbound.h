@@ -0,0 +1,67 @@
+#pragma once
+
+#include "epoch/channel.h"
+#include "epoch/transport.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace epoch {
+
+enum class BackPressurePolicy {
+    // Keep everything queued and retry at the next flush/epoch.
+    Defer,
+    // Keep high-qos traffic queued; drop queued messages below shed_below_qos once the destination pushes back.
+    ShedLowQos,
+};
+
+struct OutboundConfig {
+    std::size_t capacity = 4096;
+    std::size_t credits_per_epoch = 1024;
+    BackPressurePolicy policy = BackPressurePolicy::Defer;
+    std::uint8_t shed_below_qos = 128;
+};
+
+struct OutboundStats {
+    std::int64_t enqueued = 0;
+    std::int64_t sent = 0;
+    std::int64_t rejected = 0;
+    std::int64_t deferred = 0;
+    std::int64_t shed = 0;
+    std::int64_t back_pressured = 0;
+    std::int64_t failed = 0;
+    std::int64_t credit_stalls = 0;
+};
+
+// Per-destination outbound queue with credit-based flow control. flush() spends credits on try_send and stops
+// at the first transient refusal, so back pressure costs queueing delay instead of an exception.
+class OutboundBuffer {
+public:
+    explicit OutboundBuffer(Transport &destination, OutboundConfig config = {});
+
+    bool enqueue(const Message &message);
+    std::size_t flush();
+    // Epoch boundary: refill credits and count what is carried over to the new epoch.
+    void begin_epoch();
+    void grant(std::size_t credits);
+
+    std::size_t queued() const;
+    std::size_t credits() const;
+    const OutboundConfig &config() const;
+    const OutboundStats &stats() const;
+
+private:
+    bool sheddable(const Message &message) const;
+    std::size_t shed_low_qos();
+
+    Transport &destination_;
+    OutboundConfig config_;
+    OutboundStats stats_;
+    std::array<std::deque<Message>, kQosBandCount> lanes_;
+    std::size_t queued_ = 0;
+    std::size_t credits_;
+};
+
+} // namespace epoch
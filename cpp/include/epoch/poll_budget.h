@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace epoch {
+
+struct PollBudgetConfig {
+    bool enabled = false;
+    std::int32_t min_fragments = 8;
+    std::int32_t max_fragments = 1024;
+    // Log bytes per message: 32-byte data header plus the 56-byte frame, aligned to 32.
+    std::int32_t fragment_bytes = 96;
+    // Share of the time left in the epoch a single poll may spend; the rest is kept for seal and emit.
+    double deadline_share = 0.5;
+};
+
+struct PollBudgetStats {
+    std::int64_t polls = 0;
+    std::int64_t empty_polls = 0;
+    // Polls that returned as many fragments as they were allowed.
+    std::int64_t full_polls = 0;
+    // Limits sized from image lag; without lag the limit doubles after a full poll and halves after a sparse one.
+    std::int64_t lag_sized = 0;
+    std::int64_t grown = 0;
+    std::int64_t shrunk = 0;
+    // Limits cut short because the measured per-fragment cost would overrun the epoch deadline.
+    std::int64_t deadline_capped = 0;
+    std::int64_t last_limit = 0;
+    std::int64_t last_lag_bytes = -1;
+    // Moving average of poll time per fragment.
+    std::int64_t ns_per_fragment = 0;
+};
+
+// Picks the fragment limit of the next subscription poll: enough to drain the observed backlog in one call,
+// but never more than the measured handling cost allows before the epoch deadline.
+class PollBudget {
+public:
+    explicit PollBudget(PollBudgetConfig config = {}, std::int32_t initial_fragments = 64);
+
+    // lag_bytes < 0: backlog unknown; remaining_ns < 0: no deadline. Always at least 1.
+    std::size_t next(std::int64_t lag_bytes, std::int64_t remaining_ns);
+    void observe(std::size_t fragments, std::int64_t elapsed_ns);
+
+    const PollBudgetConfig &config() const;
+    const PollBudgetStats &stats() const;
+
+private:
+    PollBudgetConfig config_;
+    std::int64_t limit_;
+    bool lag_known_ = false;
+    PollBudgetStats stats_;
+};
+
+} // namespace epoch
@@ -0,0 +1,379 @@
+#pragma once
+
+#include "epoch/engine.h"
+#include "epoch/runtime.h"
+#include "epoch/transport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace epoch {
+
+// Replication control frames reuse the Message layout on a reserved channel id.
+constexpr std::int64_t kReplicationChannel = -1;
+// payload = number of input messages in the sealed batch.
+constexpr std::int64_t kReplicaSealSchema = 1;
+// payload = state hash after the sealed epoch (bit pattern of the uint64).
+constexpr std::int64_t kReplicaHashSchema = 2;
+
+enum class ReplicaRole {
+    Primary,
+    Backup,
+};
+
+struct ReplicaConfig {
+    std::int64_t node_id = 0;
+    RuntimeConfig runtime;
+    std::size_t peer_poll_batch = 1024;
+    // Local hashes kept for auditing late reports.
+    std::size_t hash_window = 4096;
+};
+
+struct ReplicaStats {
+    std::int64_t replicated = 0;
+    std::int64_t replication_deferred = 0;
+    std::int64_t replication_failed = 0;
+    std::int64_t sealed_epochs = 0;
+    std::int64_t hashes_matched = 0;
+    std::int64_t divergences = 0;
+    std::int64_t first_divergent_epoch = -1;
+    std::int64_t promotions = 0;
+    // Ingress messages dropped after promote() because they had already arrived through replication.
+    std::int64_t ingress_skipped = 0;
+};
+
+// B mode: the primary runs the normal EpochRuntime and, at each seal, publishes the sealed batch followed by a
+// seal marker and its state hash on the peer transport. Backups never read ingress; they buffer the replicated
+// input until the marker, fold it through the same engine and publish their own hash, so each side audits the
+// other epoch by epoch. The peer transport must preserve publication order and carry both directions, since
+// backups publish hash reports: an Aeron publication/subscription pair fits, a single BroadcastRing (one
+// producer) does not.
+template <typename Reducer = SumReducer>
+class ReplicatedRuntime {
+public:
+    using State = typename Reducer::State;
+
+    ReplicatedRuntime(ReplicaRole role,
+                      Transport &ingress,
+                      Transport &peers,
+                      ReplicaConfig config = {},
+                      Reducer reducer = Reducer{})
+        : role_(role),
+          peers_(peers),
+          config_(config),
+          ingress_(ingress, stats_),
+          runtime_(ingress_, config.runtime, std::move(reducer)),
+          primary_id_(role == ReplicaRole::Primary ? config.node_id : -1)
+    {
+        inbound_.reserve(config_.peer_poll_batch);
+    }
+
+    // Primary: ingress into the inbox plus backup hash reports. Backup: applies every batch the primary sealed,
+    // calling on_epoch as seal() would on the primary.
+    template <typename OnEpoch>
+    std::size_t pump(OnEpoch &&on_epoch)
+    {
+        std::size_t count = role_ == ReplicaRole::Primary ? runtime_.pump() : 0;
+        inbound_.clear();
+        peers_.poll_into(inbound_, config_.peer_poll_batch);
+        for (const auto &message : inbound_)
+        {
+            if (message.channel_id != kReplicationChannel)
+            {
+                if (role_ == ReplicaRole::Backup)
+                {
+                    replica_batch_.push_back(message);
+                    ingress_.taken(message);
+                    count++;
+                }
+                continue;
+            }
+            if (message.source_id == config_.node_id)
+            {
+                continue;
+            }
+            if (message.schema_id == kReplicaSealSchema && role_ == ReplicaRole::Backup)
+            {
+                apply_sealed(message, on_epoch);
+            }
+            else if (message.schema_id == kReplicaHashSchema)
+            {
+                audit(message);
+            }
+        }
+        flush_replication();
+        return count;
+    }
+
+    std::size_t pump()
+    {
+        return pump([](std::int64_t, const State &, std::uint64_t) {});
+    }
+
+    // Primary only; a backup seals when the primary's marker arrives through pump().
+    template <typename OnEpoch>
+    std::size_t seal(std::int64_t epoch, OnEpoch &&on_epoch)
+    {
+        if (role_ != ReplicaRole::Primary)
+        {
+            return 0;
+        }
+        std::size_t count = runtime_.seal(
+            epoch,
+            [this](const Message *begin, const Message *end) {
+                for (const Message *message = begin; message != end; ++message)
+                {
+                    backlog_.push_back(*message);
+                }
+            },
+            on_epoch);
+        stats_.replicated += static_cast<std::int64_t>(count);
+        backlog_.push_back(control(epoch, kReplicaSealSchema, static_cast<std::int64_t>(count)));
+        finish_epoch(epoch);
+        flush_replication();
+        return count;
+    }
+
+    std::size_t seal(std::int64_t epoch)
+    {
+        return seal(epoch, [](std::int64_t, const State &, std::uint64_t) {});
+    }
+
+    // Failover at the last epoch boundary this backup applied. Input of a batch the old primary did not finish
+    // publishing has no marker yet; it is deferred into the runtime and sealed again under the new primary. The
+    // backup never polled its ingress, so if that is shared with (or replays) the old primary's input, ingress
+    // messages at or below the highest source_seq already replicated from their source are skipped; this
+    // relies on source_seq increasing per source.
+    void promote()
+    {
+        if (role_ == ReplicaRole::Primary)
+        {
+            return;
+        }
+        for (const auto &message : replica_batch_)
+        {
+            runtime_.defer(message);
+        }
+        replica_batch_.clear();
+        role_ = ReplicaRole::Primary;
+        primary_id_ = config_.node_id;
+        stats_.promotions++;
+    }
+
+    std::size_t flush_replication()
+    {
+        std::size_t sent = 0;
+        while (!backlog_.empty())
+        {
+            SendResult result = peers_.try_send(backlog_.front());
+            if (result == SendResult::Sent)
+            {
+                backlog_.pop_front();
+                sent++;
+                continue;
+            }
+            if (is_retryable(result))
+            {
+                stats_.replication_deferred++;
+                break;
+            }
+            stats_.replication_failed++;
+            backlog_.pop_front();
+        }
+        return sent;
+    }
+
+    ReplicaRole role() const
+    {
+        return role_;
+    }
+
+    bool diverged() const
+    {
+        return stats_.divergences > 0;
+    }
+
+    // -1 until a sealed epoch has been applied.
+    std::int64_t last_sealed_epoch() const
+    {
+        return last_sealed_epoch_;
+    }
+
+    std::int64_t primary_id() const
+    {
+        return primary_id_;
+    }
+
+    std::size_t backlog() const
+    {
+        return backlog_.size();
+    }
+
+    const State &state() const
+    {
+        return runtime_.state();
+    }
+
+    EpochRuntime<Reducer> &runtime()
+    {
+        return runtime_;
+    }
+
+    const ReplicaStats &stats() const
+    {
+        return stats_;
+    }
+
+private:
+    // Forwards to the real ingress and, once a backup has taken replicated input, drops ingress messages that
+    // input already covered.
+    class IngressGate final : public Transport {
+    public:
+        IngressGate(Transport &inner, ReplicaStats &stats) : inner_(inner), stats_(stats)
+        {
+        }
+
+        void send(const Message &message) override
+        {
+            inner_.send(message);
+        }
+
+        SendResult try_send(const Message &message) override
+        {
+            return inner_.try_send(message);
+        }
+
+        std::vector<Message> poll(std::size_t max) override
+        {
+            auto batch = inner_.poll(max);
+            batch.erase(std::remove_if(batch.begin(), batch.end(), [this](const Message &m) { return seen(m); }),
+                        batch.end());
+            return batch;
+        }
+
+        std::size_t poll_into(std::pmr::vector<Message> &out, std::size_t max) override
+        {
+            auto start = static_cast<std::ptrdiff_t>(out.size());
+            inner_.poll_into(out, max);
+            if (!taken_.empty())
+            {
+                out.erase(std::remove_if(out.begin() + start, out.end(), [this](const Message &m) { return seen(m); }),
+                          out.end());
+            }
+            return out.size() - static_cast<std::size_t>(start);
+        }
+
+        void close() override
+        {
+            inner_.close();
+        }
+
+        void taken(const Message &message)
+        {
+            auto &highest = taken_.try_emplace(message.source_id, message.source_seq).first->second;
+            highest = std::max(highest, message.source_seq);
+        }
+
+    private:
+        bool seen(const Message &message)
+        {
+            auto it = taken_.find(message.source_id);
+            if (it == taken_.end() || message.source_seq > it->second)
+            {
+                return false;
+            }
+            stats_.ingress_skipped++;
+            return true;
+        }
+
+        Transport &inner_;
+        ReplicaStats &stats_;
+        std::unordered_map<std::int64_t, std::int64_t> taken_;
+    };
+
+    Message control(std::int64_t epoch, std::int64_t schema, std::int64_t payload)
+    {
+        return Message{epoch, kReplicationChannel, config_.node_id, ++control_seq_, schema, 0, payload};
+    }
+
+    template <typename OnEpoch>
+    void apply_sealed(const Message &marker, OnEpoch &on_epoch)
+    {
+        primary_id_ = marker.source_id;
+        if (static_cast<std::int64_t>(replica_batch_.size()) != marker.payload)
+        {
+            // Lost replicated input: the hash will disagree too, but record where it started.
+            record_divergence(marker.epoch);
+        }
+        runtime_.apply(marker.epoch, replica_batch_.data(), replica_batch_.data() + replica_batch_.size(), on_epoch);
+        stats_.replicated += static_cast<std::int64_t>(replica_batch_.size());
+        replica_batch_.clear();
+        finish_epoch(marker.epoch);
+    }
+
+    void finish_epoch(std::int64_t epoch)
+    {
+        std::uint64_t hash = runtime_.state_hash();
+        local_hashes_.emplace_back(epoch, hash);
+        if (local_hashes_.size() > config_.hash_window)
+        {
+            local_hashes_.pop_front();
+        }
+        backlog_.push_back(control(epoch, kReplicaHashSchema, static_cast<std::int64_t>(hash)));
+        last_sealed_epoch_ = epoch;
+        stats_.sealed_epochs++;
+    }
+
+    void audit(const Message &report)
+    {
+        if (role_ == ReplicaRole::Backup && report.source_id != primary_id_)
+        {
+            return;
+        }
+        for (auto it = local_hashes_.rbegin(); it != local_hashes_.rend(); ++it)
+        {
+            if (it->first == report.epoch)
+            {
+                if (it->second == static_cast<std::uint64_t>(report.payload))
+                {
+                    stats_.hashes_matched++;
+                }
+                else
+                {
+                    record_divergence(report.epoch);
+                }
+                return;
+            }
+        }
+    }
+
+    void record_divergence(std::int64_t epoch)
+    {
+        stats_.divergences++;
+        if (stats_.first_divergent_epoch < 0)
+        {
+            stats_.first_divergent_epoch = epoch;
+        }
+    }
+
+    ReplicaRole role_;
+    Transport &peers_;
+    ReplicaConfig config_;
+    ReplicaStats stats_;
+    IngressGate ingress_;
+    EpochRuntime<Reducer> runtime_;
+    std::pmr::vector<Message> inbound_;
+    std::vector<Message> replica_batch_;
+    std::deque<Message> backlog_;
+    std::deque<std::pair<std::int64_t, std::uint64_t>> local_hashes_;
+    std::int64_t control_seq_ = 0;
+    std::int64_t last_sealed_epoch_ = -1;
+    std::int64_t primary_id_;
+};
+
+} // namespace epoch
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "epoch/arena.h"
+#include "epoch/engine.h"
+#include "epoch/schema.h"
+#include "epoch/status.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace epoch {
+
+// Results file: a 16-byte header ("EPRS", u32 version, u64 reserved) followed by fixed 32-byte little-endian
+// records (epoch i64, state i64, hash u64, digest u64). Record i lives at kResultsHeaderLength + i * 32, so
+// two files are compared record by record with memcmp and any record can be read by index.
+constexpr char kResultsMagic[4] = {'E', 'P', 'R', 'S'};
+constexpr std::uint32_t kResultsVersion = 1;
+constexpr std::size_t kResultsHeaderLength = 16;
+constexpr std::size_t kResultRecordLength = 32;
+
+using ResultLayout = Layout<
+    Field<&EpochRecord::epoch, 0>,
+    Field<&EpochRecord::state, 8>,
+    Field<&EpochRecord::hash, 16>,
+    Field<&EpochRecord::digest, 24>>;
+
+static_assert(ResultLayout::size == kResultRecordLength, "result layout must cover the record");
+
+class ResultSink {
+public:
+    virtual ~ResultSink() = default;
+    virtual void write(const EpochRecord &record) = 0;
+    virtual Status flush()
+    {
+        return Status::success();
+    }
+};
+
+using ResultHandler = void (*)(void *clientd, const EpochRecord &record);
+
+class CallbackSink final : public ResultSink {
+public:
+    CallbackSink(ResultHandler handler, void *clientd);
+
+    void write(const EpochRecord &record) override;
+
+private:
+    ResultHandler handler_;
+    void *clientd_;
+};
+
+// Keeps the most recent capacity() records in fixed memory; older ones are overwritten.
+class RingSink final : public ResultSink {
+public:
+    explicit RingSink(std::size_t capacity);
+
+    void write(const EpochRecord &record) override;
+
+    std::size_t size() const;
+    std::size_t capacity() const;
+    // 0 is the oldest retained record.
+    const EpochRecord &at(std::size_t index) const;
+    std::int64_t total() const;
+
+private:
+    std::vector<EpochRecord> records_;
+    std::int64_t total_ = 0;
+};
+
+// Buffered writer of the results file. write() cannot fail the caller; the first I/O error is kept in
+// status() and later writes are dropped.
+class FileSink final : public ResultSink {
+public:
+    ~FileSink() override;
+
+    FileSink(const FileSink &) = delete;
+    FileSink &operator=(const FileSink &) = delete;
+
+    static Result<std::unique_ptr<FileSink>> open(const std::string &path, std::size_t buffer_size = 1 << 16);
+
+    void write(const EpochRecord &record) override;
+    Status flush() override;
+
+    Status status() const;
+    std::int64_t written() const;
+
+private:
+    FileSink() = default;
+
+    std::FILE *file_ = nullptr;
+    std::vector<std::uint8_t> buffer_;
+    std::size_t used_ = 0;
+    std::int64_t written_ = 0;
+    Status status_;
+};
+
+class ResultFileReader {
+public:
+    ~ResultFileReader();
+
+    ResultFileReader(const ResultFileReader &) = delete;
+    ResultFileReader &operator=(const ResultFileReader &) = delete;
+
+    static Result<std::unique_ptr<ResultFileReader>> open(const std::string &path);
+
+    std::size_t count() const;
+    bool read(std::size_t index, EpochRecord &record);
+
+private:
+    ResultFileReader() = default;
+
+    std::FILE *file_ = nullptr;
+    std::size_t count_ = 0;
+    // Record the file position is at; open() leaves it at the end.
+    std::size_t next_ = static_cast<std::size_t>(-1);
+};
+
+inline void encode_result(std::uint8_t *buffer, const EpochRecord &record)
+{
+    ResultLayout::encode(record, buffer);
+}
+
+inline void decode_result(const std::uint8_t *buffer, EpochRecord &record)
+{
+    ResultLayout::decode(buffer, record);
+}
+
+// on_epoch adapter for the sum reducer: EpochEngine<>/EpochRuntime<> results go straight to a sink.
+inline auto sink_results(ResultSink &sink)
+{
+    return [&sink](std::int64_t epoch, std::int64_t state, std::uint64_t hash) {
+        sink.write(EpochRecord{epoch, state, hash, state_digest(state)});
+    };
+}
+
+// Streaming process_messages: nothing is retained per epoch, so memory stays constant for long replays.
+std::size_t process_messages(const Message *messages, std::size_t count, EpochArena &arena, ResultSink &sink);
+
+} // namespace epoch
@@ -0,0 +1,290 @@
+#pragma once
+
+#include "epoch/arena.h"
+#include "epoch/channel.h"
+#include "epoch/engine.h"
+#include "epoch/outbound.h"
+#include "epoch/trace.h"
+#include "epoch/transport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace epoch {
+
+struct RuntimeConfig {
+    PriorityInboxConfig inbox;
+    OutboundConfig outbound;
+    std::size_t poll_batch = 256;
+    std::size_t drain_batch = 4096;
+    std::size_t arena_block_size = EpochArena::kDefaultBlockSize;
+    // Arena bytes allocated at construction instead of during the first seals.
+    std::size_t arena_reserve = 0;
+    // Upstream of the inbox rings, the arena and the poll buffer (NodeMemoryResource, PageMemoryResource);
+    // null uses the global heap, which a pinned worker already gets from its own node by first touch.
+    std::pmr::memory_resource *memory = nullptr;
+};
+
+struct RuntimeStats {
+    std::int64_t polled = 0;
+    std::int64_t admitted = 0;
+    std::int64_t rejected = 0;
+    // Polled messages a full lane refused; they wait in the backlog instead of being dropped.
+    std::int64_t deferred = 0;
+    // Messages for an epoch that was already sealed; they are refused rather than folded into a later one.
+    std::int64_t late = 0;
+    std::int64_t sealed_epochs = 0;
+    std::int64_t processed = 0;
+};
+
+// Single-threaded epoch loop: pump() moves transport input into the QoS lanes, seal(epoch) drains the lanes
+// (high bands first) and folds every pending message with epoch <= the sealed epoch through the engine.
+// Lanes decide admission under load; execution inside an epoch still follows the canonical sort order.
+// Polled messages a full lane refuses are held in a backlog: the next pump() re-offers them before it polls
+// again (leaving further input in the transport), and seal() folds whatever is still waiting. A message whose
+// epoch was already sealed is refused and counted as late, so every result stays in its own epoch.
+// emit() goes through a credit-limited OutboundBuffer that seal() flushes; refused sends wait for the next
+// epoch (Defer) or drop low-qos traffic (ShedLowQos) instead of throwing out of the loop.
+template <typename Reducer = SumReducer>
+class EpochRuntime {
+public:
+    using State = typename Reducer::State;
+
+    explicit EpochRuntime(Transport &transport, RuntimeConfig config = {}, Reducer reducer = Reducer{})
+        : transport_(transport),
+          config_(config),
+          inbox_(inbox_config(config)),
+          outbound_(transport, config.outbound),
+          arena_(config.arena_block_size, config.memory),
+          engine_(std::move(reducer)),
+          inbound_(config.memory == nullptr ? std::pmr::get_default_resource() : config.memory)
+    {
+        inbound_.reserve(config_.poll_batch);
+        arena_.reserve(config_.arena_reserve);
+    }
+
+    std::size_t pump()
+    {
+        EPOCH_TRACE_SCOPE(trace, TracePhase::Poll, open_epoch_);
+        std::size_t admitted = readmit();
+        if (!backlog_.empty())
+        {
+            return admitted;
+        }
+        inbound_.clear();
+        std::size_t polled = transport_.poll_into(inbound_, config_.poll_batch);
+        EPOCH_TRACE_COUNT(trace, polled);
+        stats_.polled += static_cast<std::int64_t>(polled);
+        for (const auto &message : inbound_)
+        {
+            if (message.epoch < open_epoch_)
+            {
+                stats_.late++;
+            }
+            else if (inbox_.try_push(message))
+            {
+                stats_.admitted++;
+                admitted++;
+            }
+            else
+            {
+                backlog_.push_back(message);
+                stats_.deferred++;
+            }
+        }
+        return admitted;
+    }
+
+    bool post(const Message &message)
+    {
+        if (message.epoch < open_epoch_)
+        {
+            stats_.late++;
+            return false;
+        }
+        if (!inbox_.try_push(message))
+        {
+            stats_.rejected++;
+            return false;
+        }
+        stats_.admitted++;
+        return true;
+    }
+
+    // Queues message behind the lanes like polled input a full lane refused: it cannot be dropped, the next
+    // pump() offers it to its lane and seal() folds it if it is still waiting.
+    void defer(const Message &message)
+    {
+        backlog_.push_back(message);
+        stats_.deferred++;
+    }
+
+    bool emit(const Message &message)
+    {
+        return outbound_.enqueue(message);
+    }
+
+    std::size_t flush()
+    {
+        return outbound_.flush();
+    }
+
+    template <typename OnEpoch>
+    std::size_t seal(std::int64_t epoch, OnEpoch &&on_epoch)
+    {
+        return seal(epoch, [](const Message *, const Message *) {}, std::forward<OnEpoch>(on_epoch));
+    }
+
+    // on_batch(begin, end) sees the sealed batch in arrival order before it is sorted and folded.
+    template <typename OnBatch, typename OnEpoch>
+    std::size_t seal(std::int64_t epoch, OnBatch &&on_batch, OnEpoch &&on_epoch)
+    {
+        outbound_.begin_epoch();
+        arena_.reset();
+        ArenaVector<Message> batch(&arena_);
+        {
+            EPOCH_TRACE_SCOPE(trace, TracePhase::Drain, epoch);
+            auto take = [this](const Message &message) { pending_.push_back(message); };
+            while (inbox_.drain(config_.drain_batch, take) > 0)
+            {
+            }
+            pending_.insert(pending_.end(), backlog_.begin(), backlog_.end());
+            backlog_.clear();
+
+            batch.reserve(pending_.size());
+            std::size_t kept = 0;
+            for (const auto &message : pending_)
+            {
+                if (message.epoch <= epoch)
+                {
+                    batch.push_back(message);
+                }
+                else
+                {
+                    pending_[kept++] = message;
+                }
+            }
+            pending_.resize(kept);
+            EPOCH_TRACE_COUNT(trace, batch.size());
+        }
+
+        on_batch(static_cast<const Message *>(batch.data()), static_cast<const Message *>(batch.data() + batch.size()));
+        engine_.process(batch.data(), batch.data() + batch.size(), on_epoch);
+        {
+            EPOCH_TRACE_SCOPE(trace, TracePhase::Emit, epoch);
+            [[maybe_unused]] std::size_t sent = outbound_.flush();
+            EPOCH_TRACE_COUNT(trace, sent);
+        }
+        open_epoch_ = epoch + 1;
+        stats_.sealed_epochs++;
+        stats_.processed += static_cast<std::int64_t>(batch.size());
+        return batch.size();
+    }
+
+    // Replay path: folds a batch that was sealed elsewhere at epoch straight through the engine, bypassing the
+    // inbox; later input for that epoch is late, as after seal(epoch).
+    template <typename OnEpoch>
+    std::size_t apply(std::int64_t epoch, Message *begin, Message *end, OnEpoch &&on_epoch)
+    {
+        engine_.process(begin, end, on_epoch);
+        open_epoch_ = epoch + 1;
+        stats_.sealed_epochs++;
+        stats_.processed += static_cast<std::int64_t>(end - begin);
+        return static_cast<std::size_t>(end - begin);
+    }
+
+    const SortStats &sort_stats() const
+    {
+        return engine_.sort_stats();
+    }
+
+    std::uint64_t state_hash()
+    {
+        return engine_.reducer().hash(engine_.state());
+    }
+
+    PriorityInbox &inbox()
+    {
+        return inbox_;
+    }
+
+    OutboundBuffer &outbound()
+    {
+        return outbound_;
+    }
+
+    EpochArena &arena()
+    {
+        return arena_;
+    }
+
+    const State &state() const
+    {
+        return engine_.state();
+    }
+
+    std::size_t pending() const
+    {
+        return pending_.size() + inbox_.size() + backlog_.size();
+    }
+
+    const RuntimeConfig &config() const
+    {
+        return config_;
+    }
+
+    const RuntimeStats &stats() const
+    {
+        return stats_;
+    }
+
+private:
+    // Re-offers the backlog in arrival order; a band whose lane is still full keeps its messages.
+    std::size_t readmit()
+    {
+        std::size_t admitted = 0;
+        std::size_t kept = 0;
+        for (const auto &message : backlog_)
+        {
+            if (inbox_.try_push(message))
+            {
+                stats_.admitted++;
+                admitted++;
+            }
+            else
+            {
+                backlog_[kept++] = message;
+            }
+        }
+        backlog_.resize(kept);
+        return admitted;
+    }
+
+    static PriorityInboxConfig inbox_config(const RuntimeConfig &config)
+    {
+        PriorityInboxConfig inbox = config.inbox;
+        if (inbox.resource == nullptr)
+        {
+            inbox.resource = config.memory;
+        }
+        return inbox;
+    }
+
+    Transport &transport_;
+    RuntimeConfig config_;
+    PriorityInbox inbox_;
+    OutboundBuffer outbound_;
+    EpochArena arena_;
+    EpochEngine<Reducer> engine_;
+    std::pmr::vector<Message> inbound_;
+    std::vector<Message> pending_;
+    std::vector<Message> backlog_;
+    // Epoch the next pump() feeds; input below it is late.
+    std::int64_t open_epoch_ = 0;
+    RuntimeStats stats_;
+};
+
+} // namespace epoch
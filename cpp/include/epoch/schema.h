@@ -0,0 +1,169 @@
+#pragma once
+
+#include "epoch/engine.h"
+#include "epoch/status.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace epoch {
+
+namespace detail {
+
+template <typename>
+struct MemberTraits;
+
+template <typename Owner, typename Value>
+struct MemberTraits<Value Owner::*> {
+    using owner_type = Owner;
+    using value_type = Value;
+};
+
+} // namespace detail
+
+// Field<&T::member, offset> places one trivially copyable member at a fixed byte offset.
+template <auto Member, std::size_t Offset>
+struct Field {
+    using owner_type = typename detail::MemberTraits<decltype(Member)>::owner_type;
+    using value_type = typename detail::MemberTraits<decltype(Member)>::value_type;
+    static_assert(std::is_trivially_copyable_v<value_type>, "schema fields must be trivially copyable");
+
+    static constexpr std::size_t offset = Offset;
+    static constexpr std::size_t end = Offset + sizeof(value_type);
+
+    static void write(std::uint8_t *buffer, const owner_type &value)
+    {
+        std::memcpy(buffer + Offset, &(value.*Member), sizeof(value_type));
+    }
+
+    static void read(const std::uint8_t *buffer, owner_type &value)
+    {
+        std::memcpy(&(value.*Member), buffer + Offset, sizeof(value_type));
+    }
+};
+
+template <typename... Fields>
+struct Layout {
+    static_assert(sizeof...(Fields) > 0, "layout needs at least one field");
+    static constexpr std::size_t size = std::max({Fields::end...});
+
+    template <typename T>
+    static void encode(const T &value, std::uint8_t *buffer)
+    {
+        (Fields::write(buffer, value), ...);
+    }
+
+    template <typename T>
+    static void decode(const std::uint8_t *buffer, T &value)
+    {
+        (Fields::read(buffer, value), ...);
+    }
+};
+
+// Specialize via EPOCH_SCHEMA: `static constexpr std::int64_t id` and `using layout = Layout<...>`.
+template <typename T>
+struct SchemaTraits;
+
+#define EPOCH_SCHEMA(type, schema_id, ...)                      \
+    template <>                                                 \
+    struct epoch::SchemaTraits<type> {                          \
+        static constexpr std::int64_t id = (schema_id);         \
+        using layout = ::epoch::Layout<__VA_ARGS__>;            \
+    }
+
+constexpr std::size_t kPayloadLength = sizeof(Message::payload);
+
+template <typename T>
+void encode_payload(const T &value, Message &message)
+{
+    using layout = typename SchemaTraits<T>::layout;
+    static_assert(layout::size <= kPayloadLength, "schema does not fit in the frame payload");
+    std::uint8_t buffer[kPayloadLength] = {};
+    layout::encode(value, buffer);
+    std::memcpy(&message.payload, buffer, kPayloadLength);
+    message.schema_id = SchemaTraits<T>::id;
+}
+
+template <typename T>
+void decode_payload(const Message &message, T &value)
+{
+    using layout = typename SchemaTraits<T>::layout;
+    static_assert(layout::size <= kPayloadLength, "schema does not fit in the frame payload");
+    std::uint8_t buffer[kPayloadLength];
+    std::memcpy(buffer, &message.payload, kPayloadLength);
+    layout::decode(buffer, value);
+}
+
+// Dispatch table indexed by schema_id. Lookup is a clamp plus one indirect call; unbound ids land on
+// a sentinel slot so dispatch never branches on registration state.
+template <typename Context>
+class SchemaDispatcher {
+public:
+    static constexpr std::size_t kMaxSchemas = 256;
+
+    template <typename T>
+    using Handler = void (*)(Context &, const Message &, const T &);
+
+    SchemaDispatcher()
+    {
+        entries_.fill(Entry{&unbound, nullptr});
+    }
+
+    template <typename T>
+    void bind(Handler<T> handler)
+    {
+        constexpr std::int64_t id = SchemaTraits<T>::id;
+        static_assert(id >= 0 && static_cast<std::size_t>(id) < kMaxSchemas, "schema_id out of dispatch range");
+        if (handler == nullptr)
+        {
+            EPOCH_THROW(std::invalid_argument("schema handler is null"));
+        }
+        entries_[static_cast<std::size_t>(id)] = Entry{&invoke<T>, reinterpret_cast<void (*)()>(handler)};
+    }
+
+    bool bound(std::int64_t schema_id) const
+    {
+        return entries_[slot(schema_id)].handler != nullptr;
+    }
+
+    bool dispatch(Context &context, const Message &message) const
+    {
+        const auto &entry = entries_[slot(message.schema_id)];
+        return entry.thunk(entry.handler, context, message);
+    }
+
+private:
+    struct Entry {
+        bool (*thunk)(void (*)(), Context &, const Message &);
+        void (*handler)();
+    };
+
+    static std::size_t slot(std::int64_t schema_id)
+    {
+        return static_cast<std::size_t>(std::min(static_cast<std::uint64_t>(schema_id),
+                                                 static_cast<std::uint64_t>(kMaxSchemas)));
+    }
+
+    static bool unbound(void (*)(), Context &, const Message &)
+    {
+        return false;
+    }
+
+    template <typename T>
+    static bool invoke(void (*handler)(), Context &context, const Message &message)
+    {
+        T value{};
+        decode_payload(message, value);
+        reinterpret_cast<Handler<T>>(handler)(context, message, value);
+        return true;
+    }
+
+    std::array<Entry, kMaxSchemas + 1> entries_;
+};
+
+} // namespace epoch
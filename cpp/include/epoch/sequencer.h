@@ -0,0 +1,145 @@
+#pragma once
+
+#include "epoch/engine.h"
+#include "epoch/transport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace epoch {
+
+// Tournament (loser) tree over k runs that are each in MessageOrder; next() costs ceil(log2 k) comparisons.
+// Equal keys resolve to the lower run index, so the merged order is fully determined by the inputs.
+class LoserTree {
+public:
+    struct Run {
+        const Message *begin;
+        const Message *end;
+    };
+
+    void reset(const std::vector<Run> &runs);
+
+    const Message *next()
+    {
+        if (runs_.empty())
+        {
+            return nullptr;
+        }
+        std::size_t winner = tree_[0];
+        Run &run = runs_[winner];
+        if (run.begin == run.end)
+        {
+            return nullptr;
+        }
+        const Message *message = run.begin++;
+        replay(winner);
+        return message;
+    }
+
+private:
+    bool beats(std::size_t a, std::size_t b) const
+    {
+        const Run &left = runs_[a];
+        const Run &right = runs_[b];
+        if (left.begin == left.end)
+        {
+            return false;
+        }
+        if (right.begin == right.end)
+        {
+            return true;
+        }
+        MessageOrder order;
+        if (order(*left.begin, *right.begin))
+        {
+            return true;
+        }
+        if (order(*right.begin, *left.begin))
+        {
+            return false;
+        }
+        return a < b;
+    }
+
+    void replay(std::size_t run)
+    {
+        std::size_t winner = run;
+        for (std::size_t node = (run + runs_.size()) / 2; node > 0; node /= 2)
+        {
+            if (beats(tree_[node], winner))
+            {
+                std::swap(tree_[node], winner);
+            }
+        }
+        tree_[0] = winner;
+    }
+
+    std::size_t build(std::size_t node);
+
+    std::vector<Run> runs_;
+    std::vector<std::size_t> tree_;
+};
+
+struct SequencerConfig {
+    std::size_t poll_batch = 256;
+};
+
+struct SequencerStats {
+    std::int64_t polled = 0;
+    std::int64_t emitted = 0;
+    std::int64_t sealed_epochs = 0;
+    // Input runs that were not already in MessageOrder and had to be sorted before merging.
+    std::int64_t sorted_runs = 0;
+    // Messages that arrived for an epoch that was already sealed; pump() drops them instead of emitting them
+    // under a later seal.
+    std::int64_t late = 0;
+};
+
+// Merges several input transports (one per gateway, say) into one deterministic stream per epoch. Each input
+// keeps its own buffer; seal(epoch) takes every buffered message with epoch <= the sealed epoch, sorts only the
+// runs that are not already in order and k-way merges them, so an epoch costs O(n log k) instead of O(n log n).
+class Sequencer {
+public:
+    explicit Sequencer(std::vector<Transport *> inputs, SequencerConfig config = {});
+
+    std::size_t pump();
+
+    // sink(const Message &) sees the sealed messages in canonical order.
+    template <typename Sink>
+    std::size_t seal(std::int64_t epoch, Sink &&sink)
+    {
+        prepare(epoch);
+        std::size_t emitted = 0;
+        while (const Message *message = tree_.next())
+        {
+            sink(*message);
+            emitted++;
+        }
+        stats_.emitted += static_cast<std::int64_t>(emitted);
+        return emitted;
+    }
+
+    std::size_t seal_into(std::int64_t epoch, std::vector<Message> &out);
+
+    std::size_t pending() const;
+    std::int64_t last_sealed_epoch() const;
+    const SequencerStats &stats() const;
+
+private:
+    void prepare(std::int64_t epoch);
+
+    std::vector<Transport *> inputs_;
+    SequencerConfig config_;
+    std::pmr::vector<Message> inbound_;
+    std::vector<std::vector<Message>> buffers_;
+    std::vector<std::vector<Message>> runs_;
+    std::vector<LoserTree::Run> ranges_;
+    LoserTree tree_;
+    std::int64_t last_sealed_epoch_ = -1;
+    SequencerStats stats_;
+};
+
+} // namespace epoch
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#if defined(EPOCH_NO_EXCEPTIONS)
+#define EPOCH_THROW(exception) ::epoch::detail::abort_with((exception).what())
+#else
+#define EPOCH_THROW(exception) throw exception
+#endif
+
+namespace epoch {
+
+namespace detail {
+
+[[noreturn]] inline void abort_with(const char *message)
+{
+    std::fputs(message, stderr);
+    std::fputc('\n', stderr);
+    std::abort();
+}
+
+} // namespace detail
+
+enum class ErrorCode {
+    Ok,
+    Closed,
+    BackPressured,
+    NotConnected,
+    AdminAction,
+    MaxPositionExceeded,
+    OfferFailed,
+    PollFailed,
+    ConnectFailed,
+    InvalidArgument,
+    IoFailed,
+    // The platform has no such facility (e.g. thread affinity or NUMA policy outside Linux).
+    Unsupported,
+};
+
+const char *error_code_name(ErrorCode code);
+
+// Cheap to create on the failure path: context must be a string literal and detail points at storage owned
+// elsewhere (for Aeron, the thread-local aeron_errmsg() buffer), so nothing is copied until format()/message().
+class Status {
+public:
+    Status() = default;
+    Status(ErrorCode code, const char *context, const char *detail = nullptr)
+        : code_(code), context_(context), detail_(detail)
+    {
+    }
+
+    static Status success()
+    {
+        return Status();
+    }
+
+    bool ok() const
+    {
+        return code_ == ErrorCode::Ok;
+    }
+
+    explicit operator bool() const
+    {
+        return ok();
+    }
+
+    ErrorCode code() const
+    {
+        return code_;
+    }
+
+    const char *context() const
+    {
+        return context_;
+    }
+
+    const char *detail() const
+    {
+        return detail_;
+    }
+
+    // Writes "context: detail" into buffer without allocating; returns the untruncated length.
+    std::size_t format(char *buffer, std::size_t length) const;
+    std::string message() const;
+
+private:
+    ErrorCode code_ = ErrorCode::Ok;
+    const char *context_ = nullptr;
+    const char *detail_ = nullptr;
+};
+
+template <typename T>
+class Result {
+public:
+    Result(T value) : value_(std::move(value))
+    {
+    }
+
+    Result(Status status) : status_(status)
+    {
+    }
+
+    bool ok() const
+    {
+        return status_.ok();
+    }
+
+    explicit operator bool() const
+    {
+        return ok();
+    }
+
+    const Status &status() const
+    {
+        return status_;
+    }
+
+    T &value()
+    {
+        return value_;
+    }
+
+    const T &value() const
+    {
+        return value_;
+    }
+
+    T *operator->()
+    {
+        return &value_;
+    }
+
+    T &operator*()
+    {
+        return value_;
+    }
+
+private:
+    T value_{};
+    Status status_;
+};
+
+} // namespace epoch
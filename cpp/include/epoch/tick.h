@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace epoch {
+
+class EpochClock {
+public:
+    virtual ~EpochClock() = default;
+    virtual std::int64_t now_ns() = 0;
+    virtual void sleep_until(std::int64_t deadline_ns) = 0;
+};
+
+// Sleeps until spin_threshold_ns before the deadline, then spins on the clock.
+class SteadyEpochClock final : public EpochClock {
+public:
+    explicit SteadyEpochClock(std::int64_t spin_threshold_ns = 200000);
+
+    std::int64_t now_ns() override;
+    void sleep_until(std::int64_t deadline_ns) override;
+
+private:
+    std::int64_t spin_threshold_ns_;
+};
+
+// Replay clock: sleeping jumps straight to the deadline, so the driver runs at full speed offline.
+class VirtualEpochClock final : public EpochClock {
+public:
+    explicit VirtualEpochClock(std::int64_t start_ns = 0);
+
+    std::int64_t now_ns() override;
+    void sleep_until(std::int64_t deadline_ns) override;
+    void advance(std::int64_t delta_ns);
+
+private:
+    std::int64_t now_ns_;
+};
+
+enum class OverrunPolicy {
+    CatchUp,
+    Skip,
+};
+
+struct TickConfig {
+    std::int64_t period_ns;
+    std::int64_t start_epoch = 1;
+    OverrunPolicy overrun_policy = OverrunPolicy::CatchUp;
+    std::int64_t max_catch_up = 8;
+};
+
+struct TickStats {
+    static constexpr std::size_t kJitterBuckets = 32;
+
+    std::int64_t ticks = 0;
+    std::int64_t overruns = 0;
+    std::int64_t skipped_epochs = 0;
+    std::int64_t catch_up_resets = 0;
+    std::int64_t last_jitter_ns = 0;
+    std::int64_t max_jitter_ns = 0;
+    std::int64_t total_jitter_ns = 0;
+    std::int64_t max_busy_ns = 0;
+    std::array<std::int64_t, kJitterBuckets> jitter_histogram{};
+
+    std::int64_t jitter_percentile_ns(double percentile) const;
+};
+
+class TickDriver {
+public:
+    TickDriver(TickConfig config, EpochClock &clock);
+
+    void reset(std::int64_t first_deadline_ns);
+
+    template <typename OnTick>
+    void step(OnTick &&on_tick)
+    {
+        clock_.sleep_until(deadline_ns_);
+        std::int64_t started = begin_tick();
+        on_tick(epoch_);
+        end_tick(started);
+    }
+
+    template <typename OnTick>
+    std::int64_t run(std::int64_t ticks, OnTick &&on_tick)
+    {
+        std::int64_t executed = 0;
+        stop_.store(false, std::memory_order_relaxed);
+        while (executed < ticks && !stop_.load(std::memory_order_relaxed))
+        {
+            step(on_tick);
+            executed++;
+        }
+        return executed;
+    }
+
+    void stop();
+
+    std::int64_t epoch() const;
+    std::int64_t deadline_ns() const;
+    const TickConfig &config() const;
+    const TickStats &stats() const;
+
+private:
+    std::int64_t begin_tick();
+    void end_tick(std::int64_t started_ns);
+
+    TickConfig config_;
+    EpochClock &clock_;
+    TickStats stats_;
+    std::int64_t epoch_;
+    std::int64_t deadline_ns_;
+    std::atomic<bool> stop_{false};
+};
+
+} // namespace epoch
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "epoch/status.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace epoch {
+
+enum class TracePhase : std::uint8_t {
+    Poll,
+    Drain,
+    Sort,
+    Fold,
+    Hash,
+    Emit,
+};
+
+// One timed phase of one epoch. count is what the phase worked on (messages polled, sorted, sent, ...).
+struct TraceEvent {
+    std::int64_t epoch = 0;
+    std::int64_t begin_ns = 0;
+    std::int64_t end_ns = 0;
+    std::uint32_t count = 0;
+    std::uint32_t thread = 0;
+    TracePhase phase = TracePhase::Poll;
+};
+
+// Events per thread; older ones are overwritten, so a trace always holds the most recent epochs.
+constexpr std::size_t kTraceRingCapacity = 1 << 14;
+
+const char *trace_phase_name(TracePhase phase);
+
+inline std::int64_t trace_clock_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Appends to the calling thread's ring (allocated on the thread's first event). Never blocks or allocates
+// afterwards; a ring whose thread exited is handed to the next new thread.
+void trace_record(TracePhase phase,
+                  std::int64_t epoch,
+                  std::int64_t begin_ns,
+                  std::int64_t end_ns,
+                  std::uint32_t count);
+// Label for the calling thread in exported traces.
+void set_trace_thread_name(const std::string &name);
+
+// Copies the retained events of every thread, oldest first per thread. Safe while threads keep recording;
+// entries overwritten during the copy are skipped.
+std::size_t snapshot_trace(std::vector<TraceEvent> &out);
+// Chrome trace / Perfetto JSON: one complete ("X") event per phase, nested by time, one track per thread.
+Status write_chrome_trace(const std::string &path);
+
+class TraceScope {
+public:
+    TraceScope(TracePhase phase, std::int64_t epoch) : phase_(phase), epoch_(epoch), begin_ns_(trace_clock_ns())
+    {
+    }
+
+    ~TraceScope()
+    {
+        trace_record(phase_, epoch_, begin_ns_, trace_clock_ns(), count_);
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+    void set_count(std::size_t count)
+    {
+        count_ = static_cast<std::uint32_t>(count);
+    }
+
+    // For phases whose epoch is only known once they ran (sorting an arbitrary batch, say).
+    void set_epoch(std::int64_t epoch)
+    {
+        epoch_ = epoch;
+    }
+
+private:
+    TracePhase phase_;
+    std::int64_t epoch_;
+    std::int64_t begin_ns_;
+    std::uint32_t count_ = 0;
+};
+
+} // namespace epoch
+
+// Hot-path hooks. Without EPOCH_TRACING they expand to nothing, so the epoch loop carries no clock reads.
+#if defined(EPOCH_TRACING)
+#define EPOCH_TRACE_SCOPE(name, phase, epoch_value) ::epoch::TraceScope name((phase), (epoch_value))
+#define EPOCH_TRACE_COUNT(name, count) (name).set_count(count)
+#define EPOCH_TRACE_EPOCH(name, epoch_value) (name).set_epoch(epoch_value)
+#else
+#define EPOCH_TRACE_SCOPE(name, phase, epoch_value)
+#define EPOCH_TRACE_COUNT(name, count) ((void)0)
+#define EPOCH_TRACE_EPOCH(name, epoch_value) ((void)0)
+#endif
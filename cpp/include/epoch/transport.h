@@ -1,46 +1,144 @@
 #pragma once
 
+#include "epoch/channel.h"
 #include "epoch/engine.h"
+#include "epoch/status.h"
 
+#include <array>
 #include <cstddef>
 #include <deque>
+#include <exception>
+#include <memory_resource>
 #include <vector>
 
 namespace epoch {
 
+enum class SendResult {
+    Sent,
+    BackPressured,
+    NotConnected,
+    AdminAction,
+    Closed,
+    MaxPositionExceeded,
+    Failed,
+};
+
+// Transient results: retrying later (next flush or epoch) can succeed.
+constexpr bool is_retryable(SendResult result)
+{
+    return result == SendResult::BackPressured || result == SendResult::NotConnected ||
+           result == SendResult::AdminAction;
+}
+
+inline Status to_status(SendResult result)
+{
+    switch (result)
+    {
+    case SendResult::Sent:
+        return Status::success();
+    case SendResult::BackPressured:
+        return Status(ErrorCode::BackPressured, "offer back pressured");
+    case SendResult::NotConnected:
+        return Status(ErrorCode::NotConnected, "publication not connected");
+    case SendResult::AdminAction:
+        return Status(ErrorCode::AdminAction, "offer admin action");
+    case SendResult::Closed:
+        return Status(ErrorCode::Closed, "publication closed");
+    case SendResult::MaxPositionExceeded:
+        return Status(ErrorCode::MaxPositionExceeded, "publication max position exceeded");
+    case SendResult::Failed:
+        break;
+    }
+    return Status(ErrorCode::OfferFailed, "offer failed");
+}
+
 class Transport {
 public:
     virtual ~Transport() = default;
     virtual void send(const Message &message) = 0;
     virtual std::vector<Message> poll(std::size_t max) = 0;
     virtual void close() = 0;
+
+    // Appends up to max messages to out, which may be backed by an EpochArena.
+    virtual std::size_t poll_into(std::pmr::vector<Message> &out, std::size_t max)
+    {
+        auto batch = poll(max);
+        out.insert(out.end(), batch.begin(), batch.end());
+        return batch.size();
+    }
+
+    // Single non-throwing attempt; send() keeps its retry-then-throw behaviour.
+    virtual SendResult try_send(const Message &message)
+    {
+#if defined(EPOCH_NO_EXCEPTIONS)
+        send(message);
+        return SendResult::Sent;
+#else
+        try
+        {
+            send(message);
+            return SendResult::Sent;
+        }
+        catch (const std::exception &)
+        {
+            return SendResult::Failed;
+        }
+#endif
+    }
 };
 
+// In-process channel with one FIFO per QoS band; poll drains higher bands first.
 class InMemoryTransport final : public Transport {
 public:
     void send(const Message &message) override
     {
-        queue_.push_back(message);
+        lanes_[static_cast<std::size_t>(qos_band(message.qos))].push_back(message);
+    }
+
+    SendResult try_send(const Message &message) override
+    {
+        send(message);
+        return SendResult::Sent;
     }
 
     std::vector<Message> poll(std::size_t max) override
     {
         std::vector<Message> out;
-        while (!queue_.empty() && out.size() < max)
-        {
-            out.push_back(queue_.front());
-            queue_.pop_front();
-        }
+        take(out, max);
         return out;
     }
 
+    std::size_t poll_into(std::pmr::vector<Message> &out, std::size_t max) override
+    {
+        return take(out, max);
+    }
+
     void close() override
     {
-        queue_.clear();
+        for (auto &lane : lanes_)
+        {
+            lane.clear();
+        }
     }
 
 private:
-    std::deque<Message> queue_;
+    template <typename Vector>
+    std::size_t take(Vector &out, std::size_t max)
+    {
+        std::size_t count = 0;
+        for (auto &lane : lanes_)
+        {
+            while (!lane.empty() && count < max)
+            {
+                out.push_back(lane.front());
+                lane.pop_front();
+                count++;
+            }
+        }
+        return count;
+    }
+
+    std::array<std::deque<Message>, kQosBandCount> lanes_;
 };
 
 } // namespace epoch
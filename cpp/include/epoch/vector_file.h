@@ -0,0 +1,77 @@
+#pragma once
+
+#include "epoch/engine.h"
+#include "epoch/frame.h"
+#include "epoch/huge_pages.h"
+#include "epoch/results.h"
+#include "epoch/status.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace epoch {
+
+// Binary test vector: a 32-byte header ("EPVB", u32 version, u64 message count, u64 expected count, u64
+// reserved), the messages as v1 frames, then the expected results as results-file records. Every section is
+// fixed-size, so the file is mapped and read in place instead of parsed.
+constexpr char kVectorMagic[4] = {'E', 'P', 'V', 'B'};
+constexpr std::uint32_t kVectorVersion = 1;
+constexpr std::size_t kVectorHeaderLength = 32;
+
+// Parses the text format of test-vectors/epoch_vector_v1.txt ("M,..." / "E,..." lines, '#' comments). Fields
+// are read in place with from_chars; a malformed line fails with the 1-based line number in *error_line.
+Status parse_text_vector(const char *data,
+                         std::size_t length,
+                         std::vector<Message> &messages,
+                         std::vector<EpochRecord> &expected,
+                         std::size_t *error_line = nullptr);
+Status read_text_vector(const std::string &path,
+                        std::vector<Message> &messages,
+                        std::vector<EpochRecord> &expected,
+                        std::size_t *error_line = nullptr);
+
+Status write_vector_file(const std::string &path,
+                         const std::vector<Message> &messages,
+                         const std::vector<EpochRecord> &expected);
+Status convert_text_vector(const std::string &text_path, const std::string &binary_path);
+
+// Read-only memory map of a binary vector. open() validates the header and the section sizes only; pages are
+// faulted in as messages are decoded, so opening does not depend on the vector size.
+class VectorFile {
+public:
+    ~VectorFile();
+
+    VectorFile(const VectorFile &) = delete;
+    VectorFile &operator=(const VectorFile &) = delete;
+
+    // pages: huge-page advice, prefault and mlock for the mapping (see prepare_file_mapping); the default maps
+    // lazily, so opening costs the same for any file size.
+    static Result<std::unique_ptr<VectorFile>> open(const std::string &path, const PageConfig &pages = {});
+
+    std::size_t message_count() const;
+    std::size_t expected_count() const;
+
+    // message_count() consecutive kFrameLength frames, e.g. for handing to a transport unchanged.
+    const std::uint8_t *frames() const;
+
+    bool message(std::size_t index, Message &message) const;
+    bool expected(std::size_t index, EpochRecord &record) const;
+
+    // Decodes up to count messages starting at first; stops early at a frame with the wrong version.
+    std::size_t decode_messages(std::size_t first, std::size_t count, Message *out) const;
+
+private:
+    VectorFile() = default;
+
+    void *mapping_ = nullptr;
+    std::size_t length_ = 0;
+    const std::uint8_t *frames_ = nullptr;
+    const std::uint8_t *expected_ = nullptr;
+    std::size_t message_count_ = 0;
+    std::size_t expected_count_ = 0;
+};
+
+} // namespace epoch
@@ -1,4 +1,5 @@
 #include "epoch/actor_id.h"
+#include "epoch/status.h"
 
 #include <stdexcept>
 
@@ -30,7 +31,7 @@ std::uint64_t DefaultActorIdCodec::encode(const ActorIdParts &parts) const
         parts.process_type > kProcessTypeMax || parts.process_index > kProcessIndexMax ||
         parts.actor_index > kActorIndexMax)
     {
-        throw std::out_of_range("ActorIdParts out of range");
+        EPOCH_THROW(std::out_of_range("ActorIdParts out of range"));
     }
 
     return (static_cast<std::uint64_t>(parts.region) << kRegionShift) |
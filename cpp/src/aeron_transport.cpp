@@ -1,4 +1,6 @@
 #include "epoch/aeron_transport.h"
+#include "epoch/archive.h"
+#include "epoch/frame.h"
 
 extern "C" {
 #include <aeronc.h>
@@ -6,7 +8,9 @@ extern "C" {
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -15,77 +19,73 @@ namespace epoch {
 
 namespace {
 
-constexpr std::uint8_t kFrameVersion = 1;
-constexpr std::size_t kFrameLength = 56;
-constexpr std::size_t kOffsetVersion = 0;
-constexpr std::size_t kOffsetQos = 1;
-constexpr std::size_t kOffsetEpoch = 8;
-constexpr std::size_t kOffsetChannel = 16;
-constexpr std::size_t kOffsetSource = 24;
-constexpr std::size_t kOffsetSourceSeq = 32;
-constexpr std::size_t kOffsetSchema = 40;
-constexpr std::size_t kOffsetPayload = 48;
-
-void write_i64(std::uint8_t *buffer, std::size_t offset, std::int64_t value)
-{
-    std::memcpy(buffer + offset, &value, sizeof(value));
-}
-
-std::int64_t read_i64(const std::uint8_t *buffer, std::size_t offset)
-{
-    std::int64_t value = 0;
-    std::memcpy(&value, buffer + offset, sizeof(value));
-    return value;
-}
-
-void encode_message(std::uint8_t *buffer, const Message &message)
+Status aeron_status(int result, ErrorCode code, const char *context)
 {
-    buffer[kOffsetVersion] = kFrameVersion;
-    buffer[kOffsetQos] = message.qos;
-    std::memset(buffer + 2, 0, 6);
-    write_i64(buffer, kOffsetEpoch, message.epoch);
-    write_i64(buffer, kOffsetChannel, message.channel_id);
-    write_i64(buffer, kOffsetSource, message.source_id);
-    write_i64(buffer, kOffsetSourceSeq, message.source_seq);
-    write_i64(buffer, kOffsetSchema, message.schema_id);
-    write_i64(buffer, kOffsetPayload, message.payload);
+    if (result >= 0)
+    {
+        return Status::success();
+    }
+    return Status(code, context, epoch::detail::aeron_hooks().errmsg());
 }
 
-bool decode_message(const std::uint8_t *buffer, std::size_t length, Message &message)
+Status null_status(const void *ptr, const char *context)
 {
-    if (length < kFrameLength)
-    {
-        return false;
-    }
-    auto version = buffer[kOffsetVersion];
-    if (version != kFrameVersion)
+    if (ptr != nullptr)
     {
-        return false;
+        return Status::success();
     }
-    message.qos = buffer[kOffsetQos];
-    message.epoch = read_i64(buffer, kOffsetEpoch);
-    message.channel_id = read_i64(buffer, kOffsetChannel);
-    message.source_id = read_i64(buffer, kOffsetSource);
-    message.source_seq = read_i64(buffer, kOffsetSourceSeq);
-    message.schema_id = read_i64(buffer, kOffsetSchema);
-    message.payload = read_i64(buffer, kOffsetPayload);
-    return true;
+    return Status(ErrorCode::ConnectFailed, context, epoch::detail::aeron_hooks().errmsg());
 }
 
-void throw_if_error(int result, const char *context)
+#define EPOCH_RETURN_IF_ERROR(expr)      \
+    do                                   \
+    {                                    \
+        Status status_ = (expr);         \
+        if (!status_.ok())               \
+        {                                \
+            return status_;              \
+        }                                \
+    } while (0)
+
+// Driver counter types whose key is (registration id i64, session id i32, stream id i32, channel).
+constexpr std::int32_t kReceiverHwmTypeId = 3;
+constexpr std::int32_t kPublisherPositionTypeId = 12;
+constexpr std::size_t kCounterKeySessionOffset = 8;
+constexpr std::size_t kCounterKeyStreamOffset = 12;
+
+std::int64_t steady_now_ns()
 {
-    if (result < 0)
-    {
-        throw std::runtime_error(std::string(context) + ": " + epoch::detail::aeron_hooks().errmsg());
-    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
 }
 
-void throw_if_null(void *ptr, const char *context)
+template <typename Vector>
+Status poll_subscription(
+    aeron_subscription_t *subscription, std::size_t limit, Vector &out, AeronStats &stats, Archive *archive)
 {
-    if (ptr == nullptr)
-    {
-        throw std::runtime_error(std::string(context) + ": " + epoch::detail::aeron_hooks().errmsg());
-    }
+    struct PollContext {
+        Vector *out;
+        AeronStats *stats;
+        Archive *archive;
+    } context{&out, &stats, archive};
+
+    auto handler = [](void *clientd, const std::uint8_t *buffer, std::size_t length, aeron_header_t *) {
+        auto *ctx = static_cast<PollContext *>(clientd);
+        Message message{};
+        if (!decode_frame(buffer, length, message))
+        {
+            return;
+        }
+        if (ctx->archive != nullptr && !ctx->archive->record(buffer, kFrameLength).ok())
+        {
+            ctx->stats->archive_failures++;
+        }
+        ctx->out->push_back(message);
+        ctx->stats->received_count++;
+    };
+
+    int fragments = detail::aeron_hooks().subscription_poll(subscription, handler, &context, limit);
+    return aeron_status(fragments, ErrorCode::PollFailed, "aeron_subscription_poll failed");
 }
 
 } // namespace
@@ -110,6 +110,15 @@ AeronHooks &aeron_hooks()
         aeron_close,
         aeron_context_close,
         aeron_errmsg,
+        aeron_subscription_image_count,
+        aeron_subscription_for_each_image,
+        aeron_image_constants,
+        aeron_image_position,
+        aeron_counters_reader,
+        aeron_counters_reader_foreach_counter,
+        aeron_counters_reader_addr,
+        aeron_image_is_end_of_stream,
+        aeron_context_get_dir,
     };
     return hooks;
 }
@@ -142,44 +151,106 @@ void reset_aeron_hooks()
         aeron_close,
         aeron_context_close,
         aeron_errmsg,
+        aeron_subscription_image_count,
+        aeron_subscription_for_each_image,
+        aeron_image_constants,
+        aeron_image_position,
+        aeron_counters_reader,
+        aeron_counters_reader_foreach_counter,
+        aeron_counters_reader_addr,
+        aeron_image_is_end_of_stream,
+        aeron_context_get_dir,
     };
 }
 
 } // namespace test
 #endif
 
-AeronTransport::AeronTransport(AeronConfig config) : config_(std::move(config))
+AeronTransport::AeronTransport(AeronConfig config) : AeronTransport(std::move(config), Unconnected{})
+{
+    Status status = connect();
+    if (!status.ok())
+    {
+        close();
+        EPOCH_THROW(std::runtime_error(status.message()));
+    }
+}
+
+AeronTransport::AeronTransport(AeronConfig config, Unconnected)
+    : config_(std::move(config)), budget_(config_.poll_budget, config_.fragment_limit)
 {
     if (config_.fragment_limit <= 0)
     {
         config_.fragment_limit = 64;
+        budget_ = PollBudget(config_.poll_budget, config_.fragment_limit);
     }
     if (config_.offer_max_attempts <= 0)
     {
         config_.offer_max_attempts = 10;
     }
+}
 
-    try
+Result<std::unique_ptr<AeronTransport>> AeronTransport::open(AeronConfig config)
+{
+    std::unique_ptr<AeronTransport> transport(new AeronTransport(std::move(config), Unconnected{}));
+    Status status = transport->connect();
+    if (!status.ok())
     {
-        aeron_context_t *context = nullptr;
-        throw_if_error(detail::aeron_hooks().context_init(&context), "aeron_context_init failed");
-        if (!config_.aeron_directory.empty())
+        transport->close();
+        return status;
+    }
+    return Result<std::unique_ptr<AeronTransport>>(std::move(transport));
+}
+
+Status AeronTransport::connect()
+{
+    auto uri = build_channel_uri(config_.channel, config_.channel_params);
+    if (!uri.ok())
+    {
+        return uri.status();
+    }
+    channel_uri_ = std::move(uri.value());
+
+    std::string directory = config_.aeron_directory;
+    if (config_.embedded_driver.enabled)
+    {
+        auto launched = EmbeddedMediaDriver::launch(directory, config_.embedded_driver);
+        if (!launched.ok())
         {
-            throw_if_error(detail::aeron_hooks().context_set_dir(context, config_.aeron_directory.c_str()),
-                           "aeron_context_set_dir failed");
+            return launched.status();
         }
-        context_ = context;
+        driver_ = std::move(launched.value());
+        directory = driver_->directory();
+    }
+
+    aeron_context_t *context = nullptr;
+    EPOCH_RETURN_IF_ERROR(aeron_status(
+        detail::aeron_hooks().context_init(&context), ErrorCode::ConnectFailed, "aeron_context_init failed"));
+    context_ = context;
+    if (!directory.empty())
+    {
+        EPOCH_RETURN_IF_ERROR(aeron_status(detail::aeron_hooks().context_set_dir(context, directory.c_str()),
+                                           ErrorCode::ConnectFailed,
+                                           "aeron_context_set_dir failed"));
+    }
 
-        aeron_t *client = nullptr;
-        throw_if_error(detail::aeron_hooks().init(&client, context_), "aeron_init failed");
-        throw_if_error(detail::aeron_hooks().start(client), "aeron_start failed");
-        client_ = client;
+    const char *resolved = detail::aeron_hooks().context_get_dir(context_);
+    directory_ = resolved != nullptr ? resolved : directory;
 
+    aeron_t *client = nullptr;
+    EPOCH_RETURN_IF_ERROR(
+        aeron_status(detail::aeron_hooks().init(&client, context_), ErrorCode::ConnectFailed, "aeron_init failed"));
+    client_ = client;
+    EPOCH_RETURN_IF_ERROR(
+        aeron_status(detail::aeron_hooks().start(client), ErrorCode::ConnectFailed, "aeron_start failed"));
+
+    if (config_.role != AeronRole::SubscribeOnly)
+    {
         aeron_async_add_publication_t *pub_async = nullptr;
-        throw_if_error(
-            detail::aeron_hooks().async_add_publication(
-                &pub_async, client_, config_.channel.c_str(), config_.stream_id),
-                       "aeron_async_add_publication failed");
+        EPOCH_RETURN_IF_ERROR(aeron_status(
+            detail::aeron_hooks().async_add_publication(&pub_async, client_, channel_uri_.c_str(), config_.stream_id),
+            ErrorCode::ConnectFailed,
+            "aeron_async_add_publication failed"));
         while (true)
         {
             int poll_result = detail::aeron_hooks().async_add_publication_poll(&publication_, pub_async);
@@ -187,40 +258,36 @@ AeronTransport::AeronTransport(AeronConfig config) : config_(std::move(config))
             {
                 break;
             }
-            throw_if_error(poll_result, "aeron_async_add_publication_poll failed");
+            EPOCH_RETURN_IF_ERROR(
+                aeron_status(poll_result, ErrorCode::ConnectFailed, "aeron_async_add_publication_poll failed"));
             std::this_thread::yield();
         }
-        throw_if_null(publication_, "publication is null");
-
-        aeron_async_add_subscription_t *sub_async = nullptr;
-        throw_if_error(
-            detail::aeron_hooks().async_add_subscription(
-                &sub_async,
-                client_,
-                config_.channel.c_str(),
-                config_.stream_id,
-                nullptr,
-                nullptr,
-                nullptr,
-                nullptr),
-            "aeron_async_add_subscription failed");
-        while (true)
-        {
-            int poll_result = detail::aeron_hooks().async_add_subscription_poll(&subscription_, sub_async);
-            if (poll_result == 1)
-            {
-                break;
-            }
-            throw_if_error(poll_result, "aeron_async_add_subscription_poll failed");
-            std::this_thread::yield();
-        }
-        throw_if_null(subscription_, "subscription is null");
+        EPOCH_RETURN_IF_ERROR(null_status(publication_, "publication is null"));
     }
-    catch (...)
+    if (config_.role == AeronRole::PublishOnly)
     {
-        close();
-        throw;
+        return Status::success();
     }
+
+    aeron_async_add_subscription_t *sub_async = nullptr;
+    EPOCH_RETURN_IF_ERROR(aeron_status(
+        detail::aeron_hooks().async_add_subscription(
+            &sub_async, client_, channel_uri_.c_str(), config_.stream_id, on_available_image, this,
+            on_unavailable_image, this),
+        ErrorCode::ConnectFailed,
+        "aeron_async_add_subscription failed"));
+    while (true)
+    {
+        int poll_result = detail::aeron_hooks().async_add_subscription_poll(&subscription_, sub_async);
+        if (poll_result == 1)
+        {
+            break;
+        }
+        EPOCH_RETURN_IF_ERROR(
+            aeron_status(poll_result, ErrorCode::ConnectFailed, "aeron_async_add_subscription_poll failed"));
+        std::this_thread::yield();
+    }
+    return null_status(subscription_, "subscription is null");
 }
 
 AeronTransport::~AeronTransport()
@@ -232,83 +299,349 @@ void AeronTransport::send(const Message &message)
 {
     if (closed_)
     {
-        throw std::runtime_error("Aeron transport is closed");
+        EPOCH_THROW(std::runtime_error("Aeron transport is closed"));
     }
-    std::array<std::uint8_t, kFrameLength> buffer{};
-    encode_message(buffer.data(), message);
 
     int attempts = 0;
-    std::int64_t result = 0;
     do
     {
-        result = detail::aeron_hooks().publication_offer(
-            publication_, buffer.data(), buffer.size(), nullptr, nullptr);
-        if (result >= 0)
+        if (try_send(message) == SendResult::Sent)
         {
-            stats_.sent_count++;
             return;
         }
-        if (result == AERON_PUBLICATION_BACK_PRESSURED)
-        {
-            stats_.offer_back_pressure++;
-        }
-        else if (result == AERON_PUBLICATION_NOT_CONNECTED)
-        {
-            stats_.offer_not_connected++;
-        }
-        else if (result == AERON_PUBLICATION_ADMIN_ACTION)
-        {
-            stats_.offer_admin_action++;
-        }
-        else if (result == AERON_PUBLICATION_CLOSED)
-        {
-            stats_.offer_closed++;
-        }
-        else if (result == AERON_PUBLICATION_MAX_POSITION_EXCEEDED)
-        {
-            stats_.offer_max_position++;
-        }
-        else
-        {
-            stats_.offer_failed++;
-        }
         attempts++;
         std::this_thread::yield();
     } while (attempts < std::max(1, config_.offer_max_attempts));
 
-    throw std::runtime_error("Aeron offer failed");
+    EPOCH_THROW(std::runtime_error("Aeron offer failed"));
 }
 
-std::vector<Message> AeronTransport::poll(std::size_t max)
+SendResult AeronTransport::try_send(const Message &message)
 {
-    if (closed_ || max == 0)
+    if (closed_)
+    {
+        return SendResult::Closed;
+    }
+    if (publication_ == nullptr)
+    {
+        stats_.offer_failed++;
+        return SendResult::Failed;
+    }
+    std::array<std::uint8_t, kFrameLength> buffer{};
+    encode_frame(buffer.data(), message);
+
+    std::int64_t result =
+        detail::aeron_hooks().publication_offer(publication_, buffer.data(), buffer.size(), nullptr, nullptr);
+    if (result >= 0)
+    {
+        stats_.sent_count++;
+        return SendResult::Sent;
+    }
+    if (result == AERON_PUBLICATION_BACK_PRESSURED)
+    {
+        stats_.offer_back_pressure++;
+        return SendResult::BackPressured;
+    }
+    if (result == AERON_PUBLICATION_NOT_CONNECTED)
+    {
+        stats_.offer_not_connected++;
+        return SendResult::NotConnected;
+    }
+    if (result == AERON_PUBLICATION_ADMIN_ACTION)
+    {
+        stats_.offer_admin_action++;
+        return SendResult::AdminAction;
+    }
+    if (result == AERON_PUBLICATION_CLOSED)
     {
-        return {};
+        stats_.offer_closed++;
+        return SendResult::Closed;
     }
+    if (result == AERON_PUBLICATION_MAX_POSITION_EXCEEDED)
+    {
+        stats_.offer_max_position++;
+        return SendResult::MaxPositionExceeded;
+    }
+    stats_.offer_failed++;
+    return SendResult::Failed;
+}
 
+std::vector<Message> AeronTransport::poll(std::size_t max)
+{
     std::vector<Message> out;
-    std::size_t limit = std::min(max, static_cast<std::size_t>(std::max(1, config_.fragment_limit)));
+    if (closed_ || subscription_ == nullptr || max == 0)
+    {
+        return out;
+    }
+    std::size_t limit = next_poll_limit(max);
     out.reserve(limit);
+    std::int64_t started = config_.poll_budget.enabled ? steady_now_ns() : 0;
+    Status status = poll_subscription(subscription_, limit, out, stats_, config_.archive);
+    finish_poll(out.size(), started);
+    if (!status.ok())
+    {
+        EPOCH_THROW(std::runtime_error(status.message()));
+    }
+    return out;
+}
 
-    struct PollContext {
-        std::vector<Message> *out;
-        AeronStats *stats;
-    } context{&out, &stats_};
+std::size_t AeronTransport::poll_into(std::pmr::vector<Message> &out, std::size_t max)
+{
+    auto polled = try_poll(out, max);
+    if (!polled.ok())
+    {
+        EPOCH_THROW(std::runtime_error(polled.status().message()));
+    }
+    return polled.value();
+}
 
-    auto handler = [](void *clientd, const std::uint8_t *buffer, std::size_t length, aeron_header_t *) {
-        auto *ctx = static_cast<PollContext *>(clientd);
-        Message message{};
-        if (!decode_message(buffer, length, message))
+Result<std::size_t> AeronTransport::try_poll(std::pmr::vector<Message> &out, std::size_t max)
+{
+    if (closed_ || subscription_ == nullptr || max == 0)
+    {
+        return std::size_t{0};
+    }
+    std::size_t before = out.size();
+    std::size_t limit = next_poll_limit(max);
+    std::int64_t started = config_.poll_budget.enabled ? steady_now_ns() : 0;
+    Status status = poll_subscription(subscription_, limit, out, stats_, config_.archive);
+    finish_poll(out.size() - before, started);
+    if (!status.ok())
+    {
+        return status;
+    }
+    return out.size() - before;
+}
+
+std::size_t AeronTransport::next_poll_limit(std::size_t max)
+{
+    if (!config_.poll_budget.enabled)
+    {
+        return std::min(max, static_cast<std::size_t>(config_.fragment_limit));
+    }
+    std::int64_t remaining = deadline_ns_ < 0 ? -1 : std::max<std::int64_t>(0, deadline_ns_ - steady_now_ns());
+    return std::min(max, budget_.next(image_lag_bytes(), remaining));
+}
+
+void AeronTransport::finish_poll(std::size_t fragments, std::int64_t started_ns)
+{
+    sync_image_events();
+    if (config_.poll_budget.enabled)
+    {
+        budget_.observe(fragments, steady_now_ns() - started_ns);
+        stats_.poll_budget = budget_.stats();
+    }
+}
+
+void AeronTransport::sync_image_events()
+{
+    stats_.images_available = image_events_.available.load(std::memory_order_relaxed);
+    stats_.images_unavailable = image_events_.unavailable.load(std::memory_order_relaxed);
+    stats_.images_lost = image_events_.lost.load(std::memory_order_relaxed);
+}
+
+void AeronTransport::on_available_image(void *clientd, aeron_subscription_t *, aeron_image_t *)
+{
+    static_cast<AeronTransport *>(clientd)->image_events_.available.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AeronTransport::on_unavailable_image(void *clientd, aeron_subscription_t *, aeron_image_t *image)
+{
+    auto &events = static_cast<AeronTransport *>(clientd)->image_events_;
+    events.unavailable.fetch_add(1, std::memory_order_relaxed);
+    if (!detail::aeron_hooks().image_is_end_of_stream(image))
+    {
+        events.lost.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::size_t AeronTransport::image_metrics(std::vector<AeronImageMetrics> &out)
+{
+    sync_image_events();
+    if (subscription_ == nullptr || client_ == nullptr)
+    {
+        return 0;
+    }
+    refresh_image_counters();
+    std::size_t first = out.size();
+    struct MetricsContext {
+        AeronTransport *self;
+        std::vector<AeronImageMetrics> *out;
+    } context{this, &out};
+    detail::aeron_hooks().subscription_for_each_image(
+        subscription_,
+        [](aeron_image_t *image, void *clientd) {
+            auto *ctx = static_cast<MetricsContext *>(clientd);
+            aeron_image_constants_t constants{};
+            if (detail::aeron_hooks().image_constants(image, &constants) < 0)
+            {
+                return;
+            }
+            AeronImageMetrics metrics;
+            metrics.session_id = constants.session_id;
+            metrics.correlation_id = constants.correlation_id;
+            metrics.join_position = constants.join_position;
+            metrics.position = detail::aeron_hooks().image_position(image);
+            metrics.end_of_stream = detail::aeron_hooks().image_is_end_of_stream(image);
+            if (constants.source_identity != nullptr)
+            {
+                metrics.source_identity = constants.source_identity;
+            }
+            if (const std::int64_t *counter = ctx->self->image_counter(constants.session_id))
+            {
+                metrics.receiver_position = detail::load_acquire(counter);
+                metrics.lag_bytes = std::max<std::int64_t>(0, metrics.receiver_position - metrics.position);
+            }
+            ctx->out->push_back(std::move(metrics));
+        },
+        &context);
+
+    if (loss_report_ == nullptr && !directory_.empty())
+    {
+        // The driver creates the file at startup; until then (or for a remote driver) there is nothing to read.
+        auto opened = LossReportReader::open(directory_);
+        if (opened.ok())
         {
-            return;
+            loss_report_ = std::move(opened.value());
         }
-        ctx->out->push_back(message);
-        ctx->stats->received_count++;
-    };
+    }
+    if (loss_report_ != nullptr)
+    {
+        struct LossContext {
+            std::int32_t stream_id;
+            AeronImageMetrics *images;
+            std::size_t image_count;
+            std::int64_t observations;
+            std::int64_t bytes;
+        } loss{config_.stream_id, out.data() + first, out.size() - first, 0, 0};
+        loss_report_->read(
+            [](void *clientd, const LossReportEntry &entry) {
+                auto *ctx = static_cast<LossContext *>(clientd);
+                if (entry.stream_id != ctx->stream_id)
+                {
+                    return;
+                }
+                ctx->observations += entry.observation_count;
+                ctx->bytes += entry.total_bytes_lost;
+                for (std::size_t i = 0; i < ctx->image_count; ++i)
+                {
+                    if (ctx->images[i].session_id == entry.session_id)
+                    {
+                        ctx->images[i].loss_observations += entry.observation_count;
+                        ctx->images[i].bytes_lost += entry.total_bytes_lost;
+                    }
+                }
+            },
+            &loss);
+        stats_.loss_observations = loss.observations;
+        stats_.bytes_lost = loss.bytes;
+    }
+    return out.size() - first;
+}
 
-    int fragments = detail::aeron_hooks().subscription_poll(subscription_, handler, &context, limit);
-    throw_if_error(fragments, "aeron_subscription_poll failed");
-    return out;
+void AeronTransport::set_epoch_deadline(std::int64_t deadline_ns)
+{
+    deadline_ns_ = deadline_ns;
+}
+
+std::int64_t AeronTransport::image_lag_bytes()
+{
+    if (subscription_ == nullptr || client_ == nullptr)
+    {
+        return -1;
+    }
+    refresh_image_counters();
+    struct LagContext {
+        AeronTransport *self;
+        std::int64_t lag;
+        bool known;
+    } context{this, 0, false};
+    detail::aeron_hooks().subscription_for_each_image(
+        subscription_,
+        [](aeron_image_t *image, void *clientd) {
+            auto *ctx = static_cast<LagContext *>(clientd);
+            aeron_image_constants_t constants{};
+            if (detail::aeron_hooks().image_constants(image, &constants) < 0)
+            {
+                return;
+            }
+            const std::int64_t *counter = ctx->self->image_counter(constants.session_id);
+            if (counter == nullptr)
+            {
+                return;
+            }
+            std::int64_t received = detail::load_acquire(counter);
+            ctx->lag += std::max<std::int64_t>(0, received - detail::aeron_hooks().image_position(image));
+            ctx->known = true;
+        },
+        &context);
+    return context.known ? context.lag : -1;
+}
+
+void AeronTransport::refresh_image_counters()
+{
+    int count = detail::aeron_hooks().subscription_image_count(subscription_);
+    if (count != image_count_)
+    {
+        image_counters_.clear();
+        image_count_ = count;
+    }
+}
+
+const std::int64_t *AeronTransport::image_counter(std::int32_t session_id)
+{
+    for (const auto &[session, counter] : image_counters_)
+    {
+        if (session == session_id)
+        {
+            return counter;
+        }
+    }
+    aeron_counters_reader_t *reader = detail::aeron_hooks().counters_reader(client_);
+    struct FindContext {
+        std::int32_t session_id;
+        std::int32_t stream_id;
+        std::int32_t counter_id;
+    } context{session_id, config_.stream_id, -1};
+    if (reader != nullptr)
+    {
+        detail::aeron_hooks().counters_reader_foreach_counter(
+            reader,
+            [](std::int64_t,
+               std::int32_t id,
+               std::int32_t type_id,
+               const std::uint8_t *key,
+               std::size_t key_length,
+               const char *,
+               std::size_t,
+               void *clientd) {
+                auto *ctx = static_cast<FindContext *>(clientd);
+                if ((type_id != kReceiverHwmTypeId && type_id != kPublisherPositionTypeId) ||
+                    key_length < kCounterKeyStreamOffset + sizeof(std::int32_t))
+                {
+                    return;
+                }
+                std::int32_t session = 0;
+                std::int32_t stream = 0;
+                std::memcpy(&session, key + kCounterKeySessionOffset, sizeof(session));
+                std::memcpy(&stream, key + kCounterKeyStreamOffset, sizeof(stream));
+                if (session == ctx->session_id && stream == ctx->stream_id)
+                {
+                    ctx->counter_id = id;
+                }
+            },
+            &context);
+    }
+    // Misses are cached too; the cache is dropped when an image comes or goes.
+    const std::int64_t *counter =
+        context.counter_id < 0 ? nullptr : detail::aeron_hooks().counters_reader_addr(reader, context.counter_id);
+    image_counters_.emplace_back(session_id, counter);
+    return counter;
+}
+
+Status AeronTransport::send_status(const Message &message)
+{
+    return to_status(try_send(message));
 }
 
 void AeronTransport::close()
@@ -339,6 +672,8 @@ void AeronTransport::close()
         detail::aeron_hooks().context_close(context_);
         context_ = nullptr;
     }
+    loss_report_.reset();
+    driver_.reset();
 }
 
 const AeronConfig &AeronTransport::config() const
@@ -346,6 +681,16 @@ const AeronConfig &AeronTransport::config() const
     return config_;
 }
 
+const std::string &AeronTransport::channel_uri() const
+{
+    return channel_uri_;
+}
+
+const EmbeddedMediaDriver *AeronTransport::embedded_driver() const
+{
+    return driver_.get();
+}
+
 const AeronStats &AeronTransport::stats() const
 {
     return stats_;
@@ -0,0 +1,266 @@
+#include "epoch/archive.h"
+#include "epoch/frame.h"
+
+#include <array>
+#include <filesystem>
+#include <system_error>
+
+namespace epoch {
+
+LocalArchive::LocalArchive(std::pmr::memory_resource *memory)
+    : data_(memory == nullptr ? std::pmr::get_default_resource() : memory)
+{
+}
+
+LocalArchive::~LocalArchive()
+{
+    if (journal_ != nullptr)
+    {
+        std::fclose(journal_);
+    }
+}
+
+Result<std::unique_ptr<LocalArchive>> LocalArchive::open(const std::string &path, std::pmr::memory_resource *memory)
+{
+    std::unique_ptr<LocalArchive> archive(new LocalArchive(memory));
+    archive->path_ = path;
+
+    std::error_code error;
+    auto size = std::filesystem::file_size(path, error);
+    if (!error)
+    {
+        // One allocation for the existing recording rather than a regrowth per chunk.
+        archive->data_.reserve(static_cast<std::size_t>(size));
+        std::FILE *existing = std::fopen(path.c_str(), "rb");
+        if (existing == nullptr)
+        {
+            return Status(ErrorCode::InvalidArgument, "archive journal open failed");
+        }
+        std::array<std::uint8_t, 64 * kFrameLength> chunk{};
+        std::size_t read = 0;
+        while ((read = std::fread(chunk.data(), 1, chunk.size(), existing)) > 0)
+        {
+            archive->data_.insert(archive->data_.end(), chunk.data(), chunk.data() + read);
+        }
+        std::fclose(existing);
+
+        // A torn trailing frame from a crash is cut off the file too, so the next record() lands on a frame
+        // boundary instead of after the partial bytes.
+        std::size_t whole = archive->data_.size() - archive->data_.size() % kFrameLength;
+        if (whole != archive->data_.size())
+        {
+            archive->data_.resize(whole);
+            std::filesystem::resize_file(path, whole, error);
+            if (error)
+            {
+                return Status(ErrorCode::IoFailed, "archive journal truncate failed");
+            }
+        }
+    }
+
+    archive->journal_ = std::fopen(path.c_str(), "ab");
+    if (archive->journal_ == nullptr)
+    {
+        return Status(ErrorCode::InvalidArgument, "archive journal open failed");
+    }
+    return Result<std::unique_ptr<LocalArchive>>(std::move(archive));
+}
+
+void LocalArchive::reserve(std::size_t bytes)
+{
+    data_.reserve(bytes);
+}
+
+Result<std::int64_t> LocalArchive::record(const std::uint8_t *frame, std::size_t length)
+{
+    if (length != kFrameLength)
+    {
+        return Status(ErrorCode::InvalidArgument, "archive frame length must be kFrameLength");
+    }
+    auto position = static_cast<std::int64_t>(data_.size());
+    if (journal_ != nullptr && std::fwrite(frame, 1, length, journal_) != length)
+    {
+        return Status(ErrorCode::OfferFailed, "archive journal write failed");
+    }
+    data_.insert(data_.end(), frame, frame + length);
+    return position;
+}
+
+std::size_t LocalArchive::replay(std::int64_t from, std::int64_t to, std::size_t max, ArchiveFrameHandler handler,
+                                 void *clientd)
+{
+    auto end = static_cast<std::int64_t>(data_.size());
+    if (to == kArchiveEnd || to > end)
+    {
+        to = end;
+    }
+    if (from < 0 || from % static_cast<std::int64_t>(kFrameLength) != 0)
+    {
+        return 0;
+    }
+
+    std::size_t count = 0;
+    for (std::int64_t position = from; position < to && count < max;
+         position += static_cast<std::int64_t>(kFrameLength))
+    {
+        handler(clientd, data_.data() + position, kFrameLength, position);
+        count++;
+    }
+    return count;
+}
+
+std::int64_t LocalArchive::stop_position() const
+{
+    return static_cast<std::int64_t>(data_.size());
+}
+
+Status LocalArchive::flush()
+{
+    if (journal_ != nullptr && std::fflush(journal_) != 0)
+    {
+        return Status(ErrorCode::OfferFailed, "archive journal flush failed");
+    }
+    return Status::success();
+}
+
+const std::string &LocalArchive::path() const
+{
+    return path_;
+}
+
+RecordingTransport::RecordingTransport(Transport &inner, Archive &archive) : inner_(inner), archive_(archive)
+{
+}
+
+void RecordingTransport::send(const Message &message)
+{
+    inner_.send(message);
+}
+
+SendResult RecordingTransport::try_send(const Message &message)
+{
+    return inner_.try_send(message);
+}
+
+std::vector<Message> RecordingTransport::poll(std::size_t max)
+{
+    auto out = inner_.poll(max);
+    for (const auto &message : out)
+    {
+        record(message);
+    }
+    return out;
+}
+
+std::size_t RecordingTransport::poll_into(std::pmr::vector<Message> &out, std::size_t max)
+{
+    std::size_t before = out.size();
+    std::size_t polled = inner_.poll_into(out, max);
+    for (std::size_t i = before; i < out.size(); ++i)
+    {
+        record(out[i]);
+    }
+    return polled;
+}
+
+void RecordingTransport::close()
+{
+    archive_.flush();
+    inner_.close();
+}
+
+std::int64_t RecordingTransport::record_failures() const
+{
+    return record_failures_;
+}
+
+void RecordingTransport::record(const Message &message)
+{
+    std::array<std::uint8_t, kFrameLength> frame{};
+    encode_frame(frame.data(), message);
+    if (!archive_.record(frame.data(), frame.size()).ok())
+    {
+        record_failures_++;
+    }
+}
+
+ReplayTransport::ReplayTransport(Archive &archive, std::int64_t from, std::int64_t to)
+    : archive_(archive), position_(from), to_(to)
+{
+}
+
+void ReplayTransport::send(const Message &)
+{
+    dropped_sends_++;
+}
+
+SendResult ReplayTransport::try_send(const Message &)
+{
+    dropped_sends_++;
+    return SendResult::Sent;
+}
+
+std::vector<Message> ReplayTransport::poll(std::size_t max)
+{
+    std::vector<Message> out;
+    replay_into(out, max);
+    return out;
+}
+
+std::size_t ReplayTransport::poll_into(std::pmr::vector<Message> &out, std::size_t max)
+{
+    return replay_into(out, max);
+}
+
+void ReplayTransport::close()
+{
+    closed_ = true;
+}
+
+std::int64_t ReplayTransport::position() const
+{
+    return position_;
+}
+
+bool ReplayTransport::done() const
+{
+    std::int64_t end = to_ == kArchiveEnd ? archive_.stop_position() : to_;
+    return closed_ || position_ >= end;
+}
+
+std::int64_t ReplayTransport::dropped_sends() const
+{
+    return dropped_sends_;
+}
+
+template <typename Vector>
+std::size_t ReplayTransport::replay_into(Vector &out, std::size_t max)
+{
+    if (closed_ || max == 0)
+    {
+        return 0;
+    }
+
+    struct ReplayContext {
+        Vector *out;
+        std::int64_t next;
+        std::size_t decoded;
+    } context{&out, position_, 0};
+
+    auto handler = [](void *clientd, const std::uint8_t *frame, std::size_t length, std::int64_t position) {
+        auto *ctx = static_cast<ReplayContext *>(clientd);
+        ctx->next = position + static_cast<std::int64_t>(length);
+        Message message{};
+        if (decode_frame(frame, length, message))
+        {
+            ctx->out->push_back(message);
+            ctx->decoded++;
+        }
+    };
+
+    archive_.replay(position_, to_, max, handler, &context);
+    position_ = context.next;
+    return context.decoded;
+}
+
+} // namespace epoch
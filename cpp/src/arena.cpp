@@ -0,0 +1,113 @@
+#include "epoch/arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace epoch {
+
+EpochArena::EpochArena(std::size_t block_size, std::pmr::memory_resource *upstream)
+    : upstream_(upstream == nullptr ? std::pmr::get_default_resource() : upstream),
+      block_size_(std::max<std::size_t>(block_size, 64))
+{
+}
+
+EpochArena::~EpochArena()
+{
+    for (const auto &block : blocks_)
+    {
+        upstream_->deallocate(block.data, block.size, alignof(std::max_align_t));
+    }
+}
+
+void EpochArena::reset()
+{
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+void EpochArena::reserve(std::size_t bytes)
+{
+    while (reserved_ < bytes)
+    {
+        auto *data = static_cast<std::byte *>(upstream_->allocate(block_size_, alignof(std::max_align_t)));
+        blocks_.push_back(Block{data, block_size_});
+        reserved_ += block_size_;
+    }
+}
+
+std::size_t EpochArena::used() const
+{
+    return used_;
+}
+
+std::size_t EpochArena::reserved() const
+{
+    return reserved_;
+}
+
+std::size_t EpochArena::high_water() const
+{
+    return high_water_;
+}
+
+std::size_t EpochArena::block_count() const
+{
+    return blocks_.size();
+}
+
+void *EpochArena::try_allocate(std::size_t bytes, std::size_t alignment)
+{
+    const auto &block = blocks_[current_];
+    auto base = reinterpret_cast<std::uintptr_t>(block.data);
+    auto aligned = (base + offset_ + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    auto end = aligned - base + bytes;
+    if (end > block.size)
+    {
+        return nullptr;
+    }
+    used_ += end - offset_;
+    high_water_ = std::max(high_water_, used_);
+    offset_ = end;
+    return reinterpret_cast<void *>(aligned);
+}
+
+void *EpochArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (bytes == 0)
+    {
+        bytes = 1;
+    }
+    while (current_ < blocks_.size())
+    {
+        if (void *ptr = try_allocate(bytes, alignment))
+        {
+            return ptr;
+        }
+        if (current_ + 1 == blocks_.size())
+        {
+            break;
+        }
+        current_++;
+        offset_ = 0;
+    }
+
+    std::size_t size = std::max(block_size_, bytes + alignment);
+    auto *data = static_cast<std::byte *>(upstream_->allocate(size, alignof(std::max_align_t)));
+    blocks_.push_back(Block{data, size});
+    reserved_ += size;
+    current_ = blocks_.size() - 1;
+    offset_ = 0;
+    return try_allocate(bytes, alignment);
+}
+
+void EpochArena::do_deallocate(void *, std::size_t, std::size_t)
+{
+}
+
+bool EpochArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+} // namespace epoch
@@ -0,0 +1,189 @@
+#include "epoch/channel_uri.h"
+
+namespace epoch {
+
+namespace {
+
+bool is_udp(const std::string &base)
+{
+    return base.rfind("aeron:udp", 0) == 0;
+}
+
+bool has_param(const std::string &base, const char *key)
+{
+    auto query = base.find('?');
+    if (query == std::string::npos)
+    {
+        return false;
+    }
+    std::string needle = std::string(key) + "=";
+    std::size_t start = query + 1;
+    while (start < base.size())
+    {
+        if (base.compare(start, needle.size(), needle) == 0)
+        {
+            return true;
+        }
+        auto next = base.find('|', start);
+        if (next == std::string::npos)
+        {
+            break;
+        }
+        start = next + 1;
+    }
+    return false;
+}
+
+void append_param(std::string &uri, const char *key, const std::string &value)
+{
+    uri += uri.find('?') == std::string::npos ? '?' : '|';
+    uri += key;
+    uri += '=';
+    uri += value;
+}
+
+} // namespace
+
+Status validate_channel_params(const std::string &base, const ChannelParams &params)
+{
+    bool any_set = !params.endpoint.empty() || params.term_length != 0 || params.mtu_length != 0 ||
+                   params.linger_ns != -1 || params.socket_rcvbuf != 0 || params.socket_sndbuf != 0 ||
+                   params.receiver_window != 0 || !params.control_endpoint.empty() ||
+                   !params.control_mode.empty() || !params.network_interface.empty() || params.ttl != 0;
+    if (!any_set)
+    {
+        return Status::success();
+    }
+    if (base.rfind("aeron:udp", 0) != 0 && base.rfind("aeron:ipc", 0) != 0)
+    {
+        return Status(ErrorCode::InvalidArgument, "channel must start with aeron:udp or aeron:ipc");
+    }
+    if (params.term_length != 0)
+    {
+        if (params.term_length < kMinTermLength || params.term_length > kMaxTermLength ||
+            (params.term_length & (params.term_length - 1)) != 0)
+        {
+            return Status(ErrorCode::InvalidArgument, "term_length must be a power of two in [64 KiB, 1 GiB]");
+        }
+    }
+    if (params.mtu_length != 0)
+    {
+        if (params.mtu_length < kFrameAlignment || params.mtu_length > kMaxUdpPayloadLength ||
+            params.mtu_length % kFrameAlignment != 0)
+        {
+            return Status(ErrorCode::InvalidArgument, "mtu_length must be a multiple of 32 in [32, 65504]");
+        }
+    }
+    if (params.linger_ns < -1)
+    {
+        return Status(ErrorCode::InvalidArgument, "linger_ns must be >= 0 (or -1 for default)");
+    }
+    if (params.socket_rcvbuf < 0 || params.socket_sndbuf < 0 || params.receiver_window < 0)
+    {
+        return Status(ErrorCode::InvalidArgument, "socket buffer and receiver window sizes must be >= 0");
+    }
+    if (params.ttl < 0 || params.ttl > 255)
+    {
+        return Status(ErrorCode::InvalidArgument, "ttl must be in [0, 255]");
+    }
+    if (!params.control_mode.empty() && params.control_mode != "dynamic" && params.control_mode != "manual")
+    {
+        return Status(ErrorCode::InvalidArgument, "control_mode must be dynamic or manual");
+    }
+    if (params.control_mode == "dynamic" && params.control_endpoint.empty())
+    {
+        return Status(ErrorCode::InvalidArgument, "control_mode=dynamic requires control_endpoint");
+    }
+    if (!is_udp(base) && (!params.endpoint.empty() || params.socket_rcvbuf != 0 || params.socket_sndbuf != 0 ||
+                          params.receiver_window != 0 || !params.control_endpoint.empty() ||
+                          !params.control_mode.empty() || !params.network_interface.empty() || params.ttl != 0))
+    {
+        return Status(ErrorCode::InvalidArgument,
+                      "endpoint, socket, control, interface and ttl parameters apply to aeron:udp only");
+    }
+
+    struct Param {
+        const char *key;
+        bool set;
+    };
+    const Param params_set[] = {
+        {"endpoint", !params.endpoint.empty()},
+        {"term-length", params.term_length != 0},
+        {"mtu", params.mtu_length != 0},
+        {"linger", params.linger_ns >= 0},
+        {"so-rcvbuf", params.socket_rcvbuf != 0},
+        {"so-sndbuf", params.socket_sndbuf != 0},
+        {"rcv-wnd", params.receiver_window != 0},
+        {"control", !params.control_endpoint.empty()},
+        {"control-mode", !params.control_mode.empty()},
+        {"interface", !params.network_interface.empty()},
+        {"ttl", params.ttl != 0},
+    };
+    for (const auto &param : params_set)
+    {
+        if (param.set && has_param(base, param.key))
+        {
+            return Status(
+                ErrorCode::InvalidArgument, "channel parameter is set both in the URI and in ChannelParams", param.key);
+        }
+    }
+    return Status::success();
+}
+
+Result<std::string> build_channel_uri(const std::string &base, const ChannelParams &params)
+{
+    Status status = validate_channel_params(base, params);
+    if (!status.ok())
+    {
+        return status;
+    }
+
+    std::string uri = base;
+    if (!params.endpoint.empty())
+    {
+        append_param(uri, "endpoint", params.endpoint);
+    }
+    if (params.term_length != 0)
+    {
+        append_param(uri, "term-length", std::to_string(params.term_length));
+    }
+    if (params.mtu_length != 0)
+    {
+        append_param(uri, "mtu", std::to_string(params.mtu_length));
+    }
+    if (params.linger_ns >= 0)
+    {
+        append_param(uri, "linger", std::to_string(params.linger_ns));
+    }
+    if (params.socket_rcvbuf != 0)
+    {
+        append_param(uri, "so-rcvbuf", std::to_string(params.socket_rcvbuf));
+    }
+    if (params.socket_sndbuf != 0)
+    {
+        append_param(uri, "so-sndbuf", std::to_string(params.socket_sndbuf));
+    }
+    if (params.receiver_window != 0)
+    {
+        append_param(uri, "rcv-wnd", std::to_string(params.receiver_window));
+    }
+    if (!params.control_endpoint.empty())
+    {
+        append_param(uri, "control", params.control_endpoint);
+    }
+    if (!params.control_mode.empty())
+    {
+        append_param(uri, "control-mode", params.control_mode);
+    }
+    if (!params.network_interface.empty())
+    {
+        append_param(uri, "interface", params.network_interface);
+    }
+    if (params.ttl != 0)
+    {
+        append_param(uri, "ttl", std::to_string(params.ttl));
+    }
+    return uri;
+}
+
+} // namespace epoch
@@ -0,0 +1,53 @@
+#include "epoch/digest.h"
+#include "epoch/engine.h"
+
+namespace epoch {
+
+namespace {
+constexpr std::uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr std::uint64_t kFnvPrime = 0x100000001b3ULL;
+
+std::uint64_t mix64(std::uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+std::uint64_t fnv_le64(std::uint64_t hash, std::uint64_t value)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+} // namespace
+
+std::uint64_t digest_entry(std::uint64_t key, const void *value, std::size_t length)
+{
+    auto *bytes = static_cast<const unsigned char *>(value);
+    std::uint64_t hash = fnv_le64(kFnvOffsetBasis, key);
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        hash ^= static_cast<std::uint64_t>(bytes[i]);
+        hash *= kFnvPrime;
+    }
+    return mix64(hash);
+}
+
+std::uint64_t digest_entry(std::uint64_t key, std::int64_t value)
+{
+    return mix64(fnv_le64(fnv_le64(kFnvOffsetBasis, key), static_cast<std::uint64_t>(value)));
+}
+
+std::string StateDigest::hex() const
+{
+    return hash_hex(value_);
+}
+
+} // namespace epoch
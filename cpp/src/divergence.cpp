@@ -0,0 +1,255 @@
+#include "epoch/divergence.h"
+#include "epoch/frame.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <memory_resource>
+#include <thread>
+
+namespace epoch {
+
+namespace {
+
+std::uint64_t splitmix64(std::uint64_t &state)
+{
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+std::int64_t uniform(std::uint64_t &state, std::int64_t bound)
+{
+    return static_cast<std::int64_t>(splitmix64(state) % static_cast<std::uint64_t>(std::max<std::int64_t>(1, bound)));
+}
+
+// Mostly business traffic with some control and system messages, like a live gateway.
+std::uint8_t pick_qos(std::uint64_t &state)
+{
+    std::int64_t roll = uniform(state, 100);
+    if (roll < 40)
+    {
+        return 0;
+    }
+    if (roll < 85)
+    {
+        return static_cast<std::uint8_t>(1 + uniform(state, 127));
+    }
+    if (roll < 97)
+    {
+        return static_cast<std::uint8_t>(128 + uniform(state, 112));
+    }
+    return static_cast<std::uint8_t>(240 + uniform(state, 16));
+}
+
+bool same_record(const EpochRecord &a, const EpochRecord &b)
+{
+    return a.epoch == b.epoch && a.state == b.state && a.hash == b.hash && a.digest == b.digest;
+}
+
+} // namespace
+
+std::vector<Message> generate_vector(const VectorSpec &spec)
+{
+    std::uint64_t state = spec.seed;
+    std::vector<std::int64_t> next_seq(static_cast<std::size_t>(std::max<std::int64_t>(1, spec.sources)), 0);
+    std::vector<Message> messages;
+    messages.reserve(static_cast<std::size_t>(std::max<std::int64_t>(0, spec.messages)));
+    for (std::int64_t i = 0; i < spec.messages; ++i)
+    {
+        Message message{};
+        message.epoch = 1 + uniform(state, spec.epochs);
+        message.channel_id = uniform(state, spec.channels);
+        message.source_id = uniform(state, spec.sources);
+        message.source_seq = ++next_seq[static_cast<std::size_t>(message.source_id)];
+        message.schema_id = 1 + uniform(state, 8);
+        message.qos = pick_qos(state);
+        message.payload = uniform(state, 2000001) - 1000000;
+        messages.push_back(message);
+    }
+    return messages;
+}
+
+Status write_journal(const std::string &path, const std::vector<Message> &messages)
+{
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return Status(ErrorCode::IoFailed, "journal open failed");
+    }
+    std::array<std::uint8_t, 1024 * kFrameLength> chunk{};
+    std::size_t used = 0;
+    bool ok = true;
+    for (const auto &message : messages)
+    {
+        encode_frame(chunk.data() + used, message);
+        used += kFrameLength;
+        if (used == chunk.size())
+        {
+            ok = ok && std::fwrite(chunk.data(), 1, used, file) == used;
+            used = 0;
+        }
+    }
+    ok = ok && std::fwrite(chunk.data(), 1, used, file) == used;
+    ok = std::fclose(file) == 0 && ok;
+    return ok ? Status::success() : Status(ErrorCode::IoFailed, "journal write failed");
+}
+
+Result<std::vector<Message>> read_journal(const std::string &path)
+{
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+    {
+        return Status(ErrorCode::IoFailed, "journal open failed");
+    }
+    std::vector<Message> messages;
+    std::array<std::uint8_t, 1024 * kFrameLength> chunk{};
+    std::size_t read = 0;
+    while ((read = std::fread(chunk.data(), 1, chunk.size(), file)) > 0)
+    {
+        for (std::size_t offset = 0; offset + kFrameLength <= read; offset += kFrameLength)
+        {
+            Message message{};
+            if (decode_frame(chunk.data() + offset, kFrameLength, message))
+            {
+                messages.push_back(message);
+            }
+        }
+    }
+    std::fclose(file);
+    return messages;
+}
+
+std::vector<EpochRecord> process_parallel(const std::vector<Message> &messages, std::size_t threads)
+{
+    if (messages.empty())
+    {
+        return {};
+    }
+    auto [lowest, highest] = std::minmax_element(
+        messages.begin(), messages.end(), [](const Message &a, const Message &b) { return a.epoch < b.epoch; });
+    std::int64_t first_epoch = lowest->epoch;
+    auto epoch_count = static_cast<std::uint64_t>(highest->epoch - first_epoch) + 1;
+    std::size_t ranges = std::max<std::size_t>(1, std::min<std::uint64_t>(threads, epoch_count));
+    std::uint64_t span = (epoch_count + ranges - 1) / ranges;
+
+    struct Range {
+        std::vector<Message> messages;
+        std::int64_t sum = 0;
+        std::vector<EpochRecord> records;
+    };
+    std::vector<Range> parts(ranges);
+
+    auto run = [&](auto &&work) {
+        std::vector<std::thread> workers;
+        for (std::size_t r = 1; r < ranges; ++r)
+        {
+            workers.emplace_back(work, r);
+        }
+        work(0);
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    };
+
+    // One pass hands each range its messages; the workers then only sort their own slice.
+    auto range_of = [&](const Message &message) {
+        return static_cast<std::size_t>(static_cast<std::uint64_t>(message.epoch - first_epoch) / span);
+    };
+    std::vector<std::size_t> sizes(ranges, 0);
+    for (const auto &message : messages)
+    {
+        sizes[range_of(message)]++;
+    }
+    for (std::size_t r = 0; r < ranges; ++r)
+    {
+        parts[r].messages.reserve(sizes[r]);
+    }
+    for (const auto &message : messages)
+    {
+        auto &part = parts[range_of(message)];
+        part.messages.push_back(message);
+        part.sum += message.payload;
+    }
+
+    run([&](std::size_t r) {
+        auto &part = parts[r];
+        std::pmr::vector<Message> scratch;
+        sort_messages(part.messages.data(), part.messages.data() + part.messages.size(), scratch);
+    });
+
+    std::vector<std::int64_t> initial(ranges, 0);
+    for (std::size_t r = 1; r < ranges; ++r)
+    {
+        initial[r] = initial[r - 1] + parts[r - 1].sum;
+    }
+
+    run([&](std::size_t r) {
+        auto &part = parts[r];
+        EpochEngine<> engine(SumReducer{}, initial[r]);
+        engine.fold(part.messages.data(), part.messages.data() + part.messages.size(),
+                    [&part](std::int64_t epoch, std::int64_t state, std::uint64_t hash) {
+                        part.records.push_back(EpochRecord{epoch, state, hash, state_digest(state)});
+                    });
+    });
+
+    std::vector<EpochRecord> records;
+    for (auto &part : parts)
+    {
+        records.insert(records.end(), part.records.begin(), part.records.end());
+    }
+    return records;
+}
+
+Result<Divergence> first_divergence(ResultFileReader &left, ResultFileReader &right)
+{
+    Divergence divergence;
+    std::size_t common = std::min(left.count(), right.count());
+    EpochRecord a{};
+    EpochRecord b{};
+    auto differs = [&](std::size_t index, bool &failed) {
+        divergence.probes++;
+        if (!left.read(index, a) || !right.read(index, b))
+        {
+            failed = true;
+            return false;
+        }
+        return !same_record(a, b);
+    };
+
+    // Sum states are path-independent: two runs can differ at one record and agree again afterwards, so no
+    // predicate over a single index is monotonic and bisection could miss the difference. Scan in order.
+    std::size_t lo = 0;
+    for (bool failed = false; lo < common; ++lo)
+    {
+        if (differs(lo, failed))
+        {
+            break;
+        }
+        if (failed)
+        {
+            return Status(ErrorCode::IoFailed, "results file read failed");
+        }
+    }
+
+    if (lo < common)
+    {
+        divergence.found = true;
+        divergence.index = lo;
+        left.read(lo, divergence.left);
+        right.read(lo, divergence.right);
+    }
+    else if (left.count() != right.count())
+    {
+        divergence.found = true;
+        divergence.length_mismatch = true;
+        divergence.index = common;
+        left.read(common, divergence.left);
+        right.read(common, divergence.right);
+    }
+    return divergence;
+}
+
+} // namespace epoch
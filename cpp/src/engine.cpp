@@ -1,8 +1,9 @@
 #include "epoch/engine.h"
+#include "epoch/digest.h"
 
 #include <algorithm>
-#include <iomanip>
-#include <sstream>
+#include <charconv>
+#include <cstring>
 
 namespace epoch {
 
@@ -11,69 +12,130 @@ constexpr std::uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
 constexpr std::uint64_t kFnvPrime = 0x100000001b3ULL;
 } // namespace
 
-std::string fnv1a64_hex(const std::string &input)
+std::uint64_t fnv1a64(const void *data, std::size_t length)
 {
+    auto *bytes = static_cast<const unsigned char *>(data);
     std::uint64_t hash = kFnvOffsetBasis;
-    for (unsigned char byte : input)
+    for (std::size_t i = 0; i < length; ++i)
     {
-        hash ^= static_cast<std::uint64_t>(byte);
+        hash ^= static_cast<std::uint64_t>(bytes[i]);
         hash *= kFnvPrime;
     }
+    return hash;
+}
 
-    std::ostringstream out;
-    out << std::hex << std::nouppercase << std::setw(16) << std::setfill('0') << hash;
-    return out.str();
+std::string fnv1a64_hex(const std::string &input)
+{
+    return hash_hex(fnv1a64(input.data(), input.size()));
 }
 
-std::vector<EpochResult> process_messages(std::vector<Message> messages)
+std::string hash_hex(std::uint64_t hash)
 {
-    std::sort(messages.begin(), messages.end(), [](const Message &a, const Message &b) {
-        if (a.epoch != b.epoch)
-        {
-            return a.epoch < b.epoch;
-        }
-        if (a.channel_id != b.channel_id)
-        {
-            return a.channel_id < b.channel_id;
-        }
-        if (a.qos != b.qos)
-        {
-            return a.qos > b.qos;
-        }
-        if (a.source_id != b.source_id)
+    static constexpr char kDigits[] = "0123456789abcdef";
+    std::string out(16, '0');
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        out[15 - i] = kDigits[hash & 0xF];
+        hash >>= 4;
+    }
+    return out;
+}
+
+std::uint64_t state_hash(std::int64_t state)
+{
+    static constexpr char kPrefix[] = "state:";
+    char buffer[32];
+    std::memcpy(buffer, kPrefix, sizeof(kPrefix) - 1);
+    auto [end, ec] = std::to_chars(buffer + sizeof(kPrefix) - 1, buffer + sizeof(buffer), state);
+    (void)ec;
+    return fnv1a64(buffer, static_cast<std::size_t>(end - buffer));
+}
+
+std::uint64_t state_digest(std::int64_t state)
+{
+    return digest_entry(0, state);
+}
+
+SortPath sort_messages(Message *begin, Message *end, std::pmr::vector<Message> &scratch)
+{
+    MessageOrder order;
+    std::size_t count = static_cast<std::size_t>(end - begin);
+    std::size_t descents = 0;
+    for (std::size_t i = 1; i < count && descents < kMaxMergeRuns; ++i)
+    {
+        descents += order(begin[i], begin[i - 1]) ? 1 : 0;
+    }
+    if (descents == 0)
+    {
+        return SortPath::Presorted;
+    }
+    if (descents >= kMaxMergeRuns)
+    {
+        std::sort(begin, end, order);
+        return SortPath::Sorted;
+    }
+
+    // bounds[r] .. bounds[r + 1] is ascending run r.
+    std::size_t bounds[kMaxMergeRuns + 1];
+    std::size_t runs = 0;
+    bounds[0] = 0;
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        if (order(begin[i], begin[i - 1]))
         {
-            return a.source_id < b.source_id;
+            bounds[++runs] = i;
         }
-        return a.source_seq < b.source_seq;
-    });
-
-    std::vector<EpochResult> results;
-    std::int64_t current_epoch = 0;
-    std::int64_t state = 0;
-    bool has_epoch = false;
+    }
+    bounds[++runs] = count;
 
-    for (const auto &msg : messages)
+    if (scratch.size() < count)
     {
-        if (!has_epoch)
+        scratch.resize(count);
+    }
+    while (runs > 1)
+    {
+        std::size_t merged = 0;
+        std::size_t r = 0;
+        for (; r + 1 < runs; r += 2)
         {
-            current_epoch = msg.epoch;
-            has_epoch = true;
+            Message *lo = begin + bounds[r];
+            Message *mid = begin + bounds[r + 1];
+            Message *hi = begin + bounds[r + 2];
+            std::merge(lo, mid, mid, hi, scratch.begin(), order);
+            std::copy(scratch.begin(), scratch.begin() + (hi - lo), lo);
+            bounds[++merged] = bounds[r + 2];
         }
-        if (msg.epoch != current_epoch)
+        if (r < runs)
         {
-            std::string hash = fnv1a64_hex("state:" + std::to_string(state));
-            results.push_back({current_epoch, state, hash});
-            current_epoch = msg.epoch;
+            bounds[++merged] = bounds[r + 1];
         }
-        state += msg.payload;
+        runs = merged;
     }
+    return SortPath::Merged;
+}
 
-    if (has_epoch)
-    {
-        std::string hash = fnv1a64_hex("state:" + std::to_string(state));
-        results.push_back({current_epoch, state, hash});
-    }
+std::vector<EpochResult> process_messages(std::vector<Message> messages)
+{
+    std::vector<EpochResult> results;
+    EpochEngine<> engine;
+    engine.process(messages.data(), messages.data() + messages.size(),
+                   [&](std::int64_t epoch, std::int64_t state, std::uint64_t hash) {
+                       results.push_back({epoch, state, hash_hex(hash), hash_hex(state_digest(state))});
+                   });
+    return results;
+}
 
+ArenaVector<EpochRecord> process_messages(const Message *messages, std::size_t count, EpochArena &arena)
+{
+    ArenaVector<Message> sorted(messages, messages + count, &arena);
+    ArenaVector<Message> scratch(&arena);
+    ArenaVector<EpochRecord> results(&arena);
+    EpochEngine<> engine;
+    sort_messages(sorted.data(), sorted.data() + sorted.size(), scratch);
+    engine.fold(sorted.data(), sorted.data() + sorted.size(),
+                   [&](std::int64_t epoch, std::int64_t state, std::uint64_t hash) {
+                       results.push_back({epoch, state, hash, state_digest(state)});
+                   });
     return results;
 }
 
@@ -0,0 +1,280 @@
+#include "epoch/huge_pages.h"
+#include "epoch/numa.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace epoch {
+
+namespace {
+
+#if defined(__linux__)
+// linux/mman.h values, for libcs that do not expose them.
+#if !defined(MAP_HUGE_SHIFT)
+constexpr int kMapHugeShift = 26;
+#else
+constexpr int kMapHugeShift = MAP_HUGE_SHIFT;
+#endif
+#if !defined(MADV_POPULATE_READ)
+constexpr int kMadvPopulateRead = 22;
+#else
+constexpr int kMadvPopulateRead = MADV_POPULATE_READ;
+#endif
+#endif
+
+std::size_t base_page_size()
+{
+#if defined(_WIN32)
+    static const auto size = [] {
+        SYSTEM_INFO info{};
+        ::GetSystemInfo(&info);
+        return static_cast<std::size_t>(info.dwPageSize);
+    }();
+#else
+    static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+    return size;
+}
+
+std::size_t round_up(std::size_t value, std::size_t granule)
+{
+    return (value + granule - 1) / granule * granule;
+}
+
+// Base pages, read/write, zero-filled; nullptr on failure.
+void *map_plain(std::size_t length)
+{
+#if defined(_WIN32)
+    return ::VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    void *data = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return data == MAP_FAILED ? nullptr : data;
+#endif
+}
+
+bool lock_range(const void *data, std::size_t length)
+{
+#if defined(_WIN32)
+    return ::VirtualLock(const_cast<void *>(data), length) != 0;
+#else
+    return ::mlock(data, length) == 0;
+#endif
+}
+
+#if defined(__linux__)
+// Over-maps by one alignment unit and trims both ends, so THP can back the range from its first byte.
+void *map_aligned(std::size_t length, std::size_t alignment)
+{
+    std::size_t span = length + alignment;
+    void *raw = ::mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    auto start = reinterpret_cast<std::uintptr_t>(raw);
+    auto aligned = round_up(start, alignment);
+    if (aligned > start)
+    {
+        ::munmap(raw, aligned - start);
+    }
+    std::size_t tail = start + span - (aligned + length);
+    if (tail > 0)
+    {
+        ::munmap(reinterpret_cast<void *>(aligned + length), tail);
+    }
+    return reinterpret_cast<void *>(aligned);
+}
+#endif
+
+} // namespace
+
+Result<PageMapping> map_pages(std::size_t length, const PageConfig &config)
+{
+    length = std::max<std::size_t>(length, 1);
+    PageMapping mapping;
+#if defined(__linux__)
+    if (config.huge_pages == HugePageMode::Explicit2M || config.huge_pages == HugePageMode::Explicit1G)
+    {
+        bool giant = config.huge_pages == HugePageMode::Explicit1G;
+        std::size_t rounded = round_up(length, giant ? kHugePage1G : kHugePage2M);
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | ((giant ? 30 : 21) << kMapHugeShift);
+        void *data = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (data != MAP_FAILED)
+        {
+            mapping.data = data;
+            mapping.length = rounded;
+            mapping.explicit_huge = true;
+        }
+    }
+    if (mapping.data == nullptr)
+    {
+        bool transparent = config.huge_pages != HugePageMode::Off;
+        std::size_t rounded = round_up(length, transparent ? kHugePage2M : base_page_size());
+        void *data = nullptr;
+        if (transparent)
+        {
+            data = map_aligned(rounded, kHugePage2M);
+        }
+        else
+        {
+            data = map_plain(rounded);
+        }
+        if (data == nullptr)
+        {
+            return Status(ErrorCode::IoFailed, "page mapping failed", std::strerror(errno));
+        }
+        if (transparent)
+        {
+            ::madvise(data, rounded, MADV_HUGEPAGE);
+        }
+        mapping.data = data;
+        mapping.length = rounded;
+    }
+#else
+    // No huge page API here: every mode maps base pages, and explicit requests count as fallbacks.
+    std::size_t rounded = round_up(length, base_page_size());
+    mapping.data = map_plain(rounded);
+    if (mapping.data == nullptr)
+    {
+        return Status(ErrorCode::IoFailed, "page mapping failed");
+    }
+    mapping.length = rounded;
+#endif
+    if (config.node >= 0)
+    {
+        bind_memory(mapping.data, mapping.length, config.node);
+    }
+    if (config.prefault)
+    {
+        touch_pages(mapping.data, mapping.length);
+    }
+    if (config.lock)
+    {
+        mapping.locked = lock_range(mapping.data, mapping.length);
+    }
+    return mapping;
+}
+
+void unmap_pages(const PageMapping &mapping)
+{
+    if (mapping.data != nullptr)
+    {
+#if defined(_WIN32)
+        ::VirtualFree(mapping.data, 0, MEM_RELEASE);
+#else
+        ::munmap(mapping.data, mapping.length);
+#endif
+    }
+}
+
+Status prepare_file_mapping(const void *data, std::size_t length, const PageConfig &config)
+{
+#if !defined(__linux__)
+    (void)data;
+    (void)length;
+    (void)config;
+    return Status::success();
+#else
+    auto *address = const_cast<void *>(data);
+    if (config.huge_pages != HugePageMode::Off)
+    {
+        // Needs file THP support in the kernel; elsewhere the advice is refused and base pages stay.
+        ::madvise(address, length, MADV_HUGEPAGE);
+    }
+    if (config.prefault && ::madvise(address, length, kMadvPopulateRead) != 0)
+    {
+        // Kernels before 5.14: read one byte per page.
+        const auto *bytes = static_cast<const volatile std::uint8_t *>(data);
+        for (std::size_t offset = 0; offset < length; offset += base_page_size())
+        {
+            (void)bytes[offset];
+        }
+    }
+    if (config.lock && ::mlock(data, length) != 0)
+    {
+        return Status(ErrorCode::IoFailed, "mlock failed", std::strerror(errno));
+    }
+    return Status::success();
+#endif
+}
+
+PageMemoryResource::PageMemoryResource(PageConfig config) : config_(config)
+{
+}
+
+PageMemoryResource::~PageMemoryResource()
+{
+    for (const auto &mapping : mappings_)
+    {
+        unmap_pages(mapping);
+    }
+}
+
+const PageConfig &PageMemoryResource::config() const
+{
+    return config_;
+}
+
+const PageMemoryStats &PageMemoryResource::stats() const
+{
+    return stats_;
+}
+
+void *PageMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (alignment > base_page_size())
+    {
+        EPOCH_THROW(std::bad_alloc());
+    }
+    auto mapping = map_pages(bytes, config_);
+    if (!mapping.ok())
+    {
+        EPOCH_THROW(std::bad_alloc());
+    }
+    const auto &pages = mapping.value();
+    bool wanted_explicit =
+        config_.huge_pages == HugePageMode::Explicit2M || config_.huge_pages == HugePageMode::Explicit1G;
+    stats_.allocations++;
+    stats_.bytes += static_cast<std::int64_t>(pages.length);
+    stats_.explicit_huge += pages.explicit_huge ? 1 : 0;
+    stats_.fallbacks += wanted_explicit && !pages.explicit_huge ? 1 : 0;
+    stats_.lock_failures += config_.lock && !pages.locked ? 1 : 0;
+    mappings_.push_back(pages);
+    return pages.data;
+}
+
+void PageMemoryResource::do_deallocate(void *pointer, std::size_t, std::size_t)
+{
+    auto it = std::find_if(
+        mappings_.begin(), mappings_.end(), [pointer](const PageMapping &mapping) { return mapping.data == pointer; });
+    if (it == mappings_.end())
+    {
+        return;
+    }
+    stats_.allocations--;
+    stats_.bytes -= static_cast<std::int64_t>(it->length);
+    unmap_pages(*it);
+    mappings_.erase(it);
+}
+
+bool PageMemoryResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+} // namespace epoch
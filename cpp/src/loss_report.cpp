@@ -0,0 +1,171 @@
+#include "epoch/loss_report.h"
+
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace epoch {
+
+namespace {
+
+constexpr std::size_t kObservationCountOffset = 0;
+constexpr std::size_t kTotalBytesLostOffset = 8;
+constexpr std::size_t kFirstObservationOffset = 16;
+constexpr std::size_t kLastObservationOffset = 24;
+constexpr std::size_t kSessionIdOffset = 32;
+constexpr std::size_t kStreamIdOffset = 36;
+constexpr std::size_t kChannelOffset = 40;
+
+template <typename T>
+T load(const std::uint8_t *at)
+{
+    T value;
+    std::memcpy(&value, at, sizeof(value));
+    return value;
+}
+
+// Length-prefixed ASCII; false if it runs past end.
+bool read_string(const std::uint8_t *at, const std::uint8_t *end, std::string_view &out)
+{
+    if (end - at < static_cast<std::ptrdiff_t>(sizeof(std::int32_t)))
+    {
+        return false;
+    }
+    auto length = load<std::int32_t>(at);
+    if (length < 0 || end - at - static_cast<std::ptrdiff_t>(sizeof(std::int32_t)) < length)
+    {
+        return false;
+    }
+    out = std::string_view(reinterpret_cast<const char *>(at + sizeof(std::int32_t)), static_cast<std::size_t>(length));
+    return true;
+}
+
+} // namespace
+
+std::size_t read_loss_report(const std::uint8_t *buffer, std::size_t length, LossReportHandler handler, void *clientd)
+{
+    std::size_t entries = 0;
+    std::size_t offset = 0;
+    const std::uint8_t *end = buffer + length;
+    while (offset + kChannelOffset + sizeof(std::int32_t) <= length)
+    {
+        const std::uint8_t *entry = buffer + offset;
+        // The driver publishes an entry by storing its observation count last.
+        std::int64_t observations =
+            detail::load_acquire(reinterpret_cast<const std::int64_t *>(entry + kObservationCountOffset));
+        if (observations <= 0)
+        {
+            break;
+        }
+        LossReportEntry report;
+        report.observation_count = observations;
+        report.total_bytes_lost = load<std::int64_t>(entry + kTotalBytesLostOffset);
+        report.first_observation_ns = load<std::int64_t>(entry + kFirstObservationOffset);
+        report.last_observation_ns = load<std::int64_t>(entry + kLastObservationOffset);
+        report.session_id = load<std::int32_t>(entry + kSessionIdOffset);
+        report.stream_id = load<std::int32_t>(entry + kStreamIdOffset);
+        const std::uint8_t *source = entry + kChannelOffset;
+        if (!read_string(source, end, report.channel))
+        {
+            break;
+        }
+        source += sizeof(std::int32_t) + report.channel.size();
+        if (!read_string(source, end, report.source))
+        {
+            break;
+        }
+        handler(clientd, report);
+        entries++;
+
+        std::size_t record = kChannelOffset + 2 * sizeof(std::int32_t) + report.channel.size() + report.source.size();
+        offset += (record + kLossReportEntryAlignment - 1) / kLossReportEntryAlignment * kLossReportEntryAlignment;
+    }
+    return entries;
+}
+
+LossReportReader::~LossReportReader()
+{
+    if (mapping_ != nullptr)
+    {
+#if defined(_WIN32)
+        ::UnmapViewOfFile(mapping_);
+#else
+        ::munmap(mapping_, length_);
+#endif
+    }
+}
+
+Result<std::unique_ptr<LossReportReader>> LossReportReader::open(const std::string &aeron_directory)
+{
+    std::string path = aeron_directory + "/" + kLossReportFileName;
+#if defined(_WIN32)
+    // The driver keeps the file open for writing; share it rather than asking for exclusive read access.
+    HANDLE handle = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        return Status(ErrorCode::IoFailed, "loss report open failed");
+    }
+    LARGE_INTEGER size{};
+    if (!::GetFileSizeEx(handle, &size) || size.QuadPart <= 0)
+    {
+        ::CloseHandle(handle);
+        return Status(ErrorCode::IoFailed, "loss report is empty");
+    }
+    auto length = static_cast<std::size_t>(size.QuadPart);
+    HANDLE section = ::CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(handle);
+    void *mapping = section != nullptr ? ::MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (section != nullptr)
+    {
+        ::CloseHandle(section);
+    }
+    if (mapping == nullptr)
+    {
+        return Status(ErrorCode::IoFailed, "loss report mmap failed");
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return Status(ErrorCode::IoFailed, "loss report open failed");
+    }
+    struct stat info{};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        ::close(fd);
+        return Status(ErrorCode::IoFailed, "loss report is empty");
+    }
+    auto length = static_cast<std::size_t>(info.st_size);
+    void *mapping = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        return Status(ErrorCode::IoFailed, "loss report mmap failed");
+    }
+#endif
+    std::unique_ptr<LossReportReader> reader(new LossReportReader());
+    reader->mapping_ = mapping;
+    reader->length_ = length;
+    return Result<std::unique_ptr<LossReportReader>>(std::move(reader));
+}
+
+std::size_t LossReportReader::read(LossReportHandler handler, void *clientd) const
+{
+    return read_loss_report(static_cast<const std::uint8_t *>(mapping_), length_, handler, clientd);
+}
+
+} // namespace epoch
@@ -0,0 +1,160 @@
+#include "epoch/media_driver.h"
+#include "epoch/aeron_transport.h"
+
+namespace epoch {
+
+#if defined(EPOCH_EMBEDDED_DRIVER)
+namespace {
+
+detail::DriverHooks default_driver_hooks()
+{
+    return detail::DriverHooks{
+        aeron_driver_context_init,
+        aeron_driver_context_set_dir,
+        aeron_driver_context_get_dir,
+        aeron_driver_context_set_threading_mode,
+        aeron_driver_context_set_term_buffer_length,
+        aeron_driver_context_set_ipc_term_buffer_length,
+        aeron_driver_context_set_dir_delete_on_start,
+        aeron_driver_context_set_dir_delete_on_shutdown,
+        aeron_driver_context_set_pre_touch_mapped_memory,
+        aeron_driver_init,
+        aeron_driver_start,
+        aeron_driver_close,
+        aeron_driver_context_close,
+    };
+}
+
+aeron_threading_mode_t to_aeron(DriverThreadingMode mode)
+{
+    switch (mode)
+    {
+    case DriverThreadingMode::Dedicated:
+        return AERON_THREADING_MODE_DEDICATED;
+    case DriverThreadingMode::SharedNetwork:
+        return AERON_THREADING_MODE_SHARED_NETWORK;
+    case DriverThreadingMode::Shared:
+        break;
+    }
+    return AERON_THREADING_MODE_SHARED;
+}
+
+Status driver_status(int result, const char *context)
+{
+    if (result >= 0)
+    {
+        return Status::success();
+    }
+    return Status(ErrorCode::ConnectFailed, context, detail::aeron_hooks().errmsg());
+}
+
+} // namespace
+
+namespace detail {
+
+DriverHooks &driver_hooks()
+{
+    static DriverHooks hooks = default_driver_hooks();
+    return hooks;
+}
+
+} // namespace detail
+
+#ifdef EPOCH_TESTING
+namespace test {
+
+detail::DriverHooks &driver_hooks()
+{
+    return detail::driver_hooks();
+}
+
+void reset_driver_hooks()
+{
+    detail::driver_hooks() = default_driver_hooks();
+}
+
+} // namespace test
+#endif
+#endif
+
+EmbeddedMediaDriver::~EmbeddedMediaDriver()
+{
+    close();
+}
+
+Result<std::unique_ptr<EmbeddedMediaDriver>> EmbeddedMediaDriver::launch(const std::string &directory,
+                                                                         const EmbeddedDriverConfig &config)
+{
+#if defined(EPOCH_EMBEDDED_DRIVER)
+    std::unique_ptr<EmbeddedMediaDriver> driver(new EmbeddedMediaDriver());
+    auto &hooks = detail::driver_hooks();
+    Status status = driver_status(hooks.context_init(&driver->context_), "aeron_driver_context_init failed");
+    if (status.ok() && !directory.empty())
+    {
+        status = driver_status(hooks.context_set_dir(driver->context_, directory.c_str()),
+                               "aeron_driver_context_set_dir failed");
+    }
+    if (status.ok())
+    {
+        status = driver_status(hooks.context_set_threading_mode(driver->context_, to_aeron(config.threading_mode)),
+                               "aeron_driver_context_set_threading_mode failed");
+    }
+    if (status.ok() && config.term_buffer_length != 0)
+    {
+        status = driver_status(hooks.context_set_term_buffer_length(driver->context_, config.term_buffer_length),
+                               "aeron_driver_context_set_term_buffer_length failed");
+    }
+    if (status.ok() && config.ipc_term_buffer_length != 0)
+    {
+        status =
+            driver_status(hooks.context_set_ipc_term_buffer_length(driver->context_, config.ipc_term_buffer_length),
+                          "aeron_driver_context_set_ipc_term_buffer_length failed");
+    }
+    if (status.ok())
+    {
+        hooks.context_set_dir_delete_on_start(driver->context_, config.dir_delete_on_start);
+        hooks.context_set_dir_delete_on_shutdown(driver->context_, config.dir_delete_on_shutdown);
+        hooks.context_set_pre_touch_mapped_memory(driver->context_, config.pre_touch_mapped_memory);
+        status = driver_status(hooks.init(&driver->driver_, driver->context_), "aeron_driver_init failed");
+    }
+    if (status.ok())
+    {
+        status = driver_status(hooks.start(driver->driver_, false), "aeron_driver_start failed");
+    }
+    if (!status.ok())
+    {
+        driver->close();
+        return status;
+    }
+    const char *resolved = hooks.context_get_dir(driver->context_);
+    driver->directory_ = resolved != nullptr ? resolved : directory;
+    return Result<std::unique_ptr<EmbeddedMediaDriver>>(std::move(driver));
+#else
+    (void)directory;
+    (void)config;
+    return Status(ErrorCode::InvalidArgument, "embedded media driver not built (EPOCH_EMBEDDED_DRIVER=OFF)");
+#endif
+}
+
+const std::string &EmbeddedMediaDriver::directory() const
+{
+    return directory_;
+}
+
+void EmbeddedMediaDriver::close()
+{
+#if defined(EPOCH_EMBEDDED_DRIVER)
+    if (driver_ != nullptr)
+    {
+        detail::driver_hooks().close(driver_);
+        driver_ = nullptr;
+    }
+    if (context_ != nullptr)
+    {
+        detail::driver_hooks().context_close(context_);
+        context_ = nullptr;
+    }
+#endif
+}
+
+} // namespace epoch
@@ -0,0 +1,476 @@
+#include "epoch/numa.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <new>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+namespace epoch {
+
+namespace {
+
+std::size_t page_size()
+{
+#if defined(_WIN32)
+    static const auto size = [] {
+        SYSTEM_INFO info{};
+        ::GetSystemInfo(&info);
+        return static_cast<std::size_t>(info.dwPageSize);
+    }();
+#else
+    static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+    return size;
+}
+
+void *map_anonymous(std::size_t length)
+{
+#if defined(_WIN32)
+    return ::VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    void *mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return mapping == MAP_FAILED ? nullptr : mapping;
+#endif
+}
+
+void unmap_anonymous(void *mapping, std::size_t length)
+{
+#if defined(_WIN32)
+    (void)length;
+    ::VirtualFree(mapping, 0, MEM_RELEASE);
+#else
+    ::munmap(mapping, length);
+#endif
+}
+
+#if defined(__linux__)
+// linux/mempolicy.h; spelled out so the build does not need libnuma headers.
+constexpr int kMpolPreferred = 1;
+constexpr std::size_t kMaskBits = 8 * sizeof(unsigned long);
+
+std::vector<unsigned long> node_mask(std::int32_t node)
+{
+    std::vector<unsigned long> mask(static_cast<std::size_t>(node) / kMaskBits + 1, 0);
+    mask[static_cast<std::size_t>(node) / kMaskBits] = 1UL << (static_cast<std::size_t>(node) % kMaskBits);
+    return mask;
+}
+
+bool allowed_cpus(cpu_set_t &set)
+{
+    CPU_ZERO(&set);
+    return ::sched_getaffinity(0, sizeof(set), &set) == 0;
+}
+#endif
+
+} // namespace
+
+NumaTopology::NumaTopology(std::vector<NumaNode> nodes) : nodes_(std::move(nodes))
+{
+}
+
+NumaTopology NumaTopology::detect(const std::string &sysfs_root)
+{
+#if !defined(__linux__)
+    (void)sysfs_root;
+    return single_node(static_cast<std::int32_t>(std::max(1U, std::thread::hardware_concurrency())));
+#else
+    cpu_set_t allowed;
+    bool restricted = allowed_cpus(allowed);
+    std::vector<NumaNode> nodes;
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(sysfs_root, error), end; !error && it != end; it.increment(error))
+    {
+        auto name = it->path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0)
+        {
+            continue;
+        }
+        NumaNode node;
+        auto parsed = std::from_chars(name.data() + 4, name.data() + name.size(), node.id);
+        if (parsed.ec != std::errc() || parsed.ptr != name.data() + name.size())
+        {
+            continue;
+        }
+        std::ifstream file(it->path() / "cpulist");
+        std::string text;
+        if (!std::getline(file, text))
+        {
+            continue;
+        }
+        auto cpus = parse_cpu_list(text);
+        if (!cpus.ok())
+        {
+            continue;
+        }
+        for (auto cpu : cpus.value())
+        {
+            if (!restricted || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)))
+            {
+                node.cpus.push_back(cpu);
+            }
+        }
+        if (!node.cpus.empty())
+        {
+            nodes.push_back(std::move(node));
+        }
+    }
+    if (nodes.empty())
+    {
+        NumaNode node;
+        for (std::int32_t cpu = 0; restricted && cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &allowed))
+            {
+                node.cpus.push_back(cpu);
+            }
+        }
+        if (node.cpus.empty())
+        {
+            return single_node(static_cast<std::int32_t>(std::max(1U, std::thread::hardware_concurrency())));
+        }
+        nodes.push_back(std::move(node));
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const NumaNode &a, const NumaNode &b) { return a.id < b.id; });
+    return NumaTopology(std::move(nodes));
+#endif
+}
+
+NumaTopology NumaTopology::single_node(std::int32_t cpu_count)
+{
+    NumaNode node;
+    for (std::int32_t cpu = 0; cpu < cpu_count; ++cpu)
+    {
+        node.cpus.push_back(cpu);
+    }
+    return NumaTopology({std::move(node)});
+}
+
+const std::vector<NumaNode> &NumaTopology::nodes() const
+{
+    return nodes_;
+}
+
+std::size_t NumaTopology::cpu_count() const
+{
+    std::size_t count = 0;
+    for (const auto &node : nodes_)
+    {
+        count += node.cpus.size();
+    }
+    return count;
+}
+
+std::int32_t NumaTopology::node_of_cpu(std::int32_t cpu) const
+{
+    for (const auto &node : nodes_)
+    {
+        if (std::find(node.cpus.begin(), node.cpus.end(), cpu) != node.cpus.end())
+        {
+            return node.id;
+        }
+    }
+    return -1;
+}
+
+Result<std::vector<std::int32_t>> parse_cpu_list(std::string_view text)
+{
+    while (!text.empty() && (text.back() == '\n' || text.back() == ' '))
+    {
+        text.remove_suffix(1);
+    }
+    std::vector<std::int32_t> cpus;
+    const char *at = text.data();
+    const char *end = text.data() + text.size();
+    while (at < end)
+    {
+        std::int32_t first = 0;
+        auto parsed = std::from_chars(at, end, first);
+        if (parsed.ec != std::errc() || first < 0)
+        {
+            return Status(ErrorCode::InvalidArgument, "malformed cpu list");
+        }
+        std::int32_t last = first;
+        at = parsed.ptr;
+        if (at < end && *at == '-')
+        {
+            parsed = std::from_chars(at + 1, end, last);
+            if (parsed.ec != std::errc() || last < first)
+            {
+                return Status(ErrorCode::InvalidArgument, "malformed cpu range");
+            }
+            at = parsed.ptr;
+        }
+        for (std::int32_t cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+        if (at < end && *at++ != ',')
+        {
+            return Status(ErrorCode::InvalidArgument, "malformed cpu list");
+        }
+    }
+    return Result<std::vector<std::int32_t>>(std::move(cpus));
+}
+
+Status pin_current_thread(std::int32_t cpu)
+{
+    return pin_current_thread(std::vector<std::int32_t>{cpu});
+}
+
+Status pin_current_thread(const std::vector<std::int32_t> &cpus)
+{
+#if !defined(__linux__)
+    (void)cpus;
+    return Status(ErrorCode::Unsupported, "thread affinity is not supported on this platform");
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : cpus)
+    {
+        if (cpu < 0 || cpu >= CPU_SETSIZE)
+        {
+            return Status(ErrorCode::InvalidArgument, "cpu out of range");
+        }
+        CPU_SET(cpu, &set);
+    }
+    int rc = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+    if (rc != 0)
+    {
+        return Status(ErrorCode::InvalidArgument, "pthread_setaffinity_np failed", std::strerror(rc));
+    }
+    return Status::success();
+#endif
+}
+
+Status prefer_node_memory(std::int32_t node)
+{
+    if (node < 0)
+    {
+        return Status(ErrorCode::InvalidArgument, "negative numa node");
+    }
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    auto mask = node_mask(node);
+    if (::syscall(SYS_set_mempolicy, kMpolPreferred, mask.data(), mask.size() * kMaskBits + 1) != 0)
+    {
+        return Status(ErrorCode::InvalidArgument, "set_mempolicy failed", std::strerror(errno));
+    }
+    return Status::success();
+#else
+    return Status(ErrorCode::Unsupported, "set_mempolicy unavailable");
+#endif
+}
+
+Status bind_memory(void *address, std::size_t length, std::int32_t node)
+{
+    if (node < 0 || reinterpret_cast<std::uintptr_t>(address) % page_size() != 0)
+    {
+        return Status(ErrorCode::InvalidArgument, "mbind needs a node and a page-aligned range");
+    }
+#if defined(__linux__) && defined(SYS_mbind)
+    auto mask = node_mask(node);
+    if (::syscall(SYS_mbind, address, length, kMpolPreferred, mask.data(), mask.size() * kMaskBits + 1, 0U) != 0)
+    {
+        return Status(ErrorCode::InvalidArgument, "mbind failed", std::strerror(errno));
+    }
+    return Status::success();
+#else
+    (void)length;
+    return Status(ErrorCode::Unsupported, "mbind unavailable");
+#endif
+}
+
+void touch_pages(void *address, std::size_t length)
+{
+    auto *bytes = static_cast<volatile std::uint8_t *>(address);
+    for (std::size_t offset = 0; offset < length; offset += page_size())
+    {
+        bytes[offset] = 0;
+    }
+}
+
+NodeMemoryResource::NodeMemoryResource(std::int32_t node) : node_(node)
+{
+}
+
+std::int32_t NodeMemoryResource::node() const
+{
+    return node_;
+}
+
+const NodeMemoryStats &NodeMemoryResource::stats() const
+{
+    return stats_;
+}
+
+void *NodeMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    std::size_t page = page_size();
+    if (alignment > page)
+    {
+        EPOCH_THROW(std::bad_alloc());
+    }
+    std::size_t length = (std::max<std::size_t>(bytes, 1) + page - 1) / page * page;
+    void *mapping = map_anonymous(length);
+    if (mapping == nullptr)
+    {
+        EPOCH_THROW(std::bad_alloc());
+    }
+    if (!bind_memory(mapping, length, node_).ok())
+    {
+        stats_.unbound++;
+    }
+    touch_pages(mapping, length);
+    stats_.allocations++;
+    stats_.bytes += static_cast<std::int64_t>(length);
+    return mapping;
+}
+
+void NodeMemoryResource::do_deallocate(void *pointer, std::size_t bytes, std::size_t)
+{
+    std::size_t page = page_size();
+    std::size_t length = (std::max<std::size_t>(bytes, 1) + page - 1) / page * page;
+    unmap_anonymous(pointer, length);
+    stats_.allocations--;
+    stats_.bytes -= static_cast<std::int64_t>(length);
+}
+
+bool NodeMemoryResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+ActorPlacement place_actors(const std::vector<ActorIdParts> &actors,
+                            const NumaTopology &topology,
+                            std::size_t workers_per_node)
+{
+    ActorPlacement placement;
+    placement.worker_of.assign(actors.size(), 0);
+    const auto &nodes = topology.nodes();
+    if (nodes.empty())
+    {
+        return placement;
+    }
+
+    // Workers of node n are [first_worker[n], first_worker[n] + worker_count[n]).
+    std::vector<std::size_t> first_worker;
+    std::vector<std::size_t> worker_count;
+    for (const auto &node : nodes)
+    {
+        std::size_t count = node.cpus.empty() ? 0 : workers_per_node == 0 ? node.cpus.size() : workers_per_node;
+        first_worker.push_back(placement.workers.size());
+        worker_count.push_back(count);
+        for (std::size_t w = 0; w < count; ++w)
+        {
+            WorkerPlacement worker;
+            worker.node = node.id;
+            worker.cpu = node.cpus[w % node.cpus.size()];
+            placement.workers.push_back(std::move(worker));
+        }
+    }
+
+    std::map<std::pair<std::uint16_t, std::uint16_t>, std::vector<std::size_t>> by_server;
+    for (std::size_t i = 0; i < actors.size(); ++i)
+    {
+        by_server[{actors[i].region, actors[i].server}].push_back(i);
+    }
+    std::vector<const std::vector<std::size_t> *> groups;
+    for (const auto &entry : by_server)
+    {
+        groups.push_back(&entry.second);
+    }
+    // Largest first; stable keeps equal sizes in (region, server) order.
+    std::stable_sort(groups.begin(), groups.end(), [](const auto *a, const auto *b) { return a->size() > b->size(); });
+
+    if (placement.workers.empty())
+    {
+        return placement;
+    }
+    std::vector<std::size_t> load(nodes.size(), 0);
+    std::vector<std::size_t> cursor(nodes.size(), 0);
+    for (const auto *group : groups)
+    {
+        std::size_t target = nodes.size();
+        for (std::size_t n = 0; n < nodes.size(); ++n)
+        {
+            // load[n] / worker_count[n] < load[target] / worker_count[target], without division.
+            if (worker_count[n] != 0 &&
+                (target == nodes.size() || load[n] * worker_count[target] < load[target] * worker_count[n]))
+            {
+                target = n;
+            }
+        }
+        for (auto actor : *group)
+        {
+            std::size_t worker = first_worker[target] + cursor[target]++ % worker_count[target];
+            placement.workers[worker].actors.push_back(actor);
+            placement.worker_of[actor] = worker;
+        }
+        load[target] += group->size();
+    }
+    return placement;
+}
+
+PinnedWorkers::~PinnedWorkers()
+{
+    join();
+}
+
+void PinnedWorkers::start(const std::vector<WorkerPlacement> &workers, Body body)
+{
+    join();
+    workers_ = workers;
+    placement_.assign(workers_.size(), Status::success());
+    for (std::size_t w = 0; w < workers_.size(); ++w)
+    {
+        threads_.emplace_back([this, w, body] {
+            const auto &worker = workers_[w];
+            Status pinned = worker.cpu >= 0 ? pin_current_thread(worker.cpu) : Status::success();
+            Status preferred = prefer_node_memory(worker.node);
+            placement_[w] = !pinned.ok() ? pinned : preferred;
+            body(w, worker);
+        });
+    }
+}
+
+void PinnedWorkers::join()
+{
+    for (auto &thread : threads_)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+    threads_.clear();
+}
+
+std::size_t PinnedWorkers::placement_failures() const
+{
+    return static_cast<std::size_t>(
+        std::count_if(placement_.begin(), placement_.end(), [](const Status &status) { return !status.ok(); }));
+}
+
+} // namespace epoch
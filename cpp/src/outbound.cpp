@@ -0,0 +1,134 @@
+#include "epoch/outbound.h"
+
+#include <algorithm>
+
+namespace epoch {
+
+OutboundBuffer::OutboundBuffer(Transport &destination, OutboundConfig config)
+    : destination_(destination), config_(config), credits_(config.credits_per_epoch)
+{
+}
+
+bool OutboundBuffer::enqueue(const Message &message)
+{
+    auto band = static_cast<std::size_t>(qos_band(message.qos));
+    if (queued_ >= config_.capacity)
+    {
+        if (config_.policy != BackPressurePolicy::ShedLowQos || sheddable(message))
+        {
+            stats_.rejected++;
+            return false;
+        }
+        for (std::size_t victim = kQosBandCount; victim-- > 0;)
+        {
+            if (!lanes_[victim].empty() && sheddable(lanes_[victim].back()))
+            {
+                lanes_[victim].pop_back();
+                queued_--;
+                stats_.shed++;
+                break;
+            }
+        }
+        if (queued_ >= config_.capacity)
+        {
+            stats_.rejected++;
+            return false;
+        }
+    }
+    lanes_[band].push_back(message);
+    queued_++;
+    stats_.enqueued++;
+    return true;
+}
+
+std::size_t OutboundBuffer::flush()
+{
+    std::size_t sent = 0;
+    for (auto &lane : lanes_)
+    {
+        while (!lane.empty())
+        {
+            if (credits_ == 0)
+            {
+                stats_.credit_stalls++;
+                return sent;
+            }
+            SendResult result = destination_.try_send(lane.front());
+            if (result == SendResult::Sent)
+            {
+                lane.pop_front();
+                queued_--;
+                credits_--;
+                sent++;
+                stats_.sent++;
+                continue;
+            }
+            if (is_retryable(result))
+            {
+                stats_.back_pressured++;
+                if (config_.policy == BackPressurePolicy::ShedLowQos)
+                {
+                    shed_low_qos();
+                }
+                return sent;
+            }
+            lane.pop_front();
+            queued_--;
+            stats_.failed++;
+        }
+    }
+    return sent;
+}
+
+void OutboundBuffer::begin_epoch()
+{
+    stats_.deferred += static_cast<std::int64_t>(queued_);
+    credits_ = config_.credits_per_epoch;
+}
+
+void OutboundBuffer::grant(std::size_t credits)
+{
+    credits_ += credits;
+}
+
+std::size_t OutboundBuffer::queued() const
+{
+    return queued_;
+}
+
+std::size_t OutboundBuffer::credits() const
+{
+    return credits_;
+}
+
+const OutboundConfig &OutboundBuffer::config() const
+{
+    return config_;
+}
+
+const OutboundStats &OutboundBuffer::stats() const
+{
+    return stats_;
+}
+
+bool OutboundBuffer::sheddable(const Message &message) const
+{
+    return message.qos < config_.shed_below_qos;
+}
+
+std::size_t OutboundBuffer::shed_low_qos()
+{
+    std::size_t dropped = 0;
+    for (auto &lane : lanes_)
+    {
+        auto kept =
+            std::remove_if(lane.begin(), lane.end(), [&](const Message &message) { return sheddable(message); });
+        dropped += static_cast<std::size_t>(lane.end() - kept);
+        lane.erase(kept, lane.end());
+    }
+    queued_ -= dropped;
+    stats_.shed += static_cast<std::int64_t>(dropped);
+    return dropped;
+}
+
+} // namespace epoch
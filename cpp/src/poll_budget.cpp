@@ -0,0 +1,80 @@
+#include "epoch/poll_budget.h"
+
+#include <algorithm>
+
+namespace epoch {
+
+PollBudget::PollBudget(PollBudgetConfig config, std::int32_t initial_fragments) : config_(config)
+{
+    config_.min_fragments = std::max(1, config_.min_fragments);
+    config_.max_fragments = std::max(config_.min_fragments, config_.max_fragments);
+    config_.fragment_bytes = std::max(1, config_.fragment_bytes);
+    limit_ = std::clamp<std::int64_t>(initial_fragments, config_.min_fragments, config_.max_fragments);
+}
+
+std::size_t PollBudget::next(std::int64_t lag_bytes, std::int64_t remaining_ns)
+{
+    lag_known_ = lag_bytes >= 0;
+    std::int64_t limit = limit_;
+    if (lag_known_)
+    {
+        limit = std::clamp<std::int64_t>((lag_bytes + config_.fragment_bytes - 1) / config_.fragment_bytes,
+                                         config_.min_fragments,
+                                         config_.max_fragments);
+        stats_.lag_sized++;
+    }
+    if (remaining_ns >= 0 && stats_.ns_per_fragment > 0)
+    {
+        auto affordable = static_cast<std::int64_t>(static_cast<double>(remaining_ns) * config_.deadline_share) /
+                          stats_.ns_per_fragment;
+        if (affordable < limit)
+        {
+            limit = std::max<std::int64_t>(1, affordable);
+            stats_.deadline_capped++;
+        }
+    }
+    stats_.last_limit = limit;
+    stats_.last_lag_bytes = lag_bytes;
+    return static_cast<std::size_t>(limit);
+}
+
+void PollBudget::observe(std::size_t fragments, std::int64_t elapsed_ns)
+{
+    auto count = static_cast<std::int64_t>(fragments);
+    stats_.polls++;
+    if (count == 0)
+    {
+        stats_.empty_polls++;
+    }
+    if (count >= stats_.last_limit)
+    {
+        stats_.full_polls++;
+        if (!lag_known_ && limit_ < config_.max_fragments)
+        {
+            limit_ = std::min<std::int64_t>(limit_ * 2, config_.max_fragments);
+            stats_.grown++;
+        }
+    }
+    else if (!lag_known_ && count * 4 < stats_.last_limit && limit_ > config_.min_fragments)
+    {
+        limit_ = std::max<std::int64_t>(limit_ / 2, config_.min_fragments);
+        stats_.shrunk++;
+    }
+    if (count > 0)
+    {
+        std::int64_t sample = std::max<std::int64_t>(1, elapsed_ns / count);
+        stats_.ns_per_fragment = stats_.ns_per_fragment == 0 ? sample : (stats_.ns_per_fragment * 7 + sample) / 8;
+    }
+}
+
+const PollBudgetConfig &PollBudget::config() const
+{
+    return config_;
+}
+
+const PollBudgetStats &PollBudget::stats() const
+{
+    return stats_;
+}
+
+} // namespace epoch
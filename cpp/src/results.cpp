@@ -0,0 +1,240 @@
+#include "epoch/results.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace epoch {
+
+namespace {
+
+void encode_header(std::uint8_t *header)
+{
+    std::memset(header, 0, kResultsHeaderLength);
+    std::memcpy(header, kResultsMagic, sizeof(kResultsMagic));
+    std::memcpy(header + 4, &kResultsVersion, sizeof(kResultsVersion));
+}
+
+// fseek/ftell take a long, which is 32 bits on Windows; a results file passes 2 GiB at ~67M records.
+int seek_file(std::FILE *file, std::int64_t offset, int origin)
+{
+#if defined(_WIN32)
+    return ::_fseeki64(file, offset, origin);
+#else
+    return ::fseeko(file, static_cast<off_t>(offset), origin);
+#endif
+}
+
+std::int64_t tell_file(std::FILE *file)
+{
+#if defined(_WIN32)
+    return ::_ftelli64(file);
+#else
+    return static_cast<std::int64_t>(::ftello(file));
+#endif
+}
+
+} // namespace
+
+CallbackSink::CallbackSink(ResultHandler handler, void *clientd) : handler_(handler), clientd_(clientd)
+{
+}
+
+void CallbackSink::write(const EpochRecord &record)
+{
+    handler_(clientd_, record);
+}
+
+RingSink::RingSink(std::size_t capacity)
+{
+    if (capacity == 0)
+    {
+        EPOCH_THROW(std::invalid_argument("ring sink capacity must be positive"));
+    }
+    records_.resize(capacity);
+}
+
+void RingSink::write(const EpochRecord &record)
+{
+    records_[static_cast<std::size_t>(total_) % records_.size()] = record;
+    total_++;
+}
+
+std::size_t RingSink::size() const
+{
+    return std::min(records_.size(), static_cast<std::size_t>(total_));
+}
+
+std::size_t RingSink::capacity() const
+{
+    return records_.size();
+}
+
+const EpochRecord &RingSink::at(std::size_t index) const
+{
+    std::size_t first = static_cast<std::size_t>(total_) - size();
+    return records_[(first + index) % records_.size()];
+}
+
+std::int64_t RingSink::total() const
+{
+    return total_;
+}
+
+FileSink::~FileSink()
+{
+    if (file_ != nullptr)
+    {
+        flush();
+        std::fclose(file_);
+    }
+}
+
+Result<std::unique_ptr<FileSink>> FileSink::open(const std::string &path, std::size_t buffer_size)
+{
+    std::unique_ptr<FileSink> sink(new FileSink());
+    sink->file_ = std::fopen(path.c_str(), "wb");
+    if (sink->file_ == nullptr)
+    {
+        return Status(ErrorCode::IoFailed, "results file open failed");
+    }
+    std::uint8_t header[kResultsHeaderLength];
+    encode_header(header);
+    if (std::fwrite(header, 1, sizeof(header), sink->file_) != sizeof(header))
+    {
+        return Status(ErrorCode::IoFailed, "results header write failed");
+    }
+    sink->buffer_.resize(std::max(buffer_size, kResultRecordLength) / kResultRecordLength * kResultRecordLength);
+    return Result<std::unique_ptr<FileSink>>(std::move(sink));
+}
+
+void FileSink::write(const EpochRecord &record)
+{
+    if (!status_.ok())
+    {
+        return;
+    }
+    if (used_ == buffer_.size() && !flush().ok())
+    {
+        // The buffer is still full; the record is dropped and status() reports the failure.
+        return;
+    }
+    encode_result(buffer_.data() + used_, record);
+    used_ += kResultRecordLength;
+    written_++;
+}
+
+Status FileSink::flush()
+{
+    if (!status_.ok())
+    {
+        return status_;
+    }
+    if (used_ > 0 && std::fwrite(buffer_.data(), 1, used_, file_) != used_)
+    {
+        status_ = Status(ErrorCode::IoFailed, "results file write failed");
+        return status_;
+    }
+    used_ = 0;
+    if (std::fflush(file_) != 0)
+    {
+        status_ = Status(ErrorCode::IoFailed, "results file flush failed");
+    }
+    return status_;
+}
+
+Status FileSink::status() const
+{
+    return status_;
+}
+
+std::int64_t FileSink::written() const
+{
+    return written_;
+}
+
+ResultFileReader::~ResultFileReader()
+{
+    if (file_ != nullptr)
+    {
+        std::fclose(file_);
+    }
+}
+
+Result<std::unique_ptr<ResultFileReader>> ResultFileReader::open(const std::string &path)
+{
+    std::unique_ptr<ResultFileReader> reader(new ResultFileReader());
+    reader->file_ = std::fopen(path.c_str(), "rb");
+    if (reader->file_ == nullptr)
+    {
+        return Status(ErrorCode::IoFailed, "results file open failed");
+    }
+    std::uint8_t header[kResultsHeaderLength];
+    std::uint32_t version = 0;
+    if (std::fread(header, 1, sizeof(header), reader->file_) != sizeof(header) ||
+        std::memcmp(header, kResultsMagic, sizeof(kResultsMagic)) != 0)
+    {
+        return Status(ErrorCode::InvalidArgument, "not a results file");
+    }
+    std::memcpy(&version, header + 4, sizeof(version));
+    if (version != kResultsVersion)
+    {
+        return Status(ErrorCode::InvalidArgument, "unsupported results file version");
+    }
+    if (seek_file(reader->file_, 0, SEEK_END) != 0)
+    {
+        return Status(ErrorCode::IoFailed, "results file seek failed");
+    }
+    std::int64_t size = tell_file(reader->file_);
+    if (size < static_cast<std::int64_t>(kResultsHeaderLength))
+    {
+        return Status(ErrorCode::IoFailed, "results file size unknown");
+    }
+    // A torn trailing record is ignored.
+    reader->count_ = (static_cast<std::size_t>(size) - kResultsHeaderLength) / kResultRecordLength;
+    return Result<std::unique_ptr<ResultFileReader>>(std::move(reader));
+}
+
+std::size_t ResultFileReader::count() const
+{
+    return count_;
+}
+
+bool ResultFileReader::read(std::size_t index, EpochRecord &record)
+{
+    if (index >= count_)
+    {
+        return false;
+    }
+    std::uint8_t buffer[kResultRecordLength];
+    auto offset = static_cast<std::int64_t>(kResultsHeaderLength + index * kResultRecordLength);
+    // In-order reads skip the seek, which would otherwise drop the stdio buffer on every record.
+    bool positioned = index == next_ || seek_file(file_, offset, SEEK_SET) == 0;
+    if (!positioned || std::fread(buffer, 1, sizeof(buffer), file_) != sizeof(buffer))
+    {
+        next_ = static_cast<std::size_t>(-1);
+        return false;
+    }
+    decode_result(buffer, record);
+    next_ = index + 1;
+    return true;
+}
+
+std::size_t process_messages(const Message *messages, std::size_t count, EpochArena &arena, ResultSink &sink)
+{
+    ArenaVector<Message> sorted(messages, messages + count, &arena);
+    ArenaVector<Message> scratch(&arena);
+    sort_messages(sorted.data(), sorted.data() + sorted.size(), scratch);
+    std::size_t epochs = 0;
+    auto write = sink_results(sink);
+    EpochEngine<> engine;
+    engine.fold(sorted.data(), sorted.data() + sorted.size(),
+                [&](std::int64_t epoch, std::int64_t state, std::uint64_t hash) {
+                    write(epoch, state, hash);
+                    epochs++;
+                });
+    return epochs;
+}
+
+} // namespace epoch
@@ -0,0 +1,134 @@
+#include "epoch/sequencer.h"
+#include "epoch/status.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace epoch {
+
+void LoserTree::reset(const std::vector<Run> &runs)
+{
+    runs_ = runs;
+    tree_.assign(std::max<std::size_t>(runs_.size(), 1), 0);
+    if (runs_.size() > 1)
+    {
+        tree_[0] = build(1);
+    }
+}
+
+// Node n < k is internal with children 2n and 2n + 1; node n >= k is the leaf for run n - k.
+std::size_t LoserTree::build(std::size_t node)
+{
+    if (node >= runs_.size())
+    {
+        return node - runs_.size();
+    }
+    std::size_t left = build(2 * node);
+    std::size_t right = build(2 * node + 1);
+    if (beats(left, right))
+    {
+        tree_[node] = right;
+        return left;
+    }
+    tree_[node] = left;
+    return right;
+}
+
+Sequencer::Sequencer(std::vector<Transport *> inputs, SequencerConfig config)
+    : inputs_(std::move(inputs)), config_(config), buffers_(inputs_.size()), runs_(inputs_.size())
+{
+    if (inputs_.empty())
+    {
+        EPOCH_THROW(std::invalid_argument("sequencer needs at least one input"));
+    }
+    for (const auto *input : inputs_)
+    {
+        if (input == nullptr)
+        {
+            EPOCH_THROW(std::invalid_argument("sequencer input is null"));
+        }
+    }
+    inbound_.reserve(config_.poll_batch);
+    ranges_.reserve(inputs_.size());
+}
+
+std::size_t Sequencer::pump()
+{
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < inputs_.size(); ++i)
+    {
+        inbound_.clear();
+        stats_.polled += static_cast<std::int64_t>(inputs_[i]->poll_into(inbound_, config_.poll_batch));
+        for (const auto &message : inbound_)
+        {
+            if (message.epoch <= last_sealed_epoch_)
+            {
+                stats_.late++;
+                continue;
+            }
+            buffers_[i].push_back(message);
+            total++;
+        }
+    }
+    return total;
+}
+
+std::size_t Sequencer::seal_into(std::int64_t epoch, std::vector<Message> &out)
+{
+    return seal(epoch, [&out](const Message &message) { out.push_back(message); });
+}
+
+void Sequencer::prepare(std::int64_t epoch)
+{
+    ranges_.clear();
+    for (std::size_t i = 0; i < buffers_.size(); ++i)
+    {
+        auto &buffer = buffers_[i];
+        auto &run = runs_[i];
+        run.clear();
+        std::size_t kept = 0;
+        for (const auto &message : buffer)
+        {
+            if (message.epoch <= epoch)
+            {
+                run.push_back(message);
+            }
+            else
+            {
+                buffer[kept++] = message;
+            }
+        }
+        buffer.resize(kept);
+        if (!std::is_sorted(run.begin(), run.end(), MessageOrder{}))
+        {
+            std::sort(run.begin(), run.end(), MessageOrder{});
+            stats_.sorted_runs++;
+        }
+        ranges_.push_back(LoserTree::Run{run.data(), run.data() + run.size()});
+    }
+    tree_.reset(ranges_);
+    last_sealed_epoch_ = std::max(last_sealed_epoch_, epoch);
+    stats_.sealed_epochs++;
+}
+
+std::size_t Sequencer::pending() const
+{
+    std::size_t total = 0;
+    for (const auto &buffer : buffers_)
+    {
+        total += buffer.size();
+    }
+    return total;
+}
+
+std::int64_t Sequencer::last_sealed_epoch() const
+{
+    return last_sealed_epoch_;
+}
+
+const SequencerStats &Sequencer::stats() const
+{
+    return stats_;
+}
+
+} // namespace epoch
@@ -0,0 +1,59 @@
+#include "epoch/status.h"
+
+namespace epoch {
+
+const char *error_code_name(ErrorCode code)
+{
+    switch (code)
+    {
+    case ErrorCode::Ok:
+        return "ok";
+    case ErrorCode::Closed:
+        return "closed";
+    case ErrorCode::BackPressured:
+        return "back pressured";
+    case ErrorCode::NotConnected:
+        return "not connected";
+    case ErrorCode::AdminAction:
+        return "admin action";
+    case ErrorCode::MaxPositionExceeded:
+        return "max position exceeded";
+    case ErrorCode::OfferFailed:
+        return "offer failed";
+    case ErrorCode::PollFailed:
+        return "poll failed";
+    case ErrorCode::ConnectFailed:
+        return "connect failed";
+    case ErrorCode::InvalidArgument:
+        return "invalid argument";
+    case ErrorCode::IoFailed:
+        return "io failed";
+    case ErrorCode::Unsupported:
+        return "unsupported";
+    }
+    return "unknown";
+}
+
+std::size_t Status::format(char *buffer, std::size_t length) const
+{
+    const char *head = context_ != nullptr ? context_ : error_code_name(code_);
+    int written = 0;
+    if (detail_ != nullptr && detail_[0] != '\0')
+    {
+        written = std::snprintf(buffer, length, "%s: %s", head, detail_);
+    }
+    else
+    {
+        written = std::snprintf(buffer, length, "%s", head);
+    }
+    return written < 0 ? 0 : static_cast<std::size_t>(written);
+}
+
+std::string Status::message() const
+{
+    std::string out(format(nullptr, 0), '\0');
+    format(out.data(), out.size() + 1);
+    return out;
+}
+
+} // namespace epoch
@@ -0,0 +1,209 @@
+#include "epoch/tick.h"
+#include "epoch/status.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace epoch {
+
+namespace {
+
+void cpu_relax()
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+std::size_t jitter_bucket(std::int64_t jitter_ns)
+{
+    std::size_t bucket = 0;
+    auto value = static_cast<std::uint64_t>(jitter_ns < 0 ? 0 : jitter_ns);
+    while (value > 0 && bucket + 1 < TickStats::kJitterBuckets)
+    {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+} // namespace
+
+SteadyEpochClock::SteadyEpochClock(std::int64_t spin_threshold_ns) : spin_threshold_ns_(spin_threshold_ns)
+{
+    if (spin_threshold_ns_ < 0)
+    {
+        spin_threshold_ns_ = 0;
+    }
+}
+
+std::int64_t SteadyEpochClock::now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void SteadyEpochClock::sleep_until(std::int64_t deadline_ns)
+{
+    while (true)
+    {
+        std::int64_t remaining = deadline_ns - now_ns();
+        if (remaining <= 0)
+        {
+            return;
+        }
+        if (remaining > spin_threshold_ns_)
+        {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(remaining - spin_threshold_ns_));
+        }
+        else
+        {
+            cpu_relax();
+        }
+    }
+}
+
+VirtualEpochClock::VirtualEpochClock(std::int64_t start_ns) : now_ns_(start_ns)
+{
+}
+
+std::int64_t VirtualEpochClock::now_ns()
+{
+    return now_ns_;
+}
+
+void VirtualEpochClock::sleep_until(std::int64_t deadline_ns)
+{
+    if (deadline_ns > now_ns_)
+    {
+        now_ns_ = deadline_ns;
+    }
+}
+
+void VirtualEpochClock::advance(std::int64_t delta_ns)
+{
+    if (delta_ns > 0)
+    {
+        now_ns_ += delta_ns;
+    }
+}
+
+std::int64_t TickStats::jitter_percentile_ns(double percentile) const
+{
+    if (ticks == 0)
+    {
+        return 0;
+    }
+    auto target = static_cast<std::int64_t>(percentile * static_cast<double>(ticks));
+    std::int64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < kJitterBuckets; ++bucket)
+    {
+        seen += jitter_histogram[bucket];
+        if (seen > target || seen == ticks)
+        {
+            return bucket == 0 ? 0 : (std::int64_t{1} << bucket) - 1;
+        }
+    }
+    return max_jitter_ns;
+}
+
+TickDriver::TickDriver(TickConfig config, EpochClock &clock)
+    : config_(config), clock_(clock), epoch_(config.start_epoch), deadline_ns_(clock.now_ns())
+{
+    if (config_.period_ns <= 0)
+    {
+        EPOCH_THROW(std::invalid_argument("tick period must be positive"));
+    }
+    if (config_.max_catch_up < 0)
+    {
+        config_.max_catch_up = 0;
+    }
+}
+
+void TickDriver::reset(std::int64_t first_deadline_ns)
+{
+    deadline_ns_ = first_deadline_ns;
+}
+
+void TickDriver::stop()
+{
+    stop_.store(true, std::memory_order_relaxed);
+}
+
+std::int64_t TickDriver::epoch() const
+{
+    return epoch_;
+}
+
+std::int64_t TickDriver::deadline_ns() const
+{
+    return deadline_ns_;
+}
+
+const TickConfig &TickDriver::config() const
+{
+    return config_;
+}
+
+const TickStats &TickDriver::stats() const
+{
+    return stats_;
+}
+
+std::int64_t TickDriver::begin_tick()
+{
+    std::int64_t now = clock_.now_ns();
+    std::int64_t jitter = now - deadline_ns_;
+    stats_.last_jitter_ns = jitter;
+    stats_.total_jitter_ns += jitter;
+    if (jitter > stats_.max_jitter_ns)
+    {
+        stats_.max_jitter_ns = jitter;
+    }
+    stats_.jitter_histogram[jitter_bucket(jitter)]++;
+    return now;
+}
+
+void TickDriver::end_tick(std::int64_t started_ns)
+{
+    std::int64_t now = clock_.now_ns();
+    std::int64_t busy = now - started_ns;
+    if (busy > stats_.max_busy_ns)
+    {
+        stats_.max_busy_ns = busy;
+    }
+    stats_.ticks++;
+
+    epoch_++;
+    deadline_ns_ += config_.period_ns;
+    if (now <= deadline_ns_)
+    {
+        return;
+    }
+
+    stats_.overruns++;
+    std::int64_t missed = (now - deadline_ns_) / config_.period_ns;
+    if (config_.overrun_policy == OverrunPolicy::Skip)
+    {
+        epoch_ += missed;
+        deadline_ns_ += missed * config_.period_ns;
+        stats_.skipped_epochs += missed;
+    }
+    else if (missed > config_.max_catch_up)
+    {
+        deadline_ns_ += missed * config_.period_ns;
+        stats_.catch_up_resets++;
+    }
+}
+
+} // namespace epoch
@@ -0,0 +1,215 @@
+#include "epoch/trace.h"
+
+#include "epoch/broadcast.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+namespace epoch {
+
+namespace {
+
+struct TraceBuffer {
+    explicit TraceBuffer(std::uint32_t index) : ring(kTraceRingCapacity), index(index)
+    {
+    }
+
+    BroadcastRing<TraceEvent> ring;
+    std::uint32_t index;
+    // Guarded by the registry mutex, like in_use.
+    std::string name;
+    bool in_use = true;
+};
+
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+};
+
+TraceRegistry &registry()
+{
+    static TraceRegistry instance;
+    return instance;
+}
+
+TraceBuffer *acquire_buffer()
+{
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto &buffer : reg.buffers)
+    {
+        if (!buffer->in_use)
+        {
+            buffer->in_use = true;
+            buffer->name.clear();
+            return buffer.get();
+        }
+    }
+    reg.buffers.push_back(std::make_unique<TraceBuffer>(static_cast<std::uint32_t>(reg.buffers.size())));
+    return reg.buffers.back().get();
+}
+
+// Returns the ring to the registry when its thread exits; the events stay readable.
+struct ThreadTrace {
+    ~ThreadTrace()
+    {
+        if (buffer != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            buffer->in_use = false;
+        }
+    }
+
+    TraceBuffer *buffer = nullptr;
+};
+
+thread_local ThreadTrace t_trace;
+
+TraceBuffer &thread_buffer()
+{
+    if (t_trace.buffer == nullptr)
+    {
+        t_trace.buffer = acquire_buffer();
+    }
+    return *t_trace.buffer;
+}
+
+std::string json_escape(const std::string &text)
+{
+    std::string escaped;
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped.push_back('\\');
+        }
+        if (static_cast<unsigned char>(c) >= 0x20)
+        {
+            escaped.push_back(c);
+        }
+    }
+    return escaped;
+}
+
+} // namespace
+
+const char *trace_phase_name(TracePhase phase)
+{
+    switch (phase)
+    {
+    case TracePhase::Poll:
+        return "poll";
+    case TracePhase::Drain:
+        return "drain";
+    case TracePhase::Sort:
+        return "sort";
+    case TracePhase::Fold:
+        return "fold";
+    case TracePhase::Hash:
+        return "hash";
+    case TracePhase::Emit:
+        return "emit";
+    }
+    return "unknown";
+}
+
+void trace_record(TracePhase phase,
+                  std::int64_t epoch,
+                  std::int64_t begin_ns,
+                  std::int64_t end_ns,
+                  std::uint32_t count)
+{
+    TraceBuffer &buffer = thread_buffer();
+    TraceEvent event;
+    event.epoch = epoch;
+    event.begin_ns = begin_ns;
+    event.end_ns = end_ns;
+    event.count = count;
+    event.thread = buffer.index;
+    event.phase = phase;
+    buffer.ring.publish(event);
+}
+
+void set_trace_thread_name(const std::string &name)
+{
+    TraceBuffer &buffer = thread_buffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name = name;
+}
+
+std::size_t snapshot_trace(std::vector<TraceEvent> &out)
+{
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::size_t copied = 0;
+    for (auto &buffer : reg.buffers)
+    {
+        auto reader = buffer->ring.reader_from_oldest();
+        // Bounded so a thread that keeps recording cannot hold the snapshot open.
+        copied += reader.receive(buffer->ring.capacity(), [&out](const TraceEvent &event) { out.push_back(event); });
+    }
+    return copied;
+}
+
+Status write_chrome_trace(const std::string &path)
+{
+    std::vector<TraceEvent> events;
+    snapshot_trace(events);
+    std::vector<std::pair<std::uint32_t, std::string>> threads;
+    {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto &buffer : reg.buffers)
+        {
+            threads.emplace_back(buffer->index, json_escape(buffer->name));
+        }
+    }
+
+    std::FILE *file = std::fopen(path.c_str(), "w");
+    if (file == nullptr)
+    {
+        return Status(ErrorCode::IoFailed, "trace file open failed");
+    }
+    // Timestamps are microseconds from the earliest retained event, which keeps them exact in a double.
+    std::int64_t origin = events.empty() ? 0 : events.front().begin_ns;
+    for (const auto &event : events)
+    {
+        origin = std::min(origin, event.begin_ns);
+    }
+    std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    const char *separator = "";
+    for (const auto &[index, name] : threads)
+    {
+        std::fprintf(file,
+                     "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                     separator,
+                     index,
+                     name.empty() ? "epoch" : name.c_str());
+        separator = ",";
+    }
+    for (const auto &event : events)
+    {
+        std::fprintf(file,
+                     "%s\n{\"name\":\"%s\",\"cat\":\"epoch\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                     "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"epoch\":%lld,\"count\":%u}}",
+                     separator,
+                     trace_phase_name(event.phase),
+                     event.thread,
+                     static_cast<double>(event.begin_ns - origin) / 1000.0,
+                     static_cast<double>(event.end_ns - event.begin_ns) / 1000.0,
+                     static_cast<long long>(event.epoch),
+                     event.count);
+        separator = ",";
+    }
+    std::fprintf(file, "\n]}\n");
+    bool failed = std::ferror(file) != 0;
+    if (std::fclose(file) != 0 || failed)
+    {
+        return Status(ErrorCode::IoFailed, "trace file write failed");
+    }
+    return Status::success();
+}
+
+} // namespace epoch
@@ -0,0 +1,419 @@
+#include "epoch/vector_file.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace epoch {
+
+namespace {
+
+constexpr std::size_t kMaxFields = 8;
+
+struct TextField {
+    const char *begin = nullptr;
+    const char *end = nullptr;
+};
+
+template <typename T>
+bool parse_field(const TextField &field, T &value, int base = 10)
+{
+    auto [ptr, ec] = std::from_chars(field.begin, field.end, value, base);
+    return ec == std::errc() && ptr == field.end;
+}
+
+// Splits [begin, end) on commas; false if the line has more than kMaxFields fields.
+bool split_line(const char *begin, const char *end, TextField *fields, std::size_t &count)
+{
+    count = 0;
+    const char *start = begin;
+    while (true)
+    {
+        const auto *comma = static_cast<const char *>(std::memchr(start, ',', static_cast<std::size_t>(end - start)));
+        if (count == kMaxFields)
+        {
+            return false;
+        }
+        fields[count++] = TextField{start, comma != nullptr ? comma : end};
+        if (comma == nullptr)
+        {
+            return true;
+        }
+        start = comma + 1;
+    }
+}
+
+bool parse_message(const TextField *fields, std::size_t count, Message &message)
+{
+    if (count != 7 && count != 8)
+    {
+        return false;
+    }
+    std::uint32_t qos = 0;
+    if (count == 8 && (!parse_field(fields[6], qos) || qos > std::numeric_limits<std::uint8_t>::max()))
+    {
+        return false;
+    }
+    message.qos = static_cast<std::uint8_t>(qos);
+    return parse_field(fields[1], message.epoch) && parse_field(fields[2], message.channel_id) &&
+           parse_field(fields[3], message.source_id) && parse_field(fields[4], message.source_seq) &&
+           parse_field(fields[5], message.schema_id) && parse_field(fields[count - 1], message.payload);
+}
+
+bool parse_expected(const TextField *fields, std::size_t count, EpochRecord &record)
+{
+    if (count != 4 || !parse_field(fields[1], record.epoch) || !parse_field(fields[2], record.state) ||
+        !parse_field(fields[3], record.hash, 16))
+    {
+        return false;
+    }
+    record.digest = state_digest(record.state);
+    return true;
+}
+
+Status write_all(std::FILE *file, const void *data, std::size_t length)
+{
+    if (length > 0 && std::fwrite(data, 1, length, file) != length)
+    {
+        return Status(ErrorCode::IoFailed, "vector file write failed");
+    }
+    return Status::success();
+}
+
+// Read-only view of the whole file. Too-short files are rejected here, before anything is mapped.
+Result<void *> map_file(const std::string &path, std::size_t &length)
+{
+#if defined(_WIN32)
+    HANDLE handle = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        return Status(ErrorCode::IoFailed, "vector file open failed");
+    }
+    LARGE_INTEGER size{};
+    if (!::GetFileSizeEx(handle, &size))
+    {
+        ::CloseHandle(handle);
+        return Status(ErrorCode::IoFailed, "vector file stat failed");
+    }
+    length = static_cast<std::size_t>(size.QuadPart);
+    if (length < kVectorHeaderLength)
+    {
+        ::CloseHandle(handle);
+        return Status(ErrorCode::InvalidArgument, "not a vector file");
+    }
+    // The view keeps the section alive; neither handle is needed once it exists.
+    HANDLE section = ::CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(handle);
+    if (section == nullptr)
+    {
+        return Status(ErrorCode::IoFailed, "vector file mmap failed");
+    }
+    void *mapping = ::MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(section);
+    if (mapping == nullptr)
+    {
+        return Status(ErrorCode::IoFailed, "vector file mmap failed");
+    }
+    return mapping;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return Status(ErrorCode::IoFailed, "vector file open failed");
+    }
+    struct stat info{};
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        return Status(ErrorCode::IoFailed, "vector file stat failed");
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    if (length < kVectorHeaderLength)
+    {
+        ::close(fd);
+        return Status(ErrorCode::InvalidArgument, "not a vector file");
+    }
+    void *mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        return Status(ErrorCode::IoFailed, "vector file mmap failed");
+    }
+    // Replays read front to back; let the kernel read ahead aggressively.
+    ::madvise(mapping, length, MADV_SEQUENTIAL);
+    return mapping;
+#endif
+}
+
+void unmap_file(void *mapping, std::size_t length)
+{
+#if defined(_WIN32)
+    (void)length;
+    ::UnmapViewOfFile(mapping);
+#else
+    ::munmap(mapping, length);
+#endif
+}
+
+} // namespace
+
+Status parse_text_vector(const char *data,
+                         std::size_t length,
+                         std::vector<Message> &messages,
+                         std::vector<EpochRecord> &expected,
+                         std::size_t *error_line)
+{
+    const char *cursor = data;
+    const char *end = data + length;
+    std::size_t line_number = 0;
+    TextField fields[kMaxFields];
+    while (cursor < end)
+    {
+        line_number++;
+        const auto *newline =
+            static_cast<const char *>(std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+        const char *line_end = newline != nullptr ? newline : end;
+        const char *next = newline != nullptr ? newline + 1 : end;
+        if (line_end > cursor && line_end[-1] == '\r')
+        {
+            line_end--;
+        }
+        if (line_end == cursor || *cursor == '#')
+        {
+            cursor = next;
+            continue;
+        }
+
+        std::size_t count = 0;
+        bool parsed = split_line(cursor, line_end, fields, count) && fields[0].end - fields[0].begin == 1;
+        if (parsed && *cursor == 'M')
+        {
+            Message message{};
+            parsed = parse_message(fields, count, message);
+            if (parsed)
+            {
+                messages.push_back(message);
+            }
+        }
+        else if (parsed && *cursor == 'E')
+        {
+            EpochRecord record{};
+            parsed = parse_expected(fields, count, record);
+            if (parsed)
+            {
+                expected.push_back(record);
+            }
+        }
+        else
+        {
+            parsed = false;
+        }
+        if (!parsed)
+        {
+            if (error_line != nullptr)
+            {
+                *error_line = line_number;
+            }
+            return Status(ErrorCode::InvalidArgument, "malformed vector line");
+        }
+        cursor = next;
+    }
+    return Status::success();
+}
+
+Status read_text_vector(const std::string &path,
+                        std::vector<Message> &messages,
+                        std::vector<EpochRecord> &expected,
+                        std::size_t *error_line)
+{
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+    {
+        return Status(ErrorCode::IoFailed, "vector file open failed");
+    }
+    std::vector<char> text;
+    char chunk[1 << 16];
+    std::size_t read = 0;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        text.insert(text.end(), chunk, chunk + read);
+    }
+    bool failed = std::ferror(file) != 0;
+    std::fclose(file);
+    if (failed)
+    {
+        return Status(ErrorCode::IoFailed, "vector file read failed");
+    }
+    return parse_text_vector(text.data(), text.size(), messages, expected, error_line);
+}
+
+Status write_vector_file(const std::string &path,
+                         const std::vector<Message> &messages,
+                         const std::vector<EpochRecord> &expected)
+{
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return Status(ErrorCode::IoFailed, "vector file open failed");
+    }
+    std::uint8_t header[kVectorHeaderLength] = {};
+    std::uint64_t message_count = messages.size();
+    std::uint64_t expected_count = expected.size();
+    std::memcpy(header, kVectorMagic, sizeof(kVectorMagic));
+    std::memcpy(header + 4, &kVectorVersion, sizeof(kVectorVersion));
+    std::memcpy(header + 8, &message_count, sizeof(message_count));
+    std::memcpy(header + 16, &expected_count, sizeof(expected_count));
+    Status status = write_all(file, header, sizeof(header));
+
+    std::vector<std::uint8_t> buffer(1024 * kFrameLength);
+    for (std::size_t first = 0; status.ok() && first < messages.size(); first += 1024)
+    {
+        std::size_t count = std::min<std::size_t>(1024, messages.size() - first);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            encode_frame(buffer.data() + i * kFrameLength, messages[first + i]);
+        }
+        status = write_all(file, buffer.data(), count * kFrameLength);
+    }
+    for (std::size_t i = 0; status.ok() && i < expected.size(); ++i)
+    {
+        std::uint8_t record[kResultRecordLength];
+        encode_result(record, expected[i]);
+        status = write_all(file, record, sizeof(record));
+    }
+    if (std::fclose(file) != 0 && status.ok())
+    {
+        status = Status(ErrorCode::IoFailed, "vector file close failed");
+    }
+    return status;
+}
+
+Status convert_text_vector(const std::string &text_path, const std::string &binary_path)
+{
+    std::vector<Message> messages;
+    std::vector<EpochRecord> expected;
+    Status status = read_text_vector(text_path, messages, expected);
+    if (!status.ok())
+    {
+        return status;
+    }
+    return write_vector_file(binary_path, messages, expected);
+}
+
+VectorFile::~VectorFile()
+{
+    if (mapping_ != nullptr)
+    {
+        unmap_file(mapping_, length_);
+    }
+}
+
+Result<std::unique_ptr<VectorFile>> VectorFile::open(const std::string &path, const PageConfig &pages)
+{
+    std::size_t length = 0;
+    auto mapped = map_file(path, length);
+    if (!mapped.ok())
+    {
+        return mapped.status();
+    }
+    void *mapping = mapped.value();
+    std::unique_ptr<VectorFile> file(new VectorFile());
+    file->mapping_ = mapping;
+    file->length_ = length;
+
+    const auto *base = static_cast<const std::uint8_t *>(mapping);
+    std::uint32_t version = 0;
+    std::uint64_t message_count = 0;
+    std::uint64_t expected_count = 0;
+    std::memcpy(&version, base + 4, sizeof(version));
+    std::memcpy(&message_count, base + 8, sizeof(message_count));
+    std::memcpy(&expected_count, base + 16, sizeof(expected_count));
+    if (std::memcmp(base, kVectorMagic, sizeof(kVectorMagic)) != 0)
+    {
+        return Status(ErrorCode::InvalidArgument, "not a vector file");
+    }
+    if (version != kVectorVersion)
+    {
+        return Status(ErrorCode::InvalidArgument, "unsupported vector file version");
+    }
+    std::size_t body = length - kVectorHeaderLength;
+    if (message_count > body / kFrameLength ||
+        expected_count > (body - message_count * kFrameLength) / kResultRecordLength)
+    {
+        return Status(ErrorCode::InvalidArgument, "vector file truncated");
+    }
+    Status prepared = prepare_file_mapping(mapping, length, pages);
+    if (!prepared.ok())
+    {
+        return prepared;
+    }
+    file->message_count_ = static_cast<std::size_t>(message_count);
+    file->expected_count_ = static_cast<std::size_t>(expected_count);
+    file->frames_ = base + kVectorHeaderLength;
+    file->expected_ = file->frames_ + file->message_count_ * kFrameLength;
+    return Result<std::unique_ptr<VectorFile>>(std::move(file));
+}
+
+std::size_t VectorFile::message_count() const
+{
+    return message_count_;
+}
+
+std::size_t VectorFile::expected_count() const
+{
+    return expected_count_;
+}
+
+const std::uint8_t *VectorFile::frames() const
+{
+    return frames_;
+}
+
+bool VectorFile::message(std::size_t index, Message &message) const
+{
+    return index < message_count_ && decode_frame(frames_ + index * kFrameLength, kFrameLength, message);
+}
+
+bool VectorFile::expected(std::size_t index, EpochRecord &record) const
+{
+    if (index >= expected_count_)
+    {
+        return false;
+    }
+    decode_result(expected_ + index * kResultRecordLength, record);
+    return true;
+}
+
+std::size_t VectorFile::decode_messages(std::size_t first, std::size_t count, Message *out) const
+{
+    std::size_t decoded = 0;
+    for (std::size_t index = first; index < message_count_ && decoded < count; ++index)
+    {
+        if (!decode_frame(frames_ + index * kFrameLength, kFrameLength, out[decoded]))
+        {
+            break;
+        }
+        decoded++;
+    }
+    return decoded;
+}
+
+} // namespace epoch
@@ -1,10 +1,13 @@
 #include "epoch/aeron_transport.h"
+#include "epoch/archive.h"
 #include "epoch/engine.h"
 
 #include <array>
 #include <cstdint>
 #include <cstring>
 #include <deque>
+#include <filesystem>
+#include <fstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -27,6 +30,19 @@ struct Frame {
     std::size_t length;
 };
 
+struct StubImage {
+    std::int32_t session_id;
+    std::int64_t position;
+    bool end_of_stream = false;
+};
+
+struct StubCounter {
+    std::int32_t id;
+    std::int32_t type_id;
+    std::int32_t session_id;
+    std::int32_t stream_id;
+};
+
 struct StubState {
     std::deque<Frame> frames;
     std::deque<std::int64_t> offer_results;
@@ -37,6 +53,16 @@ struct StubState {
     int async_pub_poll_calls = 0;
     int async_sub_poll_calls = 0;
     int context_set_dir_calls = 0;
+    std::string context_dir;
+    std::string publication_channel;
+    std::vector<StubImage> images;
+    std::vector<StubCounter> counters;
+    std::array<std::int64_t, 16> counter_values{};
+    int counter_scans = 0;
+    aeron_on_available_image_t on_available = nullptr;
+    void *available_clientd = nullptr;
+    aeron_on_unavailable_image_t on_unavailable = nullptr;
+    void *unavailable_clientd = nullptr;
 };
 
 StubState *g_state = nullptr;
@@ -62,11 +88,12 @@ int stub_context_init(aeron_context_t **context)
     return 0;
 }
 
-int stub_context_set_dir(aeron_context_t *, const char *)
+int stub_context_set_dir(aeron_context_t *, const char *dir)
 {
     if (g_state != nullptr)
     {
         g_state->context_set_dir_calls++;
+        g_state->context_dir = dir;
     }
     return 0;
 }
@@ -83,9 +110,13 @@ int stub_start(aeron_t *)
     return 0;
 }
 
-int stub_async_add_publication(aeron_async_add_publication_t **async, aeron_t *, const char *, int32_t)
+int stub_async_add_publication(aeron_async_add_publication_t **async, aeron_t *, const char *uri, int32_t)
 {
     static int dummy = 0;
+    if (g_state != nullptr)
+    {
+        g_state->publication_channel = uri;
+    }
     *async = reinterpret_cast<aeron_async_add_publication_t *>(&dummy);
     return 0;
 }
@@ -105,12 +136,19 @@ int stub_async_add_subscription(aeron_async_add_subscription_t **async,
                                 aeron_t *,
                                 const char *,
                                 int32_t,
-                                aeron_on_available_image_t,
-                                void *,
-                                aeron_on_unavailable_image_t,
-                                void *)
+                                aeron_on_available_image_t on_available,
+                                void *available_clientd,
+                                aeron_on_unavailable_image_t on_unavailable,
+                                void *unavailable_clientd)
 {
     static int dummy = 0;
+    if (g_state != nullptr)
+    {
+        g_state->on_available = on_available;
+        g_state->available_clientd = available_clientd;
+        g_state->on_unavailable = on_unavailable;
+        g_state->unavailable_clientd = unavailable_clientd;
+    }
     *async = reinterpret_cast<aeron_async_add_subscription_t *>(&dummy);
     return 0;
 }
@@ -174,6 +212,10 @@ int stub_subscription_poll(
         g_state->frames.pop_front();
         handler(clientd, frame.data.data(), frame.length, nullptr);
         fragments++;
+        if (!g_state->images.empty())
+        {
+            g_state->images.front().position += 96;
+        }
     }
     return static_cast<int>(fragments);
 }
@@ -219,6 +261,75 @@ const char *stub_errmsg()
     return "stub error";
 }
 
+int stub_subscription_image_count(aeron_subscription_t *)
+{
+    return g_state == nullptr ? 0 : static_cast<int>(g_state->images.size());
+}
+
+void stub_subscription_for_each_image(aeron_subscription_t *, void (*handler)(aeron_image_t *, void *), void *clientd)
+{
+    if (g_state == nullptr)
+    {
+        return;
+    }
+    for (auto &image : g_state->images)
+    {
+        handler(reinterpret_cast<aeron_image_t *>(&image), clientd);
+    }
+}
+
+int stub_image_constants(aeron_image_t *image, aeron_image_constants_t *constants)
+{
+    constants->session_id = reinterpret_cast<StubImage *>(image)->session_id;
+    constants->correlation_id = 40 + constants->session_id;
+    constants->source_identity = "127.0.0.1:40123";
+    return 0;
+}
+
+bool stub_image_is_end_of_stream(aeron_image_t *image)
+{
+    return reinterpret_cast<StubImage *>(image)->end_of_stream;
+}
+
+const char *stub_context_get_dir(aeron_context_t *)
+{
+    return g_state == nullptr ? nullptr : g_state->context_dir.c_str();
+}
+
+std::int64_t stub_image_position(aeron_image_t *image)
+{
+    return reinterpret_cast<StubImage *>(image)->position;
+}
+
+aeron_counters_reader_t *stub_counters_reader(aeron_t *)
+{
+    static int dummy = 0;
+    return reinterpret_cast<aeron_counters_reader_t *>(&dummy);
+}
+
+void stub_counters_reader_foreach_counter(aeron_counters_reader_t *,
+                                          aeron_counters_reader_foreach_counter_func_t func,
+                                          void *clientd)
+{
+    if (g_state == nullptr)
+    {
+        return;
+    }
+    g_state->counter_scans++;
+    for (const auto &counter : g_state->counters)
+    {
+        std::array<std::uint8_t, 20> key{};
+        std::memcpy(key.data() + 8, &counter.session_id, sizeof(counter.session_id));
+        std::memcpy(key.data() + 12, &counter.stream_id, sizeof(counter.stream_id));
+        func(0, counter.id, counter.type_id, key.data(), key.size(), "", 0, clientd);
+    }
+}
+
+std::int64_t *stub_counters_reader_addr(aeron_counters_reader_t *, std::int32_t id)
+{
+    return g_state == nullptr ? nullptr : &g_state->counter_values[static_cast<std::size_t>(id)];
+}
+
 epoch::detail::AeronHooks build_stub_hooks()
 {
     return epoch::detail::AeronHooks{
@@ -237,6 +348,15 @@ epoch::detail::AeronHooks build_stub_hooks()
         stub_close,
         stub_context_close,
         stub_errmsg,
+        stub_subscription_image_count,
+        stub_subscription_for_each_image,
+        stub_image_constants,
+        stub_image_position,
+        stub_counters_reader,
+        stub_counters_reader_foreach_counter,
+        stub_counters_reader_addr,
+        stub_image_is_end_of_stream,
+        stub_context_get_dir,
     };
 }
 
@@ -333,6 +453,21 @@ bool test_aeron_offer_failures()
         {
             ok = false;
         }
+
+        state.offer_results.push_back(AERON_PUBLICATION_BACK_PRESSURED);
+        state.offer_results.push_back(AERON_PUBLICATION_NOT_CONNECTED);
+        epoch::Message message{1, 1, 1, 2, 1, 1, 2};
+        if (transport.try_send(message) != epoch::SendResult::BackPressured ||
+            transport.try_send(message) != epoch::SendResult::NotConnected ||
+            transport.try_send(message) != epoch::SendResult::Sent || transport.stats().sent_count != 1)
+        {
+            ok = false;
+        }
+        transport.close();
+        if (transport.try_send(message) != epoch::SendResult::Closed)
+        {
+            ok = false;
+        }
     }
 
     epoch::test::aeron_hooks() = previous;
@@ -357,8 +492,409 @@ bool test_aeron_constructor_errors()
     {
     }
 
+    auto opened = epoch::AeronTransport::open(epoch::AeronConfig{"aeron:ipc", 40, "", 4, 2});
+    char buffer[16];
+    bool ok = !opened.ok() && opened.status().code() == epoch::ErrorCode::ConnectFailed &&
+              opened.status().message().rfind("aeron_context_init failed", 0) == 0 &&
+              opened.status().format(buffer, sizeof(buffer)) >= sizeof(buffer) &&
+              std::string(buffer) == "aeron_context_i";
+
     epoch::test::aeron_hooks() = previous;
-    return true;
+    return ok;
+}
+
+bool test_aeron_status_api()
+{
+    StubState state;
+    g_state = &state;
+    auto previous = epoch::test::aeron_hooks();
+    epoch::test::aeron_hooks() = build_stub_hooks();
+
+    bool ok = true;
+    {
+        auto opened = epoch::AeronTransport::open(epoch::AeronConfig{"aeron:ipc", 50, "", 4, 2});
+        if (!opened.ok())
+        {
+            ok = false;
+        }
+        else
+        {
+            auto &transport = *opened.value();
+            state.offer_results.push_back(AERON_PUBLICATION_BACK_PRESSURED);
+            epoch::Message message{1, 1, 1, 1, 1, 1, 7};
+            if (transport.send_status(message).code() != epoch::ErrorCode::BackPressured ||
+                !transport.send_status(message).ok())
+            {
+                ok = false;
+            }
+            std::pmr::vector<epoch::Message> out;
+            auto polled = transport.try_poll(out, 4);
+            if (!polled.ok() || polled.value() != 1 || out[0].payload != 7)
+            {
+                ok = false;
+            }
+        }
+
+        epoch::LocalArchive archive;
+        epoch::AeronConfig config{"aeron:ipc", 51, "", 4, 2};
+        config.archive = &archive;
+        epoch::AeronTransport recorded(config);
+        recorded.send(epoch::Message{2, 1, 1, 1, 1, 1, 11});
+        recorded.send(epoch::Message{2, 1, 1, 2, 1, 1, 12});
+        epoch::ReplayTransport replay(archive);
+        auto replayed = recorded.poll(4).size() == 2 ? replay.poll(4) : std::vector<epoch::Message>{};
+        if (replayed.size() != 2 || replayed[1].payload != 12 || !replay.done())
+        {
+            ok = false;
+        }
+    }
+
+    epoch::test::aeron_hooks() = previous;
+    return ok;
+}
+
+bool test_aeron_embedded_driver()
+{
+    StubState state;
+    g_state = &state;
+    auto previous = epoch::test::aeron_hooks();
+    epoch::test::aeron_hooks() = build_stub_hooks();
+
+    epoch::AeronConfig config{"aeron:ipc", 60, "", 4, 2};
+    config.embedded_driver.enabled = true;
+    config.embedded_driver.threading_mode = epoch::DriverThreadingMode::Shared;
+    config.embedded_driver.dir_delete_on_start = true;
+    bool ok = !epoch::EmbeddedDriverConfig{}.dir_delete_on_start;
+#if defined(EPOCH_EMBEDDED_DRIVER)
+    static epoch::DriverThreadingMode seen_mode = epoch::DriverThreadingMode::Dedicated;
+    static bool driver_closed = false;
+    static bool delete_on_start = false;
+    auto previous_driver = epoch::test::driver_hooks();
+    auto &driver = epoch::test::driver_hooks();
+    driver.context_get_dir = [](aeron_driver_context_t *) { return "/tmp/epoch-embedded-driver"; };
+    driver.context_set_threading_mode = [](aeron_driver_context_t *, aeron_threading_mode_t mode) {
+        seen_mode = mode == AERON_THREADING_MODE_SHARED ? epoch::DriverThreadingMode::Shared
+                                                        : epoch::DriverThreadingMode::Dedicated;
+        return 0;
+    };
+    driver.context_set_dir_delete_on_start = [](aeron_driver_context_t *context, bool value) {
+        delete_on_start = value;
+        return aeron_driver_context_set_dir_delete_on_start(context, value);
+    };
+    driver.close = [](aeron_driver_t *driver_handle) {
+        driver_closed = true;
+        return aeron_driver_close(driver_handle);
+    };
+    {
+        epoch::AeronTransport transport(config);
+        if (transport.embedded_driver() == nullptr || state.context_dir != "/tmp/epoch-embedded-driver" ||
+            seen_mode != epoch::DriverThreadingMode::Shared || !delete_on_start)
+        {
+            ok = false;
+        }
+    }
+    ok = ok && driver_closed;
+    epoch::test::driver_hooks() = previous_driver;
+#else
+    auto opened = epoch::AeronTransport::open(config);
+    ok = !opened.ok() && opened.status().code() == epoch::ErrorCode::InvalidArgument && !state.close_client;
+#endif
+
+    epoch::test::aeron_hooks() = previous;
+    return ok;
+}
+
+bool test_channel_uri()
+{
+    epoch::ChannelParams params;
+    params.endpoint = "localhost:40123";
+    params.term_length = 64 * 1024;
+    params.mtu_length = 1408;
+    params.linger_ns = 0;
+    params.socket_rcvbuf = 2 * 1024 * 1024;
+    auto built = epoch::build_channel_uri("aeron:udp", params);
+    if (!built.ok() || built.value() != "aeron:udp?endpoint=localhost:40123|term-length=65536|mtu=1408|linger=0|"
+                                        "so-rcvbuf=2097152")
+    {
+        return false;
+    }
+    epoch::ChannelParams ipc;
+    ipc.term_length = 1024 * 1024;
+    auto appended = epoch::build_channel_uri("aeron:ipc?alias=epoch", ipc);
+    if (!appended.ok() || appended.value() != "aeron:ipc?alias=epoch|term-length=1048576")
+    {
+        return false;
+    }
+    auto untouched = epoch::build_channel_uri("aeron-spy:aeron:udp?endpoint=localhost:40123", {});
+    if (!untouched.ok() || untouched.value() != "aeron-spy:aeron:udp?endpoint=localhost:40123")
+    {
+        return false;
+    }
+
+    epoch::ChannelParams bad_term;
+    bad_term.term_length = 100000;
+    epoch::ChannelParams bad_mtu;
+    bad_mtu.mtu_length = 1400;
+    epoch::ChannelParams udp_only;
+    udp_only.socket_rcvbuf = 1024;
+    epoch::ChannelParams duplicate;
+    duplicate.mtu_length = 1408;
+    if (epoch::validate_channel_params("aeron:udp", bad_term).ok() ||
+        epoch::validate_channel_params("aeron:udp", bad_mtu).ok() ||
+        epoch::validate_channel_params("aeron:ipc", udp_only).ok())
+    {
+        return false;
+    }
+    auto status = epoch::validate_channel_params("aeron:udp?mtu=8192", duplicate);
+    if (status.code() != epoch::ErrorCode::InvalidArgument || std::string(status.detail()) != "mtu")
+    {
+        return false;
+    }
+
+    StubState state;
+    g_state = &state;
+    auto previous = epoch::test::aeron_hooks();
+    epoch::test::aeron_hooks() = build_stub_hooks();
+    bool ok = true;
+    {
+        epoch::AeronConfig config{"aeron:ipc", 70, "", 4, 2};
+        config.channel_params.term_length = 64 * 1024;
+        config.channel_params.mtu_length = 4096;
+        epoch::AeronTransport transport(config);
+        if (transport.channel_uri() != "aeron:ipc?term-length=65536|mtu=4096" ||
+            state.publication_channel != transport.channel_uri())
+        {
+            ok = false;
+        }
+
+        config.channel_params.mtu_length = 1000;
+        auto rejected = epoch::AeronTransport::open(config);
+        if (rejected.ok() || rejected.status().code() != epoch::ErrorCode::InvalidArgument)
+        {
+            ok = false;
+        }
+    }
+    epoch::test::aeron_hooks() = previous;
+    return ok;
+}
+
+bool test_aeron_broadcast_roles()
+{
+    epoch::ChannelParams mdc;
+    mdc.control_endpoint = "10.0.0.1:40456";
+    mdc.control_mode = "dynamic";
+    auto publisher_uri = epoch::build_channel_uri("aeron:udp", mdc);
+    epoch::ChannelParams receiver;
+    receiver.endpoint = "10.0.0.2:40457";
+    receiver.control_endpoint = "10.0.0.1:40456";
+    auto receiver_uri = epoch::build_channel_uri("aeron:udp", receiver);
+    epoch::ChannelParams multicast;
+    multicast.endpoint = "224.0.1.1:40456";
+    multicast.network_interface = "192.168.1.0/24";
+    multicast.ttl = 4;
+    auto multicast_uri = epoch::build_channel_uri("aeron:udp", multicast);
+    epoch::ChannelParams bad_mode;
+    bad_mode.control_mode = "dynamic";
+    if (!publisher_uri.ok() || publisher_uri.value() != "aeron:udp?control=10.0.0.1:40456|control-mode=dynamic" ||
+        !receiver_uri.ok() || receiver_uri.value() != "aeron:udp?endpoint=10.0.0.2:40457|control=10.0.0.1:40456" ||
+        !multicast_uri.ok() ||
+        multicast_uri.value() != "aeron:udp?endpoint=224.0.1.1:40456|interface=192.168.1.0/24|ttl=4" ||
+        epoch::validate_channel_params("aeron:udp", bad_mode).ok() ||
+        epoch::validate_channel_params("aeron:ipc", multicast).ok())
+    {
+        return false;
+    }
+
+    StubState state;
+    g_state = &state;
+    auto previous = epoch::test::aeron_hooks();
+    epoch::test::aeron_hooks() = build_stub_hooks();
+    bool ok = true;
+    {
+        epoch::AeronConfig config{"aeron:udp", 80, "", 4, 2};
+        config.channel_params = mdc;
+        config.role = epoch::AeronRole::PublishOnly;
+        epoch::AeronTransport sender(config);
+        sender.send(epoch::Message{1, 1, 1, 1, 0, 0, 5});
+        if (state.async_sub_poll_calls != 0 || !sender.poll(4).empty() || sender.stats().sent_count != 1)
+        {
+            ok = false;
+        }
+
+        config.channel_params = receiver;
+        config.role = epoch::AeronRole::SubscribeOnly;
+        int pub_polls = state.async_pub_poll_calls;
+        epoch::AeronTransport spectator(config);
+        auto frames = spectator.poll(4);
+        if (state.async_pub_poll_calls != pub_polls || frames.size() != 1 || frames[0].payload != 5 ||
+            spectator.try_send(frames[0]) != epoch::SendResult::Failed)
+        {
+            ok = false;
+        }
+    }
+    epoch::test::aeron_hooks() = previous;
+    return ok;
+}
+
+bool test_aeron_adaptive_poll()
+{
+    StubState state;
+    g_state = &state;
+    auto previous = epoch::test::aeron_hooks();
+    epoch::test::aeron_hooks() = build_stub_hooks();
+    bool ok = true;
+    {
+        epoch::AeronConfig config{"aeron:ipc", 90, "", 4, 2};
+        config.poll_budget.enabled = true;
+        epoch::AeronTransport transport(config);
+        for (std::int64_t i = 0; i < 200; ++i)
+        {
+            transport.send(epoch::Message{1, 1, 1, i, 0, 0, i});
+        }
+        // One IPC image whose publisher position is 200 frames ahead of the subscriber.
+        state.images.push_back({7, 0});
+        state.counters.push_back({3, 12, 7, 90});
+        state.counter_values[3] = 200 * 96;
+        if (transport.image_lag_bytes() != 200 * 96 || transport.poll(1000).size() != 200 ||
+            transport.image_lag_bytes() != 0 || state.counter_scans != 1)
+        {
+            ok = false;
+        }
+        const auto &budget = transport.stats().poll_budget;
+        if (budget.lag_sized != 1 || budget.last_limit != 200 || budget.last_lag_bytes != 200 * 96 ||
+            budget.full_polls != 1 || budget.ns_per_fragment <= 0)
+        {
+            ok = false;
+        }
+
+        // Past the epoch deadline only one fragment is taken per poll, whatever the backlog.
+        for (std::int64_t i = 0; i < 50; ++i)
+        {
+            transport.send(epoch::Message{2, 1, 1, 200 + i, 0, 0, i});
+        }
+        state.counter_values[3] += 50 * 96;
+        transport.set_epoch_deadline(0);
+        if (transport.poll(1000).size() != 1 || transport.stats().poll_budget.deadline_capped != 1)
+        {
+            ok = false;
+        }
+
+        // A new image without a position counter: the budget falls back to growing after full polls.
+        transport.set_epoch_deadline(-1);
+        state.images.push_back({8, 0});
+        state.images.erase(state.images.begin());
+        if (transport.image_lag_bytes() != -1 || transport.poll(1000).size() != 8 ||
+            transport.stats().poll_budget.grown != 1 || transport.poll(1000).size() != 16)
+        {
+            ok = false;
+        }
+    }
+    epoch::test::aeron_hooks() = previous;
+    return ok;
+}
+
+// One loss-report.dat entry in the driver's layout.
+std::size_t put_loss_entry(std::vector<std::uint8_t> &file,
+                           std::size_t offset,
+                           std::int64_t observations,
+                           std::int64_t bytes_lost,
+                           std::int32_t session_id,
+                           std::int32_t stream_id,
+                           const std::string &channel,
+                           const std::string &source)
+{
+    auto put = [&file](std::size_t at, const void *data, std::size_t length) {
+        std::memcpy(file.data() + at, data, length);
+    };
+    put(offset + 8, &bytes_lost, sizeof(bytes_lost));
+    put(offset + 32, &session_id, sizeof(session_id));
+    put(offset + 36, &stream_id, sizeof(stream_id));
+    auto channel_length = static_cast<std::int32_t>(channel.size());
+    auto source_length = static_cast<std::int32_t>(source.size());
+    put(offset + 40, &channel_length, sizeof(channel_length));
+    put(offset + 44, channel.data(), channel.size());
+    put(offset + 44 + channel.size(), &source_length, sizeof(source_length));
+    put(offset + 48 + channel.size(), source.data(), source.size());
+    put(offset, &observations, sizeof(observations));
+    std::size_t length = 48 + channel.size() + source.size();
+    return offset + (length + epoch::kLossReportEntryAlignment - 1) / epoch::kLossReportEntryAlignment *
+                        epoch::kLossReportEntryAlignment;
+}
+
+bool test_aeron_image_metrics()
+{
+    auto directory = std::filesystem::temp_directory_path() / "epoch_cpp_aeron_images";
+    std::filesystem::create_directories(directory);
+    std::vector<std::uint8_t> report(4096, 0);
+    std::size_t next = put_loss_entry(report, 0, 2, 4096, 7, 100, "aeron:udp?endpoint=localhost:40123", "10.0.0.1:1");
+    next = put_loss_entry(report, next, 1, 1408, 9, 999, "aeron:udp?endpoint=localhost:40124", "10.0.0.2:1");
+    if (next != 256)
+    {
+        return false;
+    }
+    {
+        std::ofstream out(directory / epoch::kLossReportFileName, std::ios::binary);
+        out.write(reinterpret_cast<const char *>(report.data()), static_cast<std::streamsize>(report.size()));
+    }
+    int entries = 0;
+    auto count_entry = [](void *clientd, const epoch::LossReportEntry &entry) {
+        *static_cast<int *>(clientd) += entry.source == "10.0.0.1:1" || entry.source == "10.0.0.2:1" ? 1 : 0;
+    };
+    auto counted = epoch::read_loss_report(report.data(), report.size(), count_entry, &entries);
+    if (counted != 2 || entries != 2)
+    {
+        return false;
+    }
+
+    StubState state;
+    g_state = &state;
+    auto previous = epoch::test::aeron_hooks();
+    epoch::test::aeron_hooks() = build_stub_hooks();
+    bool ok = true;
+    {
+        epoch::AeronTransport transport(epoch::AeronConfig{"aeron:udp", 100, directory.string(), 4, 2});
+        StubImage closed{5, 0, true};
+        StubImage timed_out{6, 0, false};
+        auto *subscription = reinterpret_cast<aeron_subscription_t *>(&state);
+        state.on_available(state.available_clientd, subscription, reinterpret_cast<aeron_image_t *>(&closed));
+        state.on_available(state.available_clientd, subscription, reinterpret_cast<aeron_image_t *>(&timed_out));
+        state.on_unavailable(state.unavailable_clientd, subscription, reinterpret_cast<aeron_image_t *>(&closed));
+        state.on_unavailable(state.unavailable_clientd, subscription, reinterpret_cast<aeron_image_t *>(&timed_out));
+        transport.poll(4);
+        const auto &stats = transport.stats();
+        if (stats.images_available != 2 || stats.images_unavailable != 2 || stats.images_lost != 1)
+        {
+            ok = false;
+        }
+
+        // A UDP image 960 bytes behind the receiver high-water mark, with two loss observations on its session.
+        state.images.push_back({7, 960});
+        state.counters.push_back({2, 3, 7, 100});
+        state.counter_values[2] = 1920;
+        std::vector<epoch::AeronImageMetrics> images;
+        if (transport.image_metrics(images) != 1)
+        {
+            ok = false;
+        }
+        else
+        {
+            const auto &image = images[0];
+            if (image.session_id != 7 || image.correlation_id != 47 || image.position != 960 ||
+                image.receiver_position != 1920 || image.lag_bytes != 960 || image.loss_observations != 2 ||
+                image.bytes_lost != 4096 || image.end_of_stream || image.source_identity != "127.0.0.1:40123")
+            {
+                ok = false;
+            }
+        }
+        // Entries for other streams are not counted.
+        if (stats.loss_observations != 2 || stats.bytes_lost != 4096)
+        {
+            ok = false;
+        }
+    }
+    epoch::test::aeron_hooks() = previous;
+    std::filesystem::remove_all(directory);
+    return ok;
 }
 
 } // namespace
@@ -381,5 +917,29 @@ int main()
     {
         return 1;
     }
+    if (!test_aeron_status_api())
+    {
+        return 1;
+    }
+    if (!test_aeron_embedded_driver())
+    {
+        return 1;
+    }
+    if (!test_channel_uri())
+    {
+        return 1;
+    }
+    if (!test_aeron_broadcast_roles())
+    {
+        return 1;
+    }
+    if (!test_aeron_adaptive_poll())
+    {
+        return 1;
+    }
+    if (!test_aeron_image_metrics())
+    {
+        return 1;
+    }
     return 0;
 }
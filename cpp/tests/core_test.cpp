@@ -1,13 +1,55 @@
 #include "epoch/actor_id.h"
+#include "epoch/archive.h"
+#include "epoch/arena.h"
+#include "epoch/broadcast.h"
+#include "epoch/channel.h"
+#include "epoch/digest.h"
+#include "epoch/divergence.h"
 #include "epoch/engine.h"
 #include "epoch/epoch.h"
+#include "epoch/frame.h"
+#include "epoch/huge_pages.h"
+#include "epoch/numa.h"
+#include "epoch/outbound.h"
+#include "epoch/poll_budget.h"
+#include "epoch/replication.h"
+#include "epoch/results.h"
+#include "epoch/runtime.h"
+#include "epoch/schema.h"
+#include "epoch/sequencer.h"
+#include "epoch/tick.h"
+#include "epoch/trace.h"
 #include "epoch/transport.h"
+#include "epoch/vector_file.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
 #include <functional>
+#include <iterator>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+struct OrderPayload {
+    std::int32_t price;
+    std::int16_t quantity;
+    std::uint8_t side;
+};
+
+EPOCH_SCHEMA(OrderPayload, 7,
+             epoch::Field<&OrderPayload::price, 0>,
+             epoch::Field<&OrderPayload::quantity, 4>,
+             epoch::Field<&OrderPayload::side, 6>);
+
 namespace {
 
 bool expect_throw(const std::function<void()> &fn)
@@ -114,23 +156,1638 @@ bool test_in_memory_transport()
     return true;
 }
 
-} // namespace
+struct OrderBook {
+    std::int64_t notional = 0;
+    int orders = 0;
+};
 
-int main()
+void apply_order(OrderBook &book, const epoch::Message &, const OrderPayload &order)
 {
-    if (std::string(epoch::version()) != "0.1.0")
+    book.notional += static_cast<std::int64_t>(order.price) * order.quantity * (order.side == 0 ? 1 : -1);
+    book.orders++;
+}
+
+bool test_schema_dispatch()
+{
+    epoch::Message message{1, 1, 1, 1, 0, 0, 0};
+    epoch::encode_payload(OrderPayload{250, 4, 1}, message);
+    if (message.schema_id != 7)
     {
-        return 1;
+        return false;
     }
-    if (!test_actor_id_errors())
+    OrderPayload decoded{};
+    epoch::decode_payload(message, decoded);
+    if (decoded.price != 250 || decoded.quantity != 4 || decoded.side != 1)
     {
-        return 1;
+        return false;
     }
-    if (!test_engine_ordering_branches())
+
+    epoch::SchemaDispatcher<OrderBook> dispatcher;
+    if (dispatcher.bound(7))
     {
-        return 1;
+        return false;
     }
-    if (!test_in_memory_transport())
+    dispatcher.bind<OrderPayload>(&apply_order);
+    OrderBook book;
+    if (!dispatcher.dispatch(book, message) || book.notional != -1000 || book.orders != 1)
+    {
+        return false;
+    }
+    epoch::Message unknown = message;
+    unknown.schema_id = 8;
+    if (dispatcher.dispatch(book, unknown))
+    {
+        return false;
+    }
+    unknown.schema_id = -1;
+    if (dispatcher.dispatch(book, unknown) || book.orders != 1)
+    {
+        return false;
+    }
+    if (!expect_throw([&]() { dispatcher.bind<OrderPayload>(nullptr); }))
+    {
+        return false;
+    }
+    return true;
+}
+
+bool test_frame_codec()
+{
+    epoch::Message message{9, 8, 7, 6, 5, 200, -4};
+    std::uint8_t buffer[epoch::kFrameLength];
+    epoch::encode_frame(buffer, message);
+    if (buffer[0] != epoch::kFrameVersion || buffer[1] != 200)
+    {
+        return false;
+    }
+    epoch::Message decoded{};
+    if (!epoch::decode_frame(buffer, sizeof(buffer), decoded))
+    {
+        return false;
+    }
+    if (decoded.epoch != 9 || decoded.channel_id != 8 || decoded.source_id != 7 || decoded.source_seq != 6 ||
+        decoded.schema_id != 5 || decoded.qos != 200 || decoded.payload != -4)
+    {
+        return false;
+    }
+    if (epoch::decode_frame(buffer, epoch::kFrameLength - 1, decoded))
+    {
+        return false;
+    }
+    buffer[0] = 2;
+    return !epoch::decode_frame(buffer, sizeof(buffer), decoded);
+}
+
+bool test_tick_driver_virtual_time()
+{
+    epoch::VirtualEpochClock clock(10000);
+    epoch::TickDriver driver(epoch::TickConfig{1000}, clock);
+    std::vector<std::int64_t> epochs;
+    std::vector<std::int64_t> times;
+    auto executed = driver.run(4, [&](std::int64_t epoch) {
+        epochs.push_back(epoch);
+        times.push_back(clock.now_ns());
+    });
+    if (executed != 4 || epochs != std::vector<std::int64_t>{1, 2, 3, 4})
+    {
+        return false;
+    }
+    if (times != std::vector<std::int64_t>{10000, 11000, 12000, 13000})
+    {
+        return false;
+    }
+    const auto &stats = driver.stats();
+    if (stats.ticks != 4 || stats.overruns != 0 || stats.max_jitter_ns != 0 || stats.jitter_percentile_ns(0.99) != 0)
+    {
+        return false;
+    }
+    if (!expect_throw([&]() { epoch::TickDriver bad(epoch::TickConfig{0}, clock); }))
+    {
+        return false;
+    }
+    driver.run(10, [&](std::int64_t) { driver.stop(); });
+    return driver.epoch() == 6;
+}
+
+bool test_tick_driver_overrun_policies()
+{
+    epoch::VirtualEpochClock catch_up_clock;
+    epoch::TickDriver catch_up(epoch::TickConfig{1000, 1, epoch::OverrunPolicy::CatchUp, 8}, catch_up_clock);
+    std::vector<std::int64_t> epochs;
+    catch_up.run(4, [&](std::int64_t epoch) {
+        epochs.push_back(epoch);
+        if (epoch == 1)
+        {
+            catch_up_clock.advance(2500);
+        }
+    });
+    if (epochs != std::vector<std::int64_t>{1, 2, 3, 4} || catch_up.stats().overruns != 2 ||
+        catch_up.stats().max_jitter_ns != 1500 || catch_up.stats().skipped_epochs != 0)
+    {
+        return false;
+    }
+
+    epoch::VirtualEpochClock skip_clock;
+    epoch::TickDriver skip(epoch::TickConfig{1000, 1, epoch::OverrunPolicy::Skip}, skip_clock);
+    epochs.clear();
+    skip.run(3, [&](std::int64_t epoch) {
+        epochs.push_back(epoch);
+        if (epoch == 1)
+        {
+            skip_clock.advance(2500);
+        }
+    });
+    if (epochs != std::vector<std::int64_t>{1, 3, 4} || skip.stats().skipped_epochs != 1 ||
+        skip.stats().max_jitter_ns != 500)
+    {
+        return false;
+    }
+
+    epoch::VirtualEpochClock reset_clock;
+    epoch::TickDriver reset(epoch::TickConfig{1000, 1, epoch::OverrunPolicy::CatchUp, 2}, reset_clock);
+    reset.run(2, [&](std::int64_t epoch) {
+        if (epoch == 1)
+        {
+            reset_clock.advance(5500);
+        }
+    });
+    return reset.stats().catch_up_resets == 1 && reset.epoch() == 3 && reset.deadline_ns() == 6000;
+}
+
+bool test_steady_clock_deadline()
+{
+    epoch::SteadyEpochClock clock(50000);
+    auto deadline = clock.now_ns() + 200000;
+    clock.sleep_until(deadline);
+    return clock.now_ns() >= deadline;
+}
+
+struct BookState {
+    std::int64_t bid_quantity = 0;
+    std::int64_t ask_quantity = 0;
+    std::int64_t last_source = 0;
+};
+
+struct BookReducer {
+    using State = BookState;
+
+    std::int64_t ask_channel;
+
+    void apply(State &state, const epoch::Message &message) const
+    {
+        if (message.channel_id == ask_channel)
+        {
+            state.ask_quantity += message.payload;
+        }
+        else
+        {
+            state.bid_quantity += message.payload;
+        }
+        state.last_source = message.source_id;
+    }
+
+    static std::uint64_t hash(const State &state)
+    {
+        std::int64_t fields[3] = {state.bid_quantity, state.ask_quantity, state.last_source};
+        return epoch::fnv1a64(fields, sizeof(fields));
+    }
+};
+
+bool test_engine_reducer()
+{
+    std::vector<epoch::Message> messages = {
+        {2, 2, 1, 1, 0, 0, 7},
+        {1, 2, 3, 1, 0, 0, 4},
+        {1, 1, 2, 1, 0, 0, 5},
+        {2, 1, 4, 1, 0, 0, 1},
+    };
+
+    auto expected = epoch::process_messages(messages);
+    std::vector<epoch::Message> sum_input = messages;
+    std::size_t index = 0;
+    bool sum_ok = true;
+    epoch::EpochEngine<> sum;
+    sum.process(sum_input.data(), sum_input.data() + sum_input.size(),
+                [&](std::int64_t epoch, std::int64_t state, std::uint64_t hash) {
+                    sum_ok = sum_ok && index < expected.size() && expected[index].epoch == epoch &&
+                             expected[index].state == state && expected[index].hash == epoch::hash_hex(hash);
+                    index++;
+                });
+    if (!sum_ok || index != expected.size() || sum.state() != 17)
+    {
+        return false;
+    }
+
+    std::vector<BookState> snapshots;
+    std::vector<std::uint64_t> hashes;
+    epoch::EpochEngine<BookReducer> book(BookReducer{2});
+    book.process(messages.data(), messages.data() + messages.size(),
+                 [&](std::int64_t, const BookState &state, std::uint64_t hash) {
+                     snapshots.push_back(state);
+                     hashes.push_back(hash);
+                 });
+    if (snapshots.size() != 2 || snapshots[0].bid_quantity != 5 || snapshots[0].ask_quantity != 4 ||
+        snapshots[0].last_source != 3)
+    {
+        return false;
+    }
+    return snapshots[1].bid_quantity == 6 && snapshots[1].ask_quantity == 11 && snapshots[1].last_source == 1 &&
+           hashes[1] == BookReducer::hash(book.state()) && hashes[0] != hashes[1];
+}
+
+bool test_state_digest()
+{
+    epoch::StateDigest forward;
+    forward.add(7, "bid", 3);
+    forward.add(3, -5);
+    epoch::StateDigest backward;
+    backward.add(3, 1);
+    backward.add(7, "bid", 3);
+    backward.replace(3, 1, -5);
+    if (forward != backward || forward.hex() != "beba82641d751f3b")
+    {
+        return false;
+    }
+    backward.remove(7, "bid", 3);
+    backward.remove(3, -5);
+    if (backward.value() != 0)
+    {
+        return false;
+    }
+
+    auto results = epoch::process_messages({{1, 1, 1, 1, 0, 0, 10}});
+    return epoch::hash_hex(epoch::state_digest(0)) == "68752350ae1d483f" && results.size() == 1 &&
+           results[0].digest == "b492f0b01aa70577";
+}
+
+bool test_priority_inbox()
+{
+    epoch::PriorityInboxConfig config;
+    config.lanes[static_cast<std::size_t>(epoch::QosBand::Default)] = {4, 1};
+    config.lanes[static_cast<std::size_t>(epoch::QosBand::System)] = {4, 2};
+    epoch::PriorityInbox inbox(config);
+    for (std::int64_t seq = 1; seq <= 4; ++seq)
+    {
+        inbox.try_push({1, 1, 1, seq, 0, 0, seq});
+    }
+    if (inbox.try_push({1, 1, 1, 5, 0, 0, 5}) || inbox.stats(epoch::QosBand::Default).rejected != 1)
+    {
+        return false;
+    }
+    inbox.try_push({1, 1, 2, 1, 0, 250, 100});
+    inbox.try_push({1, 1, 2, 2, 0, 250, 200});
+    inbox.try_push({1, 1, 2, 3, 0, 250, 300});
+
+    std::vector<std::int64_t> order;
+    auto sink = [&](const epoch::Message &message) { order.push_back(message.payload); };
+    if (inbox.drain(3, sink) != 3 || order != std::vector<std::int64_t>{100, 200, 1})
+    {
+        return false;
+    }
+    inbox.drain(10, sink);
+    if (order != std::vector<std::int64_t>{100, 200, 1, 300, 2, 3, 4} || inbox.size() != 0)
+    {
+        return false;
+    }
+
+    epoch::InMemoryTransport transport;
+    transport.send({1, 1, 1, 1, 0, 0, 1});
+    transport.send({1, 1, 1, 2, 0, 130, 2});
+    transport.send({1, 1, 1, 3, 0, 255, 3});
+    auto polled = transport.poll(8);
+    return polled.size() == 3 && polled[0].payload == 3 && polled[1].payload == 2 && polled[2].payload == 1;
+}
+
+bool test_runtime_seal()
+{
+    std::vector<epoch::Message> messages = {
+        {1, 1, 1, 1, 0, 0, 3},
+        {2, 1, 1, 2, 0, 0, 4},
+        {1, 2, 2, 1, 0, 240, 5},
+        {1, 1, 3, 1, 0, 7, 6},
+        {3, 1, 1, 3, 0, 0, 1},
+    };
+    auto expected = epoch::process_messages(messages);
+
+    epoch::InMemoryTransport transport;
+    for (const auto &message : messages)
+    {
+        transport.send(message);
+    }
+    epoch::RuntimeConfig config;
+    config.poll_batch = 2;
+    epoch::EpochRuntime<> runtime(transport, config);
+    while (runtime.pump() > 0)
+    {
+    }
+
+    std::vector<epoch::EpochResult> results;
+    auto collect = [&](std::int64_t epoch, std::int64_t state, std::uint64_t hash) {
+        results.push_back({epoch, state, epoch::hash_hex(hash), epoch::hash_hex(epoch::state_digest(state))});
+    };
+    for (std::int64_t epoch = 1; epoch <= 3; ++epoch)
+    {
+        runtime.seal(epoch, collect);
+        if (runtime.pending() != static_cast<std::size_t>(epoch == 1 ? 2 : epoch == 2 ? 1 : 0))
+        {
+            return false;
+        }
+    }
+    if (results.size() != expected.size() || runtime.stats().processed != 5 || runtime.state() != 19)
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        if (results[i].epoch != expected[i].epoch || results[i].hash != expected[i].hash)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Input beyond a full lane waits in the backlog and is still sealed; nothing polled is lost.
+bool test_runtime_lane_overflow()
+{
+    epoch::InMemoryTransport transport;
+    for (std::int64_t seq = 1; seq <= 100; ++seq)
+    {
+        // One epoch per poll batch, so each seal below finds its own input.
+        transport.send({(seq - 1) / 16 + 1, 1, 1, seq, 0, 0, 1});
+    }
+    epoch::RuntimeConfig config;
+    config.poll_batch = 16;
+    for (auto &lane : config.inbox.lanes)
+    {
+        lane = epoch::LaneConfig{8, 8};
+    }
+    epoch::EpochRuntime<> runtime(transport, config);
+    for (int pump = 0; pump < 10; ++pump)
+    {
+        runtime.pump();
+    }
+    if (runtime.stats().deferred != 8 || runtime.stats().polled != 16 || runtime.pending() != 16)
+    {
+        return false;
+    }
+    std::int64_t sealed_state = 0;
+    auto collect = [&](std::int64_t, std::int64_t state, std::uint64_t) { sealed_state = state; };
+    if (runtime.seal(1, collect) != 16 || sealed_state != 16)
+    {
+        return false;
+    }
+    for (std::int64_t epoch = 2; runtime.pump() > 0; ++epoch)
+    {
+        runtime.seal(epoch, collect);
+    }
+    return sealed_state == 100 && runtime.stats().processed == 100 && runtime.pending() == 0;
+}
+
+// Input for an epoch that is already sealed is refused, not reported under the next seal.
+bool test_runtime_late_input()
+{
+    epoch::InMemoryTransport transport;
+    transport.send({5, 1, 1, 1, 0, 0, 2});
+    epoch::EpochRuntime<> runtime(transport);
+    runtime.pump();
+    std::vector<std::int64_t> epochs;
+    auto collect = [&](std::int64_t epoch, std::int64_t, std::uint64_t) { epochs.push_back(epoch); };
+    runtime.seal(5, collect);
+    transport.send({3, 1, 1, 2, 0, 0, 10});
+    transport.send({6, 1, 1, 3, 0, 0, 4});
+    runtime.pump();
+    if (runtime.post({5, 1, 1, 4, 0, 0, 20}) || !runtime.post({6, 1, 1, 5, 0, 0, 1}))
+    {
+        return false;
+    }
+    runtime.seal(6, collect);
+    return epochs == std::vector<std::int64_t>{5, 6} && runtime.state() == 7 && runtime.stats().late == 2 &&
+           runtime.stats().processed == 3;
+}
+
+class ThrottledTransport final : public epoch::Transport {
+public:
+    void send(const epoch::Message &) override
+    {
+        throw std::runtime_error("offer failed");
+    }
+
+    epoch::SendResult try_send(const epoch::Message &message) override
+    {
+        if (window == 0)
+        {
+            return epoch::SendResult::BackPressured;
+        }
+        window--;
+        delivered.push_back(message);
+        return epoch::SendResult::Sent;
+    }
+
+    std::vector<epoch::Message> poll(std::size_t) override
+    {
+        return {};
+    }
+
+    void close() override
+    {
+    }
+
+    std::size_t window = 0;
+    std::vector<epoch::Message> delivered;
+};
+
+bool test_outbound_back_pressure()
+{
+    ThrottledTransport transport;
+    epoch::OutboundConfig config;
+    config.capacity = 4;
+    config.credits_per_epoch = 2;
+    epoch::OutboundBuffer deferred(transport, config);
+    deferred.enqueue({1, 1, 1, 1, 0, 0, 1});
+    deferred.enqueue({1, 1, 1, 2, 0, 0, 2});
+    deferred.enqueue({1, 1, 1, 3, 0, 200, 3});
+    transport.window = 1;
+    if (deferred.flush() != 1 || transport.delivered[0].payload != 3 || deferred.queued() != 2 ||
+        deferred.stats().back_pressured != 1)
+    {
+        return false;
+    }
+    transport.window = 10;
+    if (deferred.flush() != 1 || deferred.stats().credit_stalls != 1)
+    {
+        return false;
+    }
+    deferred.begin_epoch();
+    if (deferred.flush() != 1 || deferred.queued() != 0 || deferred.stats().deferred != 1)
+    {
+        return false;
+    }
+
+    config.policy = epoch::BackPressurePolicy::ShedLowQos;
+    config.credits_per_epoch = 8;
+    epoch::OutboundBuffer shedding(transport, config);
+    transport.window = 0;
+    for (std::int64_t seq = 1; seq <= 4; ++seq)
+    {
+        shedding.enqueue({2, 1, 1, seq, 0, 0, seq});
+    }
+    if (!shedding.enqueue({2, 1, 1, 5, 0, 250, 5}) || shedding.enqueue({2, 1, 1, 6, 0, 0, 6}) ||
+        shedding.stats().shed != 1 || shedding.stats().rejected != 1)
+    {
+        return false;
+    }
+    shedding.flush();
+    if (shedding.queued() != 1 || shedding.stats().shed != 4)
+    {
+        return false;
+    }
+    transport.window = 1;
+    return shedding.flush() == 1 && transport.delivered.back().payload == 5;
+}
+
+bool test_archive_replay()
+{
+    std::vector<epoch::Message> messages = {
+        {1, 1, 1, 1, 0, 0, 2},
+        {1, 1, 2, 1, 0, 9, 3},
+        {2, 1, 1, 2, 0, 0, 4},
+        {3, 2, 1, 3, 0, 0, 5},
+    };
+    auto expected = epoch::process_messages(messages);
+
+    auto path = (std::filesystem::temp_directory_path() / "epoch_cpp_core_archive.journal").string();
+    std::remove(path.c_str());
+    std::int64_t stop = 0;
+    {
+        auto opened = epoch::LocalArchive::open(path);
+        if (!opened.ok())
+        {
+            return false;
+        }
+        epoch::InMemoryTransport live;
+        epoch::RecordingTransport recording(live, *opened.value());
+        for (const auto &message : messages)
+        {
+            live.send(message);
+        }
+        if (recording.poll(3).size() != 3 || recording.poll(8).size() != 1 || recording.record_failures() != 0)
+        {
+            return false;
+        }
+        recording.close();
+        stop = opened.value()->stop_position();
+    }
+
+    auto reopened = epoch::LocalArchive::open(path);
+    if (!reopened.ok() || reopened.value()->stop_position() != stop ||
+        stop != static_cast<std::int64_t>(4 * epoch::kFrameLength))
+    {
+        return false;
+    }
+
+    epoch::ReplayTransport replay(*reopened.value());
+    epoch::RuntimeConfig config;
+    config.poll_batch = 2;
+    epoch::EpochRuntime<> runtime(replay, config);
+    while (!replay.done())
+    {
+        runtime.pump();
+    }
+    std::vector<std::string> hashes;
+    runtime.seal(3, [&](std::int64_t, std::int64_t, std::uint64_t hash) { hashes.push_back(epoch::hash_hex(hash)); });
+    if (hashes.size() != expected.size() || hashes.back() != expected.back().hash)
+    {
+        return false;
+    }
+
+    epoch::ReplayTransport range(*reopened.value(), static_cast<std::int64_t>(epoch::kFrameLength),
+                                 static_cast<std::int64_t>(3 * epoch::kFrameLength));
+    auto window = range.poll(8);
+    if (window.size() != 2 || window[0].payload != 2 || window[1].payload != 4 || !range.done())
+    {
+        return false;
+    }
+    reopened.value().reset();
+
+    // A crash mid-write leaves a partial frame; the next record() must start on the frame boundary.
+    std::FILE *torn = std::fopen(path.c_str(), "ab");
+    std::uint8_t partial[10] = {1, 2, 3};
+    std::fwrite(partial, 1, sizeof(partial), torn);
+    std::fclose(torn);
+    {
+        auto resumed = epoch::LocalArchive::open(path);
+        std::uint8_t frame[epoch::kFrameLength];
+        epoch::encode_frame(frame, epoch::Message{4, 1, 1, 4, 0, 0, 6});
+        if (!resumed.ok() || resumed.value()->stop_position() != stop ||
+            !resumed.value()->record(frame, sizeof(frame)).ok())
+        {
+            return false;
+        }
+    }
+    auto after_crash = epoch::LocalArchive::open(path);
+    if (!after_crash.ok() ||
+        after_crash.value()->stop_position() != stop + static_cast<std::int64_t>(epoch::kFrameLength))
+    {
+        return false;
+    }
+    epoch::ReplayTransport tail(*after_crash.value(), stop);
+    auto resumed_frames = tail.poll(8);
+    after_crash.value().reset();
+    std::remove(path.c_str());
+    return resumed_frames.size() == 1 && resumed_frames[0].payload == 6 && resumed_frames[0].epoch == 4;
+}
+
+bool test_epoch_arena()
+{
+    epoch::EpochArena arena(256);
+    std::vector<epoch::Message> messages = {
+        {2, 1, 1, 1, 0, 0, 5},
+        {1, 1, 2, 1, 0, 0, 3},
+        {1, 1, 1, 1, 0, 0, 4},
+    };
+
+    std::size_t reserved = 0;
+    for (int round = 0; round < 3; ++round)
+    {
+        {
+            auto records = epoch::process_messages(messages.data(), messages.size(), arena);
+            auto expected = epoch::process_messages(messages);
+            if (records.size() != expected.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < records.size(); ++i)
+            {
+                if (records[i].epoch != expected[i].epoch || records[i].state != expected[i].state ||
+                    epoch::hash_hex(records[i].hash) != expected[i].hash)
+                {
+                    return false;
+                }
+            }
+
+            epoch::InMemoryTransport transport;
+            transport.send(messages[0]);
+            transport.send(messages[1]);
+            epoch::ArenaVector<epoch::Message> inbound(&arena);
+            if (transport.poll_into(inbound, 8) != 2 || inbound[1].source_id != 2)
+            {
+                return false;
+            }
+        }
+        if (arena.used() == 0)
+        {
+            return false;
+        }
+        if (round == 0)
+        {
+            reserved = arena.reserved();
+        }
+        else if (arena.reserved() != reserved)
+        {
+            return false;
+        }
+        arena.reset();
+        if (arena.used() != 0)
+        {
+            return false;
+        }
+    }
+
+    auto *big = static_cast<std::uint8_t *>(arena.allocate(1024, 64));
+    return big != nullptr && reinterpret_cast<std::uintptr_t>(big) % 64 == 0 && arena.high_water() >= 1024 &&
+           epoch::state_hash(0) == 0xc3c43df01be7b59cULL;
+}
+
+bool test_sequencer_merge()
+{
+    std::vector<epoch::InMemoryTransport> gateways(5);
+    std::vector<epoch::Transport *> inputs;
+    for (auto &gateway : gateways)
+    {
+        inputs.push_back(&gateway);
+    }
+    epoch::Sequencer sequencer(inputs);
+
+    // Gateway 0 is a single in-order source; the others interleave sources, channels and qos.
+    std::vector<epoch::Message> all;
+    std::uint64_t seed = 7;
+    for (std::int64_t seq = 1; seq <= 40; ++seq)
+    {
+        epoch::Message message{1 + (seq - 1) / 20, 1, 100, seq, 0, 0, seq};
+        gateways[0].send(message);
+        all.push_back(message);
+    }
+    for (std::size_t g = 1; g < gateways.size(); ++g)
+    {
+        for (std::int64_t seq = 1; seq <= 30; ++seq)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            epoch::Message message{1 + static_cast<std::int64_t>((seed >> 33) % 2),
+                                   static_cast<std::int64_t>((seed >> 40) % 3),
+                                   static_cast<std::int64_t>(g * 10 + (seed >> 50) % 2),
+                                   seq,
+                                   0,
+                                   static_cast<std::uint8_t>((seed >> 20) % 3 == 0 ? 200 : 0),
+                                   static_cast<std::int64_t>(seed >> 44)};
+            gateways[g].send(message);
+            all.push_back(message);
+        }
+    }
+    sequencer.pump();
+
+    std::vector<epoch::Message> merged;
+    std::size_t first = sequencer.seal_into(1, merged);
+    gateways[2].send(epoch::Message{1, 0, 99, 1, 0, 0, 3});
+    sequencer.pump();
+    std::size_t second = sequencer.seal_into(2, merged);
+    if (first + second != all.size() || sequencer.pending() != 0 || sequencer.stats().late != 1 ||
+        sequencer.stats().sorted_runs == 0 || !std::is_sorted(merged.begin(), merged.begin() + first,
+                                                               epoch::MessageOrder{}) ||
+        !std::is_sorted(merged.begin() + first, merged.end(), epoch::MessageOrder{}))
+    {
+        return false;
+    }
+
+    std::vector<epoch::Message> expected(merged.begin(), merged.begin() + first);
+    auto by_epoch = all;
+    std::sort(by_epoch.begin(), by_epoch.end(), epoch::MessageOrder{});
+    by_epoch.resize(first);
+    for (std::size_t i = 0; i < first; ++i)
+    {
+        if (expected[i].source_id != by_epoch[i].source_id || expected[i].source_seq != by_epoch[i].source_seq)
+        {
+            return false;
+        }
+    }
+
+    epoch::EpochEngine<> engine;
+    std::vector<std::string> hashes;
+    auto record = [&](std::int64_t, std::int64_t, std::uint64_t hash) { hashes.push_back(epoch::hash_hex(hash)); };
+    engine.fold(merged.data(), merged.data() + first, record);
+    engine.fold(merged.data() + first, merged.data() + merged.size(), record);
+    return engine.state() == epoch::process_messages(all).back().state &&
+           expect_throw([] { epoch::Sequencer empty({}); });
+}
+
+bool test_presorted_fast_path()
+{
+    std::vector<epoch::Message> ordered;
+    for (std::int64_t seq = 1; seq <= 200; ++seq)
+    {
+        ordered.push_back(epoch::Message{1 + seq / 50, seq % 3, seq % 7, seq, 0, 0, seq});
+    }
+    std::sort(ordered.begin(), ordered.end(), epoch::MessageOrder{});
+    auto reference = epoch::process_messages(ordered);
+
+    // A few late high-qos messages appended after an ordered batch: three extra runs.
+    auto late = ordered;
+    for (std::size_t i : {std::size_t{10}, std::size_t{90}, std::size_t{150}})
+    {
+        auto message = late[i];
+        late.erase(late.begin() + static_cast<std::ptrdiff_t>(i));
+        late.push_back(message);
+    }
+    auto shuffled = ordered;
+    std::reverse(shuffled.begin(), shuffled.end());
+
+    std::pmr::vector<epoch::Message> scratch;
+    auto merged = late;
+    auto scrambled = shuffled;
+    auto presorted = ordered;
+    if (epoch::sort_messages(presorted.data(), presorted.data() + presorted.size(), scratch) !=
+            epoch::SortPath::Presorted ||
+        !scratch.empty() ||
+        epoch::sort_messages(merged.data(), merged.data() + merged.size(), scratch) != epoch::SortPath::Merged ||
+        epoch::sort_messages(scrambled.data(), scrambled.data() + scrambled.size(), scratch) !=
+            epoch::SortPath::Sorted)
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < ordered.size(); ++i)
+    {
+        if (merged[i].source_seq != ordered[i].source_seq || scrambled[i].source_seq != ordered[i].source_seq)
+        {
+            return false;
+        }
+    }
+
+    epoch::EpochEngine<> engine;
+    std::vector<std::string> hashes;
+    auto record = [&](std::int64_t, std::int64_t, std::uint64_t hash) { hashes.push_back(epoch::hash_hex(hash)); };
+    auto first = ordered;
+    auto second = late;
+    engine.process(first.data(), first.data() + first.size(), record);
+    engine.process(second.data(), second.data() + second.size(), record);
+    const auto &stats = engine.sort_stats();
+    epoch::EpochArena arena(4096);
+    auto records = epoch::process_messages(late.data(), late.size(), arena);
+    return stats.presorted == 1 && stats.merged == 1 && stats.sorted == 0 && hashes.size() == 2 * reference.size() &&
+           hashes[reference.size() - 1] == reference.back().hash && records.size() == reference.size() &&
+           epoch::hash_hex(records.back().hash) == reference.back().hash &&
+           epoch::process_messages(shuffled).back().hash == reference.back().hash;
+}
+
+// A sink whose stream fails on the first flush: every later write must stop at the full buffer, not past it.
+bool test_failing_result_sink()
+{
+#if defined(__linux__)
+    auto sink = epoch::FileSink::open("/dev/full", 2 * epoch::kResultRecordLength);
+    if (!sink.ok())
+    {
+        return false;
+    }
+    for (std::int64_t epoch = 1; epoch <= 100; ++epoch)
+    {
+        sink.value()->write(epoch::EpochRecord{epoch, epoch, 0, 0});
+    }
+    return !sink.value()->status().ok() && sink.value()->status().code() == epoch::ErrorCode::IoFailed &&
+           sink.value()->written() == 2 && !sink.value()->flush().ok();
+#else
+    return true;
+#endif
+}
+
+bool test_result_sinks()
+{
+    std::vector<epoch::Message> messages;
+    for (std::int64_t seq = 1; seq <= 60; ++seq)
+    {
+        messages.push_back(epoch::Message{seq % 6, seq % 2, seq % 5, seq, 0, 0, seq * 3 - 40});
+    }
+    auto expected = epoch::process_messages(messages);
+
+    auto path = (std::filesystem::temp_directory_path() / "epoch_cpp_core_results.bin").string();
+    epoch::EpochArena arena(4096);
+    epoch::RingSink ring(2);
+    {
+        auto file = epoch::FileSink::open(path, 64);
+        if (!file.ok() || epoch::process_messages(messages.data(), messages.size(), arena, *file.value()) !=
+                              expected.size())
+        {
+            return false;
+        }
+        epoch::process_messages(messages.data(), messages.size(), arena, ring);
+        if (!file.value()->flush().ok() || file.value()->written() != static_cast<std::int64_t>(expected.size()))
+        {
+            return false;
+        }
+    }
+
+    auto reader = epoch::ResultFileReader::open(path);
+    if (!reader.ok() || reader.value()->count() != expected.size())
+    {
+        return false;
+    }
+    for (std::size_t i = expected.size(); i-- > 0;)
+    {
+        epoch::EpochRecord record{};
+        if (!reader.value()->read(i, record) || record.epoch != expected[i].epoch ||
+            record.state != expected[i].state || epoch::hash_hex(record.hash) != expected[i].hash ||
+            epoch::hash_hex(record.digest) != expected[i].digest)
+        {
+            return false;
+        }
+    }
+    epoch::EpochRecord past_end{};
+    std::remove(path.c_str());
+    if (reader.value()->read(expected.size(), past_end) || ring.size() != 2 || ring.total() != 6 ||
+        ring.at(1).epoch != expected.back().epoch || ring.at(0).epoch != expected[expected.size() - 2].epoch)
+    {
+        return false;
+    }
+
+    std::int64_t seen = 0;
+    epoch::CallbackSink callback(
+        [](void *clientd, const epoch::EpochRecord &) { ++*static_cast<std::int64_t *>(clientd); }, &seen);
+    epoch::InMemoryTransport transport;
+    epoch::EpochRuntime<> runtime(transport);
+    for (const auto &message : messages)
+    {
+        transport.send(message);
+    }
+    runtime.pump();
+    runtime.seal(5, epoch::sink_results(callback));
+    return seen == static_cast<std::int64_t>(expected.size()) &&
+           !epoch::ResultFileReader::open(path + ".missing").ok();
+}
+
+bool test_divergence_checker()
+{
+    epoch::VectorSpec spec;
+    spec.messages = 5000;
+    spec.epochs = 300;
+    spec.channels = 7;
+    spec.sources = 40;
+    spec.seed = 42;
+    auto messages = epoch::generate_vector(spec);
+    auto again = epoch::generate_vector(spec);
+    if (messages.size() != 5000 || again.size() != messages.size() || again[4999].payload != messages[4999].payload)
+    {
+        return false;
+    }
+
+    auto expected = epoch::process_messages(messages);
+    auto parallel = epoch::process_parallel(messages, 4);
+    auto single = epoch::process_parallel(messages, 1);
+    if (parallel.size() != expected.size() || single.size() != expected.size())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        if (parallel[i].epoch != expected[i].epoch || parallel[i].state != expected[i].state ||
+            epoch::hash_hex(parallel[i].hash) != expected[i].hash || single[i].hash != parallel[i].hash)
+        {
+            return false;
+        }
+    }
+
+    auto dir = std::filesystem::temp_directory_path();
+    auto journal_path = (dir / "epoch_cpp_core_vector.journal").string();
+    if (!epoch::write_journal(journal_path, messages).ok())
+    {
+        return false;
+    }
+    auto journal = epoch::read_journal(journal_path);
+    std::remove(journal_path.c_str());
+    if (!journal.ok() || journal.value().size() != messages.size() ||
+        journal.value()[123].source_seq != messages[123].source_seq || journal.value()[123].qos != messages[123].qos)
+    {
+        return false;
+    }
+
+    // The right-hand run drops one payload unit from record 97 on, as a drifting implementation would.
+    auto write = [](const std::string &path, const std::vector<epoch::EpochRecord> &records, std::size_t drift_from) {
+        auto sink = epoch::FileSink::open(path);
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            auto record = records[i];
+            if (i >= drift_from)
+            {
+                record.state -= 1;
+                record.hash = epoch::state_hash(record.state);
+            }
+            sink.value()->write(record);
+        }
+        return sink.value()->flush().ok();
+    };
+    auto left_path = (dir / "epoch_cpp_core_left.results").string();
+    auto right_path = (dir / "epoch_cpp_core_right.results").string();
+    auto short_path = (dir / "epoch_cpp_core_short.results").string();
+    std::vector<epoch::EpochRecord> prefix(parallel.begin(), parallel.begin() + 50);
+    if (!write(left_path, parallel, parallel.size()) || !write(right_path, parallel, 97) ||
+        !write(short_path, prefix, prefix.size()))
+    {
+        return false;
+    }
+    // Only record 1 differs; the runs agree again from record 2 on, so nothing monotonic is left to bisect.
+    auto blip_path = (dir / "epoch_cpp_core_blip.results").string();
+    auto blipped = parallel;
+    blipped[1].state += 1;
+    if (!write(blip_path, blipped, blipped.size()))
+    {
+        return false;
+    }
+    auto left = epoch::ResultFileReader::open(left_path);
+    auto right = epoch::ResultFileReader::open(right_path);
+    auto same = epoch::ResultFileReader::open(left_path);
+    auto shorter = epoch::ResultFileReader::open(short_path);
+    auto blip = epoch::ResultFileReader::open(blip_path);
+    auto drift = epoch::first_divergence(*left.value(), *right.value());
+    auto identical = epoch::first_divergence(*left.value(), *same.value());
+    auto truncated = epoch::first_divergence(*left.value(), *shorter.value());
+    auto transient = epoch::first_divergence(*left.value(), *blip.value());
+    std::remove(left_path.c_str());
+    std::remove(right_path.c_str());
+    std::remove(short_path.c_str());
+    std::remove(blip_path.c_str());
+    return drift.ok() && drift.value().found && drift.value().index == 97 &&
+           drift.value().left.epoch == parallel[97].epoch && drift.value().right.state == parallel[97].state - 1 &&
+           drift.value().probes == 98 && identical.ok() && !identical.value().found && truncated.ok() &&
+           truncated.value().length_mismatch && truncated.value().index == 50 && transient.ok() &&
+           transient.value().found && transient.value().index == 1 &&
+           transient.value().right.state == parallel[1].state + 1;
+}
+
+bool test_trace_export()
+{
+    // Epochs far above the ones other tests use, so their events are easy to pick out of the shared rings.
+    constexpr std::int64_t kTracedEpoch = 900001;
+    epoch::set_trace_thread_name("core \"test\"");
+    epoch::trace_record(epoch::TracePhase::Sort, kTracedEpoch, 100, 250, 7);
+    {
+        epoch::TraceScope scope(epoch::TracePhase::Emit, 0);
+        scope.set_epoch(kTracedEpoch);
+        scope.set_count(3);
+    }
+
+    std::uint32_t first_worker = 0;
+    std::uint32_t second_worker = 1;
+    auto record_on_worker = [](std::int64_t epoch, std::uint32_t &thread) {
+        std::thread worker([epoch] { epoch::trace_record(epoch::TracePhase::Fold, epoch, 10, 20, 1); });
+        worker.join();
+        std::vector<epoch::TraceEvent> events;
+        epoch::snapshot_trace(events);
+        for (const auto &event : events)
+        {
+            if (event.epoch == epoch)
+            {
+                thread = event.thread;
+            }
+        }
+    };
+    record_on_worker(kTracedEpoch + 1, first_worker);
+    record_on_worker(kTracedEpoch + 2, second_worker);
+    if (first_worker != second_worker)
+    {
+        return false;
+    }
+
+#if defined(EPOCH_TRACING)
+    epoch::InMemoryTransport transport;
+    transport.send({kTracedEpoch + 3, 1, 1, 1, 100, 0, 4});
+    transport.send({kTracedEpoch + 3, 1, 2, 1, 100, 0, 5});
+    epoch::EpochRuntime<> runtime(transport);
+    runtime.pump();
+    runtime.seal(kTracedEpoch + 3, [](std::int64_t, std::int64_t, std::uint64_t) {});
+#endif
+
+    std::vector<epoch::TraceEvent> events;
+    epoch::snapshot_trace(events);
+    bool sorted = false;
+    bool emitted = false;
+    int runtime_phases = 0;
+    for (const auto &event : events)
+    {
+        sorted = sorted || (event.epoch == kTracedEpoch && event.phase == epoch::TracePhase::Sort &&
+                            event.end_ns - event.begin_ns == 150 && event.count == 7);
+        emitted = emitted || (event.epoch == kTracedEpoch && event.phase == epoch::TracePhase::Emit &&
+                              event.count == 3 && event.end_ns >= event.begin_ns);
+        if (event.epoch == kTracedEpoch + 3)
+        {
+            runtime_phases++;
+        }
+    }
+#if defined(EPOCH_TRACING)
+    // drain, sort, fold, hash and emit of the sealed epoch.
+    if (runtime_phases != 5)
+    {
+        return false;
+    }
+#else
+    if (runtime_phases != 0)
+    {
+        return false;
+    }
+#endif
+
+    auto path = (std::filesystem::temp_directory_path() / "epoch_cpp_core_trace.json").string();
+    if (!sorted || !emitted || !epoch::write_chrome_trace(path).ok())
+    {
+        return false;
+    }
+    std::ifstream in(path);
+    std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::remove(path.c_str());
+    return json.rfind("{\"displayTimeUnit\"", 0) == 0 &&
+           json.find("\"name\":\"core \\\"test\\\"\"") != std::string::npos &&
+           json.find("\"name\":\"sort\",\"cat\":\"epoch\",\"ph\":\"X\"") != std::string::npos &&
+           json.find("\"epoch\":900001,\"count\":7") != std::string::npos && json.substr(json.size() - 4) == "\n]}\n";
+}
+
+bool test_poll_budget()
+{
+    epoch::PollBudgetConfig config;
+    config.enabled = true;
+    config.min_fragments = 4;
+    config.max_fragments = 256;
+    epoch::PollBudget budget(config, 16);
+
+    // Sized from lag: 1000 bytes is 11 frames; a huge backlog is clamped to max_fragments.
+    if (budget.next(1000, -1) != 11 || budget.next(0, -1) != 4 || budget.next(1 << 30, -1) != 256)
+    {
+        return false;
+    }
+    budget.observe(256, 256 * 1000);
+    // 1000ns per fragment and 40us left: half of it affords 20 fragments.
+    if (budget.stats().ns_per_fragment != 1000 || budget.next(1 << 30, 40000) != 20 ||
+        budget.stats().deadline_capped != 1 || budget.next(1 << 30, 0) != 1)
+    {
+        return false;
+    }
+
+    // Unknown lag: double after a full poll, halve after a sparse one, within [min, max].
+    if (budget.next(-1, -1) != 16)
+    {
+        return false;
+    }
+    budget.observe(16, 16000);
+    if (budget.next(-1, -1) != 32)
+    {
+        return false;
+    }
+    budget.observe(2, 2000);
+    const auto &stats = budget.stats();
+    return budget.next(-1, -1) == 16 && stats.grown == 1 && stats.shrunk == 1 && stats.polls == 3 &&
+           stats.full_polls == 2 && stats.lag_sized == 5 && stats.last_lag_bytes == -1;
+}
+
+bool test_numa_placement()
+{
+    auto cpus = epoch::parse_cpu_list("0-3,8-9,12\n");
+    if (!cpus.ok() || cpus.value() != std::vector<std::int32_t>{0, 1, 2, 3, 8, 9, 12} ||
+        epoch::parse_cpu_list("3-1").ok() || epoch::parse_cpu_list("0,x").ok())
+    {
+        return false;
+    }
+
+#if defined(__linux__)
+    // A fake two-node sysfs built from the CPUs this process may use; a single-CPU sandbox yields one node.
+    auto usable = epoch::NumaTopology::detect("/nonexistent").nodes()[0].cpus;
+    auto root = std::filesystem::temp_directory_path() / "epoch_cpp_core_numa";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "node0");
+    std::filesystem::create_directories(root / "node1");
+    std::ofstream(root / "node0" / "cpulist") << usable[0] << "\n";
+    std::string shared = usable.size() > 1 ? "," + std::to_string(usable.back()) : "";
+    std::ofstream(root / "node1" / "cpulist") << "4096" << shared << "\n";
+    std::ofstream(root / "possible") << "0-1\n";
+    auto detected = epoch::NumaTopology::detect(root.string());
+    std::filesystem::remove_all(root);
+    if (detected.nodes().size() != (usable.size() > 1 ? 2U : 1U) || detected.node_of_cpu(usable[0]) != 0 ||
+        detected.node_of_cpu(4096) != -1)
+    {
+        return false;
+    }
+#else
+    // No sysfs, affinity or memory policy: one node of hardware_concurrency CPUs, placement calls report it.
+    if (epoch::NumaTopology::detect().nodes().size() != 1 ||
+        epoch::pin_current_thread(0).code() != epoch::ErrorCode::Unsupported ||
+        epoch::prefer_node_memory(0).code() != epoch::ErrorCode::Unsupported)
+    {
+        return false;
+    }
+#endif
+
+    epoch::NumaTopology topology({{0, {0, 1}}, {1, {2, 3}}});
+    std::vector<epoch::ActorIdParts> actors;
+    for (int i = 0; i < 5; ++i)
+    {
+        actors.push_back({1, 1, 1, 0, static_cast<std::uint32_t>(i)});
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        actors.push_back({1, 2, 1, 0, static_cast<std::uint32_t>(i)});
+    }
+    actors.push_back({2, 1, 1, 0, 0});
+    actors.push_back({2, 1, 1, 0, 1});
+    auto placement = epoch::place_actors(actors, topology);
+    if (placement.workers.size() != 4 || placement.workers[0].actors.size() != 3 ||
+        placement.workers[1].actors.size() != 2 || placement.workers[2].actors.size() != 3 ||
+        placement.workers[3].actors.size() != 2 || placement.workers[3].cpu != 3)
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < actors.size(); ++i)
+    {
+        std::int32_t node = placement.workers[placement.worker_of[i]].node;
+        if (node != (actors[i].region == 1 && actors[i].server == 1 ? 0 : 1))
+        {
+            return false;
+        }
+    }
+    if (epoch::place_actors(actors, topology, 1).workers.size() != 2)
+    {
+        return false;
+    }
+
+    std::vector<epoch::Message> messages = {{1, 1, 1, 1, 0, 0, 3}, {1, 2, 2, 1, 0, 240, 5}, {2, 1, 1, 2, 0, 9, 4}};
+    auto expected = epoch::process_messages(messages);
+    epoch::NodeMemoryResource memory(0);
+    {
+        epoch::InMemoryTransport transport;
+        for (const auto &message : messages)
+        {
+            transport.send(message);
+        }
+        epoch::RuntimeConfig config;
+        config.memory = &memory;
+        epoch::EpochRuntime<> runtime(transport, config);
+        runtime.pump();
+        std::vector<std::int64_t> states;
+        runtime.seal(2, [&](std::int64_t, std::int64_t state, std::uint64_t) { states.push_back(state); });
+        // Four lane rings, the poll buffer and one arena block.
+        if (states.size() != expected.size() || states.back() != expected.back().state ||
+            memory.stats().allocations != 6)
+        {
+            return false;
+        }
+    }
+    if (memory.stats().allocations != 0 || memory.stats().bytes != 0)
+    {
+        return false;
+    }
+
+    auto local = epoch::place_actors(actors, epoch::NumaTopology::detect());
+    std::vector<int> ran_on(local.workers.size(), -1);
+    std::atomic<std::size_t> owned{0};
+    epoch::PinnedWorkers workers;
+    workers.start(local.workers, [&](std::size_t worker, const epoch::WorkerPlacement &placement) {
+#if defined(__linux__)
+        ran_on[worker] = sched_getcpu();
+#else
+        ran_on[worker] = placement.cpu;
+#endif
+        owned += placement.actors.size();
+    });
+    workers.join();
+    if (owned != actors.size())
+    {
+        return false;
+    }
+    for (std::size_t w = 0; w < local.workers.size() && workers.placement_failures() == 0; ++w)
+    {
+        if (ran_on[w] != local.workers[w].cpu)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool test_huge_pages()
+{
+    auto plain = epoch::map_pages(100, {epoch::HugePageMode::Off, true, false, -1});
+    auto transparent = epoch::map_pages(epoch::kHugePage2M + 1, {epoch::HugePageMode::Transparent, true, false, -1});
+    auto pooled = epoch::map_pages(4096, {epoch::HugePageMode::Explicit2M, true, false, -1});
+    if (!plain.ok() || !transparent.ok() || !pooled.ok() || plain.value().explicit_huge ||
+        transparent.value().length <= epoch::kHugePage2M)
+    {
+        return false;
+    }
+#if defined(__linux__)
+    // Hosts without a reserved pool fall back to transparent pages; either way the range is 2 MB granular.
+    if (transparent.value().length != 2 * epoch::kHugePage2M ||
+        reinterpret_cast<std::uintptr_t>(transparent.value().data) % epoch::kHugePage2M != 0 ||
+        pooled.value().length != epoch::kHugePage2M)
+    {
+        return false;
+    }
+#else
+    if (pooled.value().explicit_huge)
+    {
+        return false;
+    }
+#endif
+    static_cast<std::uint8_t *>(transparent.value().data)[epoch::kHugePage2M] = 7;
+    epoch::unmap_pages(plain.value());
+    epoch::unmap_pages(transparent.value());
+    epoch::unmap_pages(pooled.value());
+
+    std::vector<epoch::Message> messages = {{1, 1, 1, 1, 0, 0, 3}, {1, 2, 2, 1, 0, 240, 5}, {2, 1, 1, 2, 0, 9, 4}};
+    auto expected = epoch::process_messages(messages);
+    epoch::PageMemoryResource pages({epoch::HugePageMode::Explicit2M, true, false, -1});
+    {
+        epoch::InMemoryTransport transport;
+        for (const auto &message : messages)
+        {
+            transport.send(message);
+        }
+        epoch::RuntimeConfig config;
+        config.memory = &pages;
+        config.arena_reserve = 3 * epoch::EpochArena::kDefaultBlockSize;
+        epoch::EpochRuntime<> runtime(transport, config);
+        // Four lane rings, the poll buffer and three arena blocks, all faulted in by now.
+        if (pages.stats().allocations != 8 || pages.stats().explicit_huge + pages.stats().fallbacks != 8 ||
+            runtime.arena().block_count() != 3)
+        {
+            return false;
+        }
+        runtime.pump();
+        std::vector<std::int64_t> states;
+        runtime.seal(2, [&](std::int64_t, std::int64_t state, std::uint64_t) { states.push_back(state); });
+        if (states.size() != expected.size() || states.back() != expected.back().state ||
+            pages.stats().allocations != 8)
+        {
+            return false;
+        }
+
+        epoch::BroadcastRing<epoch::Message> ring(64, &pages);
+        auto reader = ring.reader();
+        ring.publish(messages[1]);
+        epoch::Message received{};
+        if (!reader.try_receive(received) || received.payload != 5)
+        {
+            return false;
+        }
+    }
+    if (pages.stats().allocations != 0 || pages.stats().bytes != 0)
+    {
+        return false;
+    }
+
+    auto dir = std::filesystem::temp_directory_path();
+    auto journal_path = (dir / "epoch_cpp_core_pages.journal").string();
+    std::remove(journal_path.c_str());
+    auto archive = epoch::LocalArchive::open(journal_path, &pages);
+    if (!archive.ok())
+    {
+        return false;
+    }
+    archive.value()->reserve(1024 * epoch::kFrameLength);
+    std::uint8_t frame[epoch::kFrameLength];
+    for (const auto &message : messages)
+    {
+        epoch::encode_frame(frame, message);
+        archive.value()->record(frame, sizeof(frame));
+    }
+    std::int64_t mapped = pages.stats().allocations;
+    epoch::ReplayTransport replay(*archive.value());
+    auto replayed = replay.poll(8);
+    archive.value().reset();
+    std::remove(journal_path.c_str());
+    if (mapped != 1 || replayed.size() != 3 || replayed[2].payload != 4)
+    {
+        return false;
+    }
+
+    auto vector_path = (dir / "epoch_cpp_core_pages.vector").string();
+    std::vector<epoch::EpochRecord> records;
+    for (const auto &record : expected)
+    {
+        records.push_back({record.epoch, record.state, 0, 0});
+    }
+    if (!epoch::write_vector_file(vector_path, messages, records).ok())
+    {
+        return false;
+    }
+    auto file = epoch::VectorFile::open(vector_path, {epoch::HugePageMode::Transparent, true, false, -1});
+    std::remove(vector_path.c_str());
+    epoch::Message decoded{};
+    return file.ok() && file.value()->message_count() == 3 && file.value()->message(2, decoded) &&
+           decoded.payload == 4 && file.value()->expected_count() == expected.size();
+}
+
+// Ordered point-to-point hop; InMemoryTransport reorders by QoS band, which replication does not allow.
+class FifoLink final : public epoch::Transport {
+public:
+    FifoLink(std::deque<epoch::Message> &out, std::deque<epoch::Message> &in) : out_(out), in_(in)
+    {
+    }
+
+    void send(const epoch::Message &message) override
+    {
+        out_.push_back(message);
+    }
+
+    std::vector<epoch::Message> poll(std::size_t max) override
+    {
+        std::vector<epoch::Message> batch;
+        while (!in_.empty() && batch.size() < max)
+        {
+            batch.push_back(in_.front());
+            in_.pop_front();
+        }
+        return batch;
+    }
+
+    void close() override
+    {
+    }
+
+private:
+    std::deque<epoch::Message> &out_;
+    std::deque<epoch::Message> &in_;
+};
+
+bool test_replicated_failover()
+{
+    std::deque<epoch::Message> to_backup;
+    std::deque<epoch::Message> to_primary;
+    FifoLink primary_link(to_backup, to_primary);
+    FifoLink backup_link(to_primary, to_backup);
+    epoch::InMemoryTransport primary_ingress;
+    epoch::InMemoryTransport backup_ingress;
+    epoch::ReplicaConfig primary_config;
+    primary_config.node_id = 1;
+    epoch::ReplicaConfig backup_config;
+    backup_config.node_id = 2;
+    epoch::ReplicatedRuntime<> primary(epoch::ReplicaRole::Primary, primary_ingress, primary_link, primary_config);
+    epoch::ReplicatedRuntime<> backup(epoch::ReplicaRole::Backup, backup_ingress, backup_link, backup_config);
+
+    std::vector<epoch::Message> inputs = {
+        {1, 1, 10, 1, 0, 0, 5},
+        {1, 1, 11, 1, 0, 200, 7},
+        {2, 1, 10, 2, 0, 0, -3},
+        {2, 2, 12, 1, 0, 9, 4},
+    };
+    std::vector<std::string> primary_hashes;
+    std::vector<std::string> backup_hashes;
+    for (std::int64_t epoch = 1; epoch <= 2; ++epoch)
+    {
+        for (const auto &message : inputs)
+        {
+            if (message.epoch == epoch)
+            {
+                primary_ingress.send(message);
+            }
+        }
+        primary.pump();
+        primary.seal(epoch, [&](std::int64_t, std::int64_t, std::uint64_t hash) {
+            primary_hashes.push_back(epoch::hash_hex(hash));
+        });
+        backup.pump([&](std::int64_t, std::int64_t, std::uint64_t hash) {
+            backup_hashes.push_back(epoch::hash_hex(hash));
+        });
+        primary.pump();
+    }
+    if (primary_hashes != backup_hashes || backup.state() != primary.state() || backup.last_sealed_epoch() != 2 ||
+        backup.primary_id() != 1 || primary.stats().hashes_matched != 2 || backup.stats().hashes_matched != 2 ||
+        primary.diverged() || backup.diverged() || backup.seal(2) != 0)
+    {
+        return false;
+    }
+
+    // The primary dies while publishing epoch 3: one input made it out, the marker did not.
+    epoch::Message partial{3, 1, 10, 3, 0, 0, 6};
+    to_backup.push_back(partial);
+    backup.pump();
+    backup.promote();
+    // Ingress shared with the old primary still holds input the backup already has through replication.
+    backup_ingress.send(inputs[2]);
+    backup_ingress.send(partial);
+    epoch::Message late{3, 2, 12, 2, 0, 0, 1};
+    backup_ingress.send(late);
+    backup.pump();
+    if (backup.role() != epoch::ReplicaRole::Primary || backup.seal(3) != 2 || backup.primary_id() != 2 ||
+        backup.stats().ingress_skipped != 2)
+    {
+        return false;
+    }
+    inputs.push_back(partial);
+    inputs.push_back(late);
+    auto expected = epoch::process_messages(inputs);
+    if (backup.state() != expected.back().state || backup.stats().promotions != 1)
+    {
+        return false;
+    }
+
+    // A partial batch larger than the backup's lanes still survives promotion in full.
+    std::deque<epoch::Message> to_small;
+    std::deque<epoch::Message> from_small;
+    FifoLink small_link(from_small, to_small);
+    epoch::InMemoryTransport small_ingress;
+    epoch::ReplicaConfig small_config = backup_config;
+    for (auto &lane : small_config.runtime.inbox.lanes)
+    {
+        lane = epoch::LaneConfig{2, 2};
+    }
+    epoch::ReplicatedRuntime<> small(epoch::ReplicaRole::Backup, small_ingress, small_link, small_config);
+    for (std::int64_t seq = 1; seq <= 8; ++seq)
+    {
+        to_small.push_back({1, 1, 10, seq, 0, 0, 1});
+    }
+    small.pump();
+    small.promote();
+    if (small.seal(1) != 8 || small.state() != 8)
+    {
+        return false;
+    }
+
+    // Replicated input lost in transit: the backup's hash disagrees and both sides flag the epoch.
+    std::deque<epoch::Message> lossy;
+    std::deque<epoch::Message> reports;
+    FifoLink lossy_primary_link(lossy, reports);
+    FifoLink lossy_backup_link(reports, lossy);
+    epoch::InMemoryTransport lossy_ingress;
+    epoch::InMemoryTransport idle_ingress;
+    epoch::ReplicatedRuntime<> lossy_primary(epoch::ReplicaRole::Primary, lossy_ingress, lossy_primary_link,
+                                             primary_config);
+    epoch::ReplicatedRuntime<> lossy_backup(epoch::ReplicaRole::Backup, idle_ingress, lossy_backup_link,
+                                            backup_config);
+    lossy_ingress.send(inputs[0]);
+    lossy_ingress.send(inputs[1]);
+    lossy_primary.pump();
+    lossy_primary.seal(1);
+    lossy.pop_front();
+    lossy_backup.pump();
+    lossy_primary.pump();
+    return lossy_backup.diverged() && lossy_backup.stats().first_divergent_epoch == 1 && lossy_primary.diverged() &&
+           lossy_primary.stats().first_divergent_epoch == 1;
+}
+
+bool test_broadcast_fan_out()
+{
+    epoch::BroadcastRing<epoch::Message> ring(4);
+    epoch::BroadcastTransport room(ring);
+    epoch::BroadcastTransport spectator(ring);
+    epoch::BroadcastTransport slow(ring);
+    for (std::int64_t seq = 1; seq <= 3; ++seq)
+    {
+        room.send(epoch::Message{1, 1, 1, seq, 0, 0, seq * 10});
+    }
+    auto seen = spectator.poll(8);
+    if (seen.size() != 3 || seen[2].payload != 30 || room.poll(2).size() != 2 || room.lag() != 1 ||
+        slow.lag() != 3)
+    {
+        return false;
+    }
+
+    for (std::int64_t seq = 4; seq <= 9; ++seq)
+    {
+        room.try_send(epoch::Message{1, 1, 1, seq, 0, 0, seq * 10});
+    }
+    // slow was lapped: it resumes after the oldest retained slot and counts the gap.
+    auto late = slow.poll(8);
+    if (late.empty() || late.back().payload != 90 || slow.lost() + static_cast<std::int64_t>(late.size()) != 9 ||
+        spectator.poll(8).size() != 4 || spectator.lost() != 2)
+    {
+        return false;
+    }
+
+    epoch::BroadcastRing<std::int64_t> values(64);
+    auto reader = values.reader();
+    constexpr std::int64_t kCount = 200000;
+    std::thread producer([&values] {
+        for (std::int64_t i = 0; i < kCount; ++i)
+        {
+            values.publish(i);
+        }
+    });
+    std::int64_t last = -1;
+    bool ordered = true;
+    while (last < kCount - 1)
+    {
+        std::int64_t value = 0;
+        if (reader.try_receive(value))
+        {
+            ordered = ordered && value > last;
+            last = value;
+        }
+    }
+    producer.join();
+    return ordered && reader.position() == static_cast<std::uint64_t>(kCount) && reader.lag() == 0 &&
+           expect_throw([] { epoch::BroadcastRing<int> empty(0); });
+}
+
+} // namespace
+
+int main()
+{
+    if (std::string(epoch::version()) != "0.1.0")
+    {
+        return 1;
+    }
+    if (!test_actor_id_errors())
+    {
+        return 1;
+    }
+    if (!test_engine_ordering_branches())
+    {
+        return 1;
+    }
+    if (!test_in_memory_transport())
+    {
+        return 1;
+    }
+    if (!test_schema_dispatch())
+    {
+        return 1;
+    }
+    if (!test_frame_codec())
+    {
+        return 1;
+    }
+    if (!test_tick_driver_virtual_time())
+    {
+        return 1;
+    }
+    if (!test_tick_driver_overrun_policies())
+    {
+        return 1;
+    }
+    if (!test_steady_clock_deadline())
+    {
+        return 1;
+    }
+    if (!test_engine_reducer())
+    {
+        return 1;
+    }
+    if (!test_state_digest())
+    {
+        return 1;
+    }
+    if (!test_priority_inbox())
+    {
+        return 1;
+    }
+    if (!test_runtime_seal())
+    {
+        return 1;
+    }
+    if (!test_runtime_lane_overflow())
+    {
+        return 1;
+    }
+    if (!test_runtime_late_input())
+    {
+        return 1;
+    }
+    if (!test_outbound_back_pressure())
+    {
+        return 1;
+    }
+    if (!test_archive_replay())
+    {
+        return 1;
+    }
+    if (!test_epoch_arena())
+    {
+        return 1;
+    }
+    if (!test_broadcast_fan_out())
+    {
+        return 1;
+    }
+    if (!test_replicated_failover())
+    {
+        return 1;
+    }
+    if (!test_sequencer_merge())
+    {
+        return 1;
+    }
+    if (!test_presorted_fast_path())
+    {
+        return 1;
+    }
+    if (!test_result_sinks())
+    {
+        return 1;
+    }
+    if (!test_failing_result_sink())
+    {
+        return 1;
+    }
+    if (!test_divergence_checker())
+    {
+        return 1;
+    }
+    if (!test_trace_export())
+    {
+        return 1;
+    }
+    if (!test_poll_budget())
+    {
+        return 1;
+    }
+    if (!test_numa_placement())
+    {
+        return 1;
+    }
+    if (!test_huge_pages())
     {
         return 1;
     }
@@ -2,21 +2,15 @@
 #include "epoch/engine.h"
 #include "epoch/epoch.h"
 #include "epoch/transport.h"
+#include "epoch/vector_file.h"
 
+#include <cstdio>
 #include <filesystem>
-#include <fstream>
-#include <sstream>
 #include <string>
 #include <vector>
 
 namespace {
 
-struct Expected {
-    std::int64_t epoch;
-    std::int64_t state;
-    std::string hash;
-};
-
 std::filesystem::path locate_vector_file()
 {
     auto current = std::filesystem::current_path();
@@ -36,63 +30,6 @@ std::filesystem::path locate_vector_file()
     return {};
 }
 
-void parse_vector_file(const std::filesystem::path &path,
-                       std::vector<epoch::Message> &messages,
-                       std::vector<Expected> &expected)
-{
-    std::ifstream in(path);
-    std::string line;
-    while (std::getline(in, line))
-    {
-        if (line.empty() || line[0] == '#')
-        {
-            continue;
-        }
-        std::stringstream ss(line);
-        std::string token;
-        std::vector<std::string> parts;
-        while (std::getline(ss, token, ','))
-        {
-            parts.push_back(token);
-        }
-        if (parts.empty())
-        {
-            continue;
-        }
-        if (parts[0] == "M" && (parts.size() == 7 || parts.size() == 8))
-        {
-            auto qos = static_cast<std::uint8_t>(0);
-            std::int64_t payload = 0;
-            if (parts.size() == 7)
-            {
-                payload = std::stoll(parts[6]);
-            }
-            else
-            {
-                qos = static_cast<std::uint8_t>(std::stoll(parts[6]));
-                payload = std::stoll(parts[7]);
-            }
-            messages.push_back({
-                std::stoll(parts[1]),
-                std::stoll(parts[2]),
-                std::stoll(parts[3]),
-                std::stoll(parts[4]),
-                std::stoll(parts[5]),
-                qos,
-                payload
-            });
-        }
-        else if (parts[0] == "E" && parts.size() == 4)
-        {
-            expected.push_back({
-                std::stoll(parts[1]),
-                std::stoll(parts[2]),
-                parts[3]
-            });
-        }
-    }
-}
-
 } // namespace
 
 int main()
@@ -179,14 +116,13 @@ int main()
     }
 
     std::vector<epoch::Message> messages;
-    std::vector<Expected> expected;
+    std::vector<epoch::EpochRecord> expected;
 
     auto path = locate_vector_file();
-    if (path.empty())
+    if (path.empty() || !epoch::read_text_vector(path.string(), messages, expected).ok())
     {
         return 1;
     }
-    parse_vector_file(path, messages, expected);
 
     auto results = epoch::process_messages(messages);
     if (results.size() != expected.size())
@@ -204,11 +140,49 @@ int main()
         {
             return 1;
         }
-        if (results[i].hash != expected[i].hash)
+        if (results[i].hash != epoch::hash_hex(expected[i].hash))
+        {
+            return 1;
+        }
+    }
+
+    // The binary form must replay to the same results straight from the mapping.
+    auto binary_path = (std::filesystem::temp_directory_path() / "epoch_cpp_vector_v1.bin").string();
+    if (!epoch::convert_text_vector(path.string(), binary_path).ok())
+    {
+        return 1;
+    }
+    auto vector = epoch::VectorFile::open(binary_path);
+    std::remove(binary_path.c_str());
+    if (!vector.ok() || vector.value()->message_count() != messages.size() ||
+        vector.value()->expected_count() != expected.size())
+    {
+        return 1;
+    }
+    std::vector<epoch::Message> mapped(vector.value()->message_count());
+    if (vector.value()->decode_messages(0, mapped.size(), mapped.data()) != mapped.size())
+    {
+        return 1;
+    }
+    auto mapped_results = epoch::process_messages(mapped);
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        epoch::EpochRecord record{};
+        if (!vector.value()->expected(i, record) || record.state != expected[i].state ||
+            record.digest != epoch::state_digest(record.state) || mapped_results[i].hash != results[i].hash)
         {
             return 1;
         }
     }
 
+    std::vector<epoch::Message> rejected;
+    std::size_t error_line = 0;
+    const char malformed[] = "# header\nM,1,1,1,1,1,5\nM,1,1,x,1,1,5\n";
+    if (epoch::parse_text_vector(malformed, sizeof(malformed) - 1, rejected, expected, &error_line).ok() ||
+        error_line != 3)
+    {
+        return 1;
+    }
+
     return 0;
 }
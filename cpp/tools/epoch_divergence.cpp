@@ -0,0 +1,212 @@
+// Cross-implementation divergence checker.
+//
+//   epoch_divergence generate <journal> [--messages N] [--epochs N] [--channels N] [--sources N] [--seed N]
+//   epoch_divergence run <journal> <results> [--threads N]
+//   epoch_divergence diff <left-results> <right-results>
+//
+// generate writes a deterministic randomized journal of v1 frames; every implementation replays it and writes a
+// results file (protocol.md); diff scans two results files in order for the first divergent epoch. Exit code
+// 0 = same, 1 = divergent, 2 = usage or I/O error.
+#include "epoch/divergence.h"
+#include "epoch/results.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace {
+
+constexpr int kExitSame = 0;
+constexpr int kExitDivergent = 1;
+constexpr int kExitError = 2;
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int usage()
+{
+    std::fprintf(stderr,
+                 "usage: epoch_divergence generate <journal> [--messages N] [--epochs N] [--channels N] "
+                 "[--sources N] [--seed N]\n"
+                 "       epoch_divergence run <journal> <results> [--threads N]\n"
+                 "       epoch_divergence diff <left-results> <right-results>\n");
+    return kExitError;
+}
+
+int fail(const epoch::Status &status)
+{
+    std::fprintf(stderr, "error: %s\n", status.message().c_str());
+    return kExitError;
+}
+
+bool read_flag(int argc, char **argv, int &i, const char *name, std::int64_t &value)
+{
+    if (std::strcmp(argv[i], name) != 0 || i + 1 >= argc)
+    {
+        return false;
+    }
+    value = std::atoll(argv[++i]);
+    return true;
+}
+
+int generate(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        return usage();
+    }
+    epoch::VectorSpec spec;
+    std::int64_t seed = static_cast<std::int64_t>(spec.seed);
+    for (int i = 3; i < argc; ++i)
+    {
+        if (!read_flag(argc, argv, i, "--messages", spec.messages) &&
+            !read_flag(argc, argv, i, "--epochs", spec.epochs) &&
+            !read_flag(argc, argv, i, "--channels", spec.channels) &&
+            !read_flag(argc, argv, i, "--sources", spec.sources) && !read_flag(argc, argv, i, "--seed", seed))
+        {
+            return usage();
+        }
+    }
+    spec.seed = static_cast<std::uint64_t>(seed);
+
+    auto start = std::chrono::steady_clock::now();
+    auto messages = epoch::generate_vector(spec);
+    auto status = epoch::write_journal(argv[2], messages);
+    if (!status.ok())
+    {
+        return fail(status);
+    }
+    std::printf("generated %zu messages into %s in %.3fs\n", messages.size(), argv[2], seconds_since(start));
+    return kExitSame;
+}
+
+int run(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        return usage();
+    }
+    std::int64_t threads = static_cast<std::int64_t>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 4; i < argc; ++i)
+    {
+        if (!read_flag(argc, argv, i, "--threads", threads))
+        {
+            return usage();
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto journal = epoch::read_journal(argv[2]);
+    if (!journal.ok())
+    {
+        return fail(journal.status());
+    }
+    double loaded = seconds_since(start);
+    auto worker_count = static_cast<std::size_t>(std::max<std::int64_t>(1, threads));
+    auto records = epoch::process_parallel(journal.value(), worker_count);
+    double processed = seconds_since(start);
+
+    auto sink = epoch::FileSink::open(argv[3]);
+    if (!sink.ok())
+    {
+        return fail(sink.status());
+    }
+    for (const auto &record : records)
+    {
+        sink.value()->write(record);
+    }
+    auto status = sink.value()->flush();
+    if (!status.ok())
+    {
+        return fail(status);
+    }
+    std::printf("%zu messages, %zu epochs, %lld threads: load %.3fs, process %.3fs, total %.3fs\n",
+                journal.value().size(),
+                records.size(),
+                static_cast<long long>(threads),
+                loaded,
+                processed - loaded,
+                seconds_since(start));
+    return kExitSame;
+}
+
+void print_record(const char *side, const epoch::EpochRecord &record)
+{
+    std::printf("  %s: epoch=%lld state=%lld hash=%s digest=%s\n",
+                side,
+                static_cast<long long>(record.epoch),
+                static_cast<long long>(record.state),
+                epoch::hash_hex(record.hash).c_str(),
+                epoch::hash_hex(record.digest).c_str());
+}
+
+int diff(int argc, char **argv)
+{
+    if (argc != 4)
+    {
+        return usage();
+    }
+    auto left = epoch::ResultFileReader::open(argv[2]);
+    if (!left.ok())
+    {
+        return fail(left.status());
+    }
+    auto right = epoch::ResultFileReader::open(argv[3]);
+    if (!right.ok())
+    {
+        return fail(right.status());
+    }
+    auto divergence = epoch::first_divergence(*left.value(), *right.value());
+    if (!divergence.ok())
+    {
+        return fail(divergence.status());
+    }
+    const auto &found = divergence.value();
+    if (!found.found)
+    {
+        std::printf("identical: %zu epochs (%zu probes)\n", left.value()->count(), found.probes);
+        return kExitSame;
+    }
+    if (found.length_mismatch)
+    {
+        std::printf("length mismatch: left %zu epochs, right %zu epochs; first %zu agree\n",
+                    left.value()->count(),
+                    right.value()->count(),
+                    found.index);
+        return kExitDivergent;
+    }
+    std::printf("first divergence at record %zu (%zu probes)\n", found.index, found.probes);
+    print_record("left ", found.left);
+    print_record("right", found.right);
+    return kExitDivergent;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        return usage();
+    }
+    std::string command = argv[1];
+    if (command == "generate")
+    {
+        return generate(argc, argv);
+    }
+    if (command == "run")
+    {
+        return run(argc, argv);
+    }
+    if (command == "diff")
+    {
+        return diff(argc, argv);
+    }
+    return usage();
+}
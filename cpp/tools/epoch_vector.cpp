@@ -0,0 +1,141 @@
+// Test vector converter and checker.
+//
+//   epoch_vector convert <text-vector> <binary-vector>
+//   epoch_vector check <binary-vector>
+//
+// convert turns the M/E line format (test-vectors/epoch_vector_v1.txt) into the binary vector format
+// (protocol.md); check maps a binary vector, replays its messages and compares every epoch with the expected
+// results. Exit code 0 = match, 1 = mismatch, 2 = usage or I/O error.
+#include "epoch/vector_file.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kExitMatch = 0;
+constexpr int kExitMismatch = 1;
+constexpr int kExitError = 2;
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int usage()
+{
+    std::fprintf(stderr,
+                 "usage: epoch_vector convert <text-vector> <binary-vector>\n"
+                 "       epoch_vector check <binary-vector>\n");
+    return kExitError;
+}
+
+int fail(const epoch::Status &status)
+{
+    std::fprintf(stderr, "error: %s\n", status.message().c_str());
+    return kExitError;
+}
+
+int convert(int argc, char **argv)
+{
+    if (argc != 4)
+    {
+        return usage();
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<epoch::Message> messages;
+    std::vector<epoch::EpochRecord> expected;
+    std::size_t error_line = 0;
+    auto status = epoch::read_text_vector(argv[2], messages, expected, &error_line);
+    if (!status.ok())
+    {
+        if (error_line > 0)
+        {
+            std::fprintf(stderr, "%s:%zu: ", argv[2], error_line);
+        }
+        return fail(status);
+    }
+    status = epoch::write_vector_file(argv[3], messages, expected);
+    if (!status.ok())
+    {
+        return fail(status);
+    }
+    std::printf("converted %zu messages, %zu expected epochs in %.3fs\n",
+                messages.size(),
+                expected.size(),
+                seconds_since(start));
+    return kExitMatch;
+}
+
+int check(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        return usage();
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto vector = epoch::VectorFile::open(argv[2]);
+    if (!vector.ok())
+    {
+        return fail(vector.status());
+    }
+    double opened = seconds_since(start);
+    std::vector<epoch::Message> messages(vector.value()->message_count());
+    if (vector.value()->decode_messages(0, messages.size(), messages.data()) != messages.size())
+    {
+        return fail(epoch::Status(epoch::ErrorCode::InvalidArgument, "vector frame has wrong version"));
+    }
+    double decoded = seconds_since(start);
+
+    auto results = epoch::process_messages(messages);
+    if (results.size() != vector.value()->expected_count())
+    {
+        std::printf("mismatch: %zu epochs produced, %zu expected\n", results.size(), vector.value()->expected_count());
+        return kExitMismatch;
+    }
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        epoch::EpochRecord record{};
+        vector.value()->expected(i, record);
+        if (results[i].epoch != record.epoch || results[i].state != record.state ||
+            results[i].hash != epoch::hash_hex(record.hash))
+        {
+            std::printf("mismatch at epoch %lld: state %lld hash %s, expected state %lld hash %s\n",
+                        static_cast<long long>(results[i].epoch),
+                        static_cast<long long>(results[i].state),
+                        results[i].hash.c_str(),
+                        static_cast<long long>(record.state),
+                        epoch::hash_hex(record.hash).c_str());
+            return kExitMismatch;
+        }
+    }
+    std::printf("%zu messages, %zu epochs match: open %.3fs, decode %.3fs, total %.3fs\n",
+                messages.size(),
+                results.size(),
+                opened,
+                decoded - opened,
+                seconds_since(start));
+    return kExitMatch;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        return usage();
+    }
+    std::string command = argv[1];
+    if (command == "convert")
+    {
+        return convert(argc, argv);
+    }
+    if (command == "check")
+    {
+        return check(argc, argv);
+    }
+    return usage();
+}
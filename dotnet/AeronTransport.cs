@@ -51,6 +51,24 @@ public sealed class AeronTransport : ITransport
         native.Send(handle, frame);
     }
 
+    public void SendBatch(IReadOnlyList<Message> messages)
+    {
+        if (closed)
+        {
+            throw new InvalidOperationException("Aeron transport closed");
+        }
+        if (messages.Count == 0)
+        {
+            return;
+        }
+        var frames = new byte[messages.Count * FrameLength];
+        for (var i = 0; i < messages.Count; i++)
+        {
+            EncodeFrame(messages[i], frames.AsSpan(i * FrameLength, FrameLength));
+        }
+        native.SendBatch(handle, frames, messages.Count);
+    }
+
     public List<Message> Poll(int max)
     {
         if (closed || max <= 0)
@@ -79,15 +97,20 @@ public sealed class AeronTransport : ITransport
     private static byte[] EncodeFrame(Message message)
     {
         var buffer = new byte[FrameLength];
+        EncodeFrame(message, buffer);
+        return buffer;
+    }
+
+    private static void EncodeFrame(Message message, Span<byte> buffer)
+    {
         buffer[0] = FrameVersion;
         buffer[1] = message.Qos;
-        BinaryPrimitives.WriteInt64LittleEndian(buffer.AsSpan(8, 8), message.Epoch);
-        BinaryPrimitives.WriteInt64LittleEndian(buffer.AsSpan(16, 8), message.ChannelId);
-        BinaryPrimitives.WriteInt64LittleEndian(buffer.AsSpan(24, 8), message.SourceId);
-        BinaryPrimitives.WriteInt64LittleEndian(buffer.AsSpan(32, 8), message.SourceSeq);
-        BinaryPrimitives.WriteInt64LittleEndian(buffer.AsSpan(40, 8), message.SchemaId);
-        BinaryPrimitives.WriteInt64LittleEndian(buffer.AsSpan(48, 8), message.Payload);
-        return buffer;
+        BinaryPrimitives.WriteInt64LittleEndian(buffer.Slice(8, 8), message.Epoch);
+        BinaryPrimitives.WriteInt64LittleEndian(buffer.Slice(16, 8), message.ChannelId);
+        BinaryPrimitives.WriteInt64LittleEndian(buffer.Slice(24, 8), message.SourceId);
+        BinaryPrimitives.WriteInt64LittleEndian(buffer.Slice(32, 8), message.SourceSeq);
+        BinaryPrimitives.WriteInt64LittleEndian(buffer.Slice(40, 8), message.SchemaId);
+        BinaryPrimitives.WriteInt64LittleEndian(buffer.Slice(48, 8), message.Payload);
     }
 
     private static Message DecodeFrame(byte[] buffer)
@@ -114,6 +137,7 @@ public sealed class AeronTransport : ITransport
     {
         IntPtr Open(AeronConfig config);
         void Send(IntPtr transport, byte[] frame);
+        void SendBatch(IntPtr transport, byte[] frames, int count);
         List<byte[]> Poll(IntPtr transport, int max);
         AeronStats Stats(IntPtr transport);
         void Close(IntPtr transport);
@@ -166,11 +190,22 @@ public sealed class AeronTransport : ITransport
             }
         }
 
+        public void SendBatch(IntPtr transport, byte[] frames, int count)
+        {
+            var error = new StringBuilder(256);
+            var result = NativeMethods.epoch_aeron_send_batch(
+                transport, frames, (UIntPtr)count, out var sent, error, (UIntPtr)error.Capacity);
+            if (result < 0)
+            {
+                throw new InvalidOperationException($"{error} (sent {(ulong)sent} of {count})");
+            }
+        }
+
         public List<byte[]> Poll(IntPtr transport, int max)
         {
             var error = new StringBuilder(256);
             var buffer = new byte[max * FrameLength];
-            var result = NativeMethods.epoch_aeron_poll(
+            var result = NativeMethods.epoch_aeron_poll_batch(
                 transport, buffer, (UIntPtr)max, out var count, error, (UIntPtr)error.Capacity);
             if (result < 0)
             {
@@ -254,7 +289,16 @@ public sealed class AeronTransport : ITransport
             UIntPtr errorLen);
 
         [DllImport("epoch_aeron", CallingConvention = CallingConvention.Cdecl)]
-        internal static extern int epoch_aeron_poll(
+        internal static extern int epoch_aeron_send_batch(
+            IntPtr transport,
+            byte[] frames,
+            UIntPtr frameCount,
+            out UIntPtr outSent,
+            StringBuilder error,
+            UIntPtr errorLen);
+
+        [DllImport("epoch_aeron", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int epoch_aeron_poll_batch(
             IntPtr transport,
             byte[] frames,
             UIntPtr frameCapacity,
@@ -1,3 +1,4 @@
+using System.Buffers.Binary;
 using System.Globalization;
 
 namespace Epoch;
@@ -26,16 +27,40 @@ public readonly struct Message
 
 public readonly struct EpochResult
 {
-    public EpochResult(long epoch, long state, string hash)
+    public EpochResult(long epoch, long state, string hash, string digest = "")
     {
         Epoch = epoch;
         State = state;
         Hash = hash;
+        Digest = digest;
     }
 
     public long Epoch { get; }
     public long State { get; }
     public string Hash { get; }
+    public string Digest { get; }
+}
+
+// Order-independent multiset digest from behavior.md: the sum of entry hashes mod 2^64.
+public sealed class StateDigest
+{
+    public ulong Value { get; private set; }
+
+    public void Add(ulong key, ReadOnlySpan<byte> value) => Value += Engine.DigestEntry(key, value);
+
+    public void Remove(ulong key, ReadOnlySpan<byte> value) => Value -= Engine.DigestEntry(key, value);
+
+    public void Add(ulong key, long value) => Value += Engine.DigestEntry(key, value);
+
+    public void Remove(ulong key, long value) => Value -= Engine.DigestEntry(key, value);
+
+    public void Replace(ulong key, long oldValue, long newValue)
+    {
+        Remove(key, oldValue);
+        Add(key, newValue);
+    }
+
+    public string ToHex() => Value.ToString("x16", CultureInfo.InvariantCulture);
 }
 
 public static class Engine
@@ -55,6 +80,47 @@ public static class Engine
         return hash.ToString("x16", CultureInfo.InvariantCulture);
     }
 
+    private static ulong Mix64(ulong value)
+    {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9UL;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebUL;
+        value ^= value >> 31;
+        return value;
+    }
+
+    // mix64(fnv1a64(le64(key) || value)).
+    public static ulong DigestEntry(ulong key, ReadOnlySpan<byte> value)
+    {
+        ulong hash = FnvOffsetBasis;
+        for (var i = 0; i < 8; i++)
+        {
+            hash ^= (byte)(key >> (8 * i));
+            hash *= FnvPrime;
+        }
+        foreach (var b in value)
+        {
+            hash ^= b;
+            hash *= FnvPrime;
+        }
+
+        return Mix64(hash);
+    }
+
+    public static ulong DigestEntry(ulong key, long value)
+    {
+        Span<byte> data = stackalloc byte[8];
+        BinaryPrimitives.WriteInt64LittleEndian(data, value);
+        return DigestEntry(key, data);
+    }
+
+    // The sum model's digest: the single entry (0, state).
+    public static string StateDigestHex(long state)
+    {
+        return DigestEntry(0, state).ToString("x16", CultureInfo.InvariantCulture);
+    }
+
     public static IReadOnlyList<EpochResult> ProcessMessages(List<Message> messages)
     {
         messages.Sort((a, b) =>
@@ -84,7 +150,7 @@ public static class Engine
             }
             if (message.Epoch != currentEpoch)
             {
-                results.Add(new EpochResult(currentEpoch, state, Fnv1A64Hex($"state:{state}")));
+                results.Add(new EpochResult(currentEpoch, state, Fnv1A64Hex($"state:{state}"), StateDigestHex(state)));
                 currentEpoch = message.Epoch;
             }
             state += message.Payload;
@@ -92,7 +158,7 @@ public static class Engine
 
         if (hasEpoch)
         {
-            results.Add(new EpochResult(currentEpoch, state, Fnv1A64Hex($"state:{state}")));
+            results.Add(new EpochResult(currentEpoch, state, Fnv1A64Hex($"state:{state}"), StateDigestHex(state)));
         }
 
         return results;
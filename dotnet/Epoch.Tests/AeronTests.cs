@@ -26,6 +26,25 @@ public class AeronTests
         Assert.Empty(transport.Poll(1));
     }
 
+    [Fact]
+    public void AeronTransportSendBatch()
+    {
+        var native = new FakeNative();
+        var transport = new AeronTransport(new AeronTransport.AeronConfig("aeron:ipc", 1, ""), native);
+        transport.SendBatch(new List<Message>());
+        transport.SendBatch(new List<Message>
+        {
+            new(1, 1, 1, 1, 1, 0, 10),
+            new(1, 1, 1, 2, 1, 0, 20),
+            new(1, 1, 1, 3, 1, 0, 30),
+        });
+
+        var batch = transport.Poll(8);
+        Assert.Equal(3, batch.Count);
+        Assert.Equal(20, batch[1].Payload);
+        Assert.Equal(3, batch[2].SourceSeq);
+    }
+
     private sealed class FakeNative : AeronTransport.IAeronNative
     {
         private readonly Queue<byte[]> frames = new();
@@ -34,6 +53,14 @@ public class AeronTests
 
         public void Send(IntPtr transport, byte[] frame) => frames.Enqueue(frame);
 
+        public void SendBatch(IntPtr transport, byte[] batch, int count)
+        {
+            for (var i = 0; i < count; i++)
+            {
+                frames.Enqueue(batch.AsSpan(i * 56, 56).ToArray());
+            }
+        }
+
         public List<byte[]> Poll(IntPtr transport, int max)
         {
             var output = new List<byte[]>();
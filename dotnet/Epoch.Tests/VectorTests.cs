@@ -75,6 +75,30 @@ public class VectorTests
         Assert.Equal("a430d84680aabd0b", Engine.Fnv1A64Hex("hello"));
     }
 
+    [Fact]
+    public void StateDigestMatchesKnownValues()
+    {
+        Assert.Equal("68752350ae1d483f", Engine.StateDigestHex(0));
+
+        var forward = new StateDigest();
+        forward.Add(7, "bid"u8);
+        forward.Add(3, -5L);
+        Assert.Equal("beba82641d751f3b", forward.ToHex());
+
+        var backward = new StateDigest();
+        backward.Add(3, 1L);
+        backward.Add(7, "bid"u8);
+        backward.Replace(3, 1, -5);
+        Assert.Equal(forward.Value, backward.Value);
+
+        backward.Remove(7, "bid"u8);
+        backward.Remove(3, -5L);
+        Assert.Equal(0UL, backward.Value);
+
+        var results = Engine.ProcessMessages(new List<Message> { new(1, 1, 1, 1, 100, 0, 10) });
+        Assert.Equal("b492f0b01aa70577", results[0].Digest);
+    }
+
     [Fact]
     public void ProcessMessagesEmpty()
     {
@@ -78,9 +78,21 @@ var (
 			C.size_t(len(errBuf)),
 		))
 	}
+	aeronSendBatch = func(handle aeronHandle, frames []byte, count int, errBuf []byte) (int, int) {
+		var sent C.size_t
+		result := C.epoch_aeron_send_batch(
+			(*C.epoch_aeron_transport_t)(handle),
+			(*C.uint8_t)(unsafe.Pointer(&frames[0])),
+			C.size_t(count),
+			&sent,
+			(*C.char)(unsafe.Pointer(&errBuf[0])),
+			C.size_t(len(errBuf)),
+		)
+		return int(result), int(sent)
+	}
 	aeronPoll = func(handle aeronHandle, frameBuf []byte, max int, errBuf []byte) (int, int) {
 		var count C.size_t
-		result := C.epoch_aeron_poll(
+		result := C.epoch_aeron_poll_batch(
 			(*C.epoch_aeron_transport_t)(handle),
 			(*C.uint8_t)(unsafe.Pointer(&frameBuf[0])),
 			C.size_t(max),
@@ -165,6 +177,29 @@ func (t *AeronTransport) Send(message Message) {
 	}
 }
 
+// SendBatch encodes all messages into one buffer and crosses the FFI boundary once.
+func (t *AeronTransport) SendBatch(messages []Message) {
+	if t.closed {
+		panic(fmt.Errorf("aeron transport closed"))
+	}
+	if len(messages) == 0 {
+		return
+	}
+	frames := make([]byte, len(messages)*aeronFrameLength)
+	for i, message := range messages {
+		frame, err := encodeAeronFrame(message)
+		if err != nil {
+			panic(err)
+		}
+		copy(frames[i*aeronFrameLength:], frame)
+	}
+	errBuf := make([]byte, 256)
+	result, sent := aeronSendBatch(t.handle, frames, len(messages), errBuf)
+	if result < 0 {
+		panic(fmt.Errorf("aeron send batch failed after %d of %d: %s", sent, len(messages), trimCString(errBuf)))
+	}
+}
+
 func (t *AeronTransport) Poll(max int) []Message {
 	if t.closed || max <= 0 {
 		return nil
@@ -8,16 +8,18 @@ import (
 )
 
 type aeronStubSet struct {
-	open  func(AeronConfig, []byte) aeronHandle
-	send  func(aeronHandle, []byte, []byte) int
-	poll  func(aeronHandle, []byte, int, []byte) (int, int)
-	stats func(aeronHandle, *AeronStats) int
-	close func(aeronHandle)
+	open      func(AeronConfig, []byte) aeronHandle
+	send      func(aeronHandle, []byte, []byte) int
+	sendBatch func(aeronHandle, []byte, int, []byte) (int, int)
+	poll      func(aeronHandle, []byte, int, []byte) (int, int)
+	stats     func(aeronHandle, *AeronStats) int
+	close     func(aeronHandle)
 }
 
 func withAeronStubs(stubs aeronStubSet, fn func()) {
 	origOpen := aeronOpen
 	origSend := aeronSend
+	origSendBatch := aeronSendBatch
 	origPoll := aeronPoll
 	origStats := aeronStats
 	origClose := aeronClose
@@ -27,6 +29,9 @@ func withAeronStubs(stubs aeronStubSet, fn func()) {
 	if stubs.send != nil {
 		aeronSend = stubs.send
 	}
+	if stubs.sendBatch != nil {
+		aeronSendBatch = stubs.sendBatch
+	}
 	if stubs.poll != nil {
 		aeronPoll = stubs.poll
 	}
@@ -39,6 +44,7 @@ func withAeronStubs(stubs aeronStubSet, fn func()) {
 	defer func() {
 		aeronOpen = origOpen
 		aeronSend = origSend
+		aeronSendBatch = origSendBatch
 		aeronPoll = origPoll
 		aeronStats = origStats
 		aeronClose = origClose
@@ -235,3 +241,41 @@ func TestAeronTransportClosedSend(t *testing.T) {
 		}
 	})
 }
+
+func TestAeronTransportSendBatch(t *testing.T) {
+	dummy := byte(0)
+	handle := aeronHandle(unsafe.Pointer(&dummy))
+	var captured []Message
+	withAeronStubs(aeronStubSet{
+		open: func(config AeronConfig, errBuf []byte) aeronHandle {
+			return handle
+		},
+		sendBatch: func(h aeronHandle, frames []byte, count int, errBuf []byte) (int, int) {
+			if len(frames) != count*aeronFrameLength {
+				t.Fatalf("unexpected batch length")
+			}
+			for i := 0; i < count; i++ {
+				message, err := decodeAeronFrame(frames[i*aeronFrameLength : (i+1)*aeronFrameLength])
+				if err != nil {
+					t.Fatalf("decode failed: %v", err)
+				}
+				captured = append(captured, message)
+			}
+			if count > 2 {
+				writeErr(errBuf, "back pressured")
+				return -1, 2
+			}
+			return 0, count
+		},
+	}, func() {
+		transport := NewAeronTransport(AeronConfig{Channel: "aeron:ipc", StreamID: 1})
+		transport.SendBatch(nil)
+		transport.SendBatch([]Message{{SourceSeq: 1, Payload: 10}, {SourceSeq: 2, Payload: 20}})
+		if len(captured) != 2 || captured[1].Payload != 20 {
+			t.Fatalf("unexpected batch contents")
+		}
+		assertPanic(t, "after 2 of 3", func() {
+			transport.SendBatch([]Message{{Payload: 1}, {Payload: 2}, {Payload: 3}})
+		})
+	})
+}
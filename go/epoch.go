@@ -1,6 +1,9 @@
 package epoch
 
-import "fmt"
+import (
+	"encoding/binary"
+	"fmt"
+)
 
 func Version() string {
 	return "0.1.0"
@@ -17,9 +20,10 @@ type Message struct {
 }
 
 type EpochResult struct {
-	Epoch int64
-	State int64
-	Hash  string
+	Epoch  int64
+	State  int64
+	Hash   string
+	Digest string
 }
 
 func Fnv1a64Hex(input string) string {
@@ -33,6 +37,78 @@ func Fnv1a64Hex(input string) string {
 	return fmt.Sprintf("%016x", hash)
 }
 
+const (
+	fnvOffsetBasis uint64 = 0xcbf29ce484222325
+	fnvPrime       uint64 = 0x100000001b3
+)
+
+func mix64(value uint64) uint64 {
+	value ^= value >> 30
+	value *= 0xbf58476d1ce4e5b9
+	value ^= value >> 27
+	value *= 0x94d049bb133111eb
+	value ^= value >> 31
+	return value
+}
+
+// DigestEntry hashes one (key, value) state entry: mix64(fnv1a64(le64(key) || value)).
+func DigestEntry(key uint64, value []byte) uint64 {
+	hash := fnvOffsetBasis
+	var prefix [8]byte
+	binary.LittleEndian.PutUint64(prefix[:], key)
+	for _, b := range prefix {
+		hash ^= uint64(b)
+		hash *= fnvPrime
+	}
+	for _, b := range value {
+		hash ^= uint64(b)
+		hash *= fnvPrime
+	}
+	return mix64(hash)
+}
+
+// DigestEntryInt64 hashes an entry whose value is an int64, encoded as 8 little-endian bytes.
+func DigestEntryInt64(key uint64, value int64) uint64 {
+	var data [8]byte
+	binary.LittleEndian.PutUint64(data[:], uint64(value))
+	return DigestEntry(key, data[:])
+}
+
+// StateDigest is the order-independent multiset digest from behavior.md: the sum of entry hashes mod 2^64.
+type StateDigest struct {
+	Value uint64
+}
+
+func (d *StateDigest) Add(key uint64, value []byte) {
+	d.Value += DigestEntry(key, value)
+}
+
+func (d *StateDigest) Remove(key uint64, value []byte) {
+	d.Value -= DigestEntry(key, value)
+}
+
+func (d *StateDigest) AddInt64(key uint64, value int64) {
+	d.Value += DigestEntryInt64(key, value)
+}
+
+func (d *StateDigest) RemoveInt64(key uint64, value int64) {
+	d.Value -= DigestEntryInt64(key, value)
+}
+
+func (d *StateDigest) ReplaceInt64(key uint64, oldValue, newValue int64) {
+	d.RemoveInt64(key, oldValue)
+	d.AddInt64(key, newValue)
+}
+
+func (d *StateDigest) Hex() string {
+	return fmt.Sprintf("%016x", d.Value)
+}
+
+// StateDigestHex is the sum model's digest: the single entry (0, state).
+func StateDigestHex(state int64) string {
+	return fmt.Sprintf("%016x", DigestEntryInt64(0, state))
+}
+
 func ProcessMessages(messages []Message) []EpochResult {
 	sortMessages(messages)
 	results := make([]EpochResult, 0)
@@ -47,9 +123,10 @@ func ProcessMessages(messages []Message) []EpochResult {
 		}
 		if message.Epoch != currentEpoch {
 			results = append(results, EpochResult{
-				Epoch: currentEpoch,
-				State: state,
-				Hash:  Fnv1a64Hex(fmt.Sprintf("state:%d", state)),
+				Epoch:  currentEpoch,
+				State:  state,
+				Hash:   Fnv1a64Hex(fmt.Sprintf("state:%d", state)),
+				Digest: StateDigestHex(state),
 			})
 			currentEpoch = message.Epoch
 		}
@@ -57,9 +134,10 @@ func ProcessMessages(messages []Message) []EpochResult {
 	}
 	if hasEpoch {
 		results = append(results, EpochResult{
-			Epoch: currentEpoch,
-			State: state,
-			Hash:  Fnv1a64Hex(fmt.Sprintf("state:%d", state)),
+			Epoch:  currentEpoch,
+			State:  state,
+			Hash:   Fnv1a64Hex(fmt.Sprintf("state:%d", state)),
+			Digest: StateDigestHex(state),
 		})
 	}
 	return results
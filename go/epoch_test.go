@@ -98,6 +98,34 @@ func TestFnv1a64Hex(t *testing.T) {
 	}
 }
 
+func TestStateDigest(t *testing.T) {
+	if got := StateDigestHex(0); got != "68752350ae1d483f" {
+		t.Fatalf("unexpected digest for state 0: %s", got)
+	}
+	var forward StateDigest
+	forward.Add(7, []byte("bid"))
+	forward.AddInt64(3, -5)
+	if got := forward.Hex(); got != "beba82641d751f3b" {
+		t.Fatalf("unexpected digest: %s", got)
+	}
+	var backward StateDigest
+	backward.AddInt64(3, 1)
+	backward.Add(7, []byte("bid"))
+	backward.ReplaceInt64(3, 1, -5)
+	if backward.Value != forward.Value {
+		t.Fatalf("digest depends on order: %x vs %x", backward.Value, forward.Value)
+	}
+	backward.Remove(7, []byte("bid"))
+	backward.RemoveInt64(3, -5)
+	if backward.Value != 0 {
+		t.Fatalf("digest not empty after removals: %x", backward.Value)
+	}
+	results := ProcessMessages([]Message{{Epoch: 1, ChannelID: 1, SourceID: 1, SourceSeq: 1, SchemaID: 100, Payload: 10}})
+	if len(results) != 1 || results[0].Digest != "b492f0b01aa70577" {
+		t.Fatalf("unexpected result digest: %+v", results)
+	}
+}
+
 func TestProcessMessagesEmpty(t *testing.T) {
 	results := ProcessMessages(nil)
 	if len(results) != 0 {
@@ -35,11 +35,51 @@ public final class Engine {
         public final long epoch;
         public final long state;
         public final String hash;
+        public final String digest;
 
         public EpochResult(long epoch, long state, String hash) {
+            this(epoch, state, hash, "");
+        }
+
+        public EpochResult(long epoch, long state, String hash, String digest) {
             this.epoch = epoch;
             this.state = state;
             this.hash = hash;
+            this.digest = digest;
+        }
+    }
+
+    /** Order-independent multiset digest from behavior.md: the sum of entry hashes mod 2^64. */
+    public static final class StateDigest {
+        private long value;
+
+        public long value() {
+            return value;
+        }
+
+        public void add(long key, byte[] entryValue) {
+            value += digestEntry(key, entryValue);
+        }
+
+        public void remove(long key, byte[] entryValue) {
+            value -= digestEntry(key, entryValue);
+        }
+
+        public void add(long key, long entryValue) {
+            value += digestEntry(key, entryValue);
+        }
+
+        public void remove(long key, long entryValue) {
+            value -= digestEntry(key, entryValue);
+        }
+
+        public void replace(long key, long oldValue, long newValue) {
+            remove(key, oldValue);
+            add(key, newValue);
+        }
+
+        public String hex() {
+            return toHex(value);
         }
     }
 
@@ -53,6 +93,33 @@ public final class Engine {
         return toHex(hash);
     }
 
+    /** mix64(fnv1a64(le64(key) || value)). */
+    public static long digestEntry(long key, byte[] value) {
+        long hash = FNV_OFFSET_BASIS;
+        for (int i = 0; i < 8; i++) {
+            hash ^= (key >>> (8 * i)) & 0xffL;
+            hash *= FNV_PRIME;
+        }
+        for (byte b : value) {
+            hash ^= (b & 0xffL);
+            hash *= FNV_PRIME;
+        }
+        return mix64(hash);
+    }
+
+    public static long digestEntry(long key, long value) {
+        byte[] bytes = new byte[8];
+        for (int i = 0; i < 8; i++) {
+            bytes[i] = (byte) (value >>> (8 * i));
+        }
+        return digestEntry(key, bytes);
+    }
+
+    /** The sum model's digest: the single entry (0, state). */
+    public static String stateDigestHex(long state) {
+        return toHex(digestEntry(0, state));
+    }
+
     public static List<EpochResult> processMessages(List<Message> messages) {
         messages.sort(Comparator
             .comparingLong((Message m) -> m.epoch)
@@ -72,19 +139,28 @@ public final class Engine {
                 hasEpoch = true;
             }
             if (message.epoch != currentEpoch) {
-                results.add(new EpochResult(currentEpoch, state, fnv1a64Hex("state:" + state)));
+                results.add(new EpochResult(currentEpoch, state, fnv1a64Hex("state:" + state), stateDigestHex(state)));
                 currentEpoch = message.epoch;
             }
             state += message.payload;
         }
 
         if (hasEpoch) {
-            results.add(new EpochResult(currentEpoch, state, fnv1a64Hex("state:" + state)));
+            results.add(new EpochResult(currentEpoch, state, fnv1a64Hex("state:" + state), stateDigestHex(state)));
         }
 
         return results;
     }
 
+    private static long mix64(long value) {
+        value ^= value >>> 30;
+        value *= 0xbf58476d1ce4e5b9L;
+        value ^= value >>> 27;
+        value *= 0x94d049bb133111ebL;
+        value ^= value >>> 31;
+        return value;
+    }
+
     private static String toHex(long value) {
         String hex = Long.toUnsignedString(value, 16);
         if (hex.length() >= 16) {
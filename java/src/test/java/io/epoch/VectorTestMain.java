@@ -11,6 +11,24 @@ public final class VectorTestMain {
         ensure("c3c43df01be7b59c".equals(Engine.fnv1a64Hex("state:0")), "Hash mismatch");
         ensure("a430d84680aabd0b".equals(Engine.fnv1a64Hex("hello")), "Hash mismatch");
         ensure(Engine.processMessages(new ArrayList<>()).isEmpty(), "Empty process failed");
+
+        ensure("68752350ae1d483f".equals(Engine.stateDigestHex(0)), "State digest mismatch");
+        Engine.StateDigest forward = new Engine.StateDigest();
+        forward.add(7, "bid".getBytes(java.nio.charset.StandardCharsets.UTF_8));
+        forward.add(3, -5L);
+        ensure("beba82641d751f3b".equals(forward.hex()), "State digest mismatch");
+        Engine.StateDigest backward = new Engine.StateDigest();
+        backward.add(3, 1L);
+        backward.add(7, "bid".getBytes(java.nio.charset.StandardCharsets.UTF_8));
+        backward.replace(3, 1, -5);
+        ensure(backward.value() == forward.value(), "State digest depends on order");
+        backward.remove(7, "bid".getBytes(java.nio.charset.StandardCharsets.UTF_8));
+        backward.remove(3, -5L);
+        ensure(backward.value() == 0, "State digest not empty after removals");
+        List<Engine.Message> digestMessages = new ArrayList<>();
+        digestMessages.add(new Engine.Message(1, 1, 1, 1, 100, 0, 10));
+        ensure("b492f0b01aa70577".equals(Engine.processMessages(digestMessages).get(0).digest),
+            "Result digest mismatch");
         ActorId.Parts actorParts = new ActorId.Parts(1, 2, 3, 4, 5);
         long actorId = ActorId.encode(actorParts);
         ActorId.Parts decoded = ActorId.decode(actorId);
@@ -10,6 +10,38 @@ extern "C" {
 #define EPOCH_AERON_FRAME_LENGTH 56
 
 typedef struct epoch_aeron_transport epoch_aeron_transport_t;
+typedef struct epoch_aeron_ring epoch_aeron_ring_t;
+
+/*
+ * Shared ring region layout. All offsets are bytes from the region base; indices are monotonically
+ * increasing uint64 counters (slot = index & (capacity - 1)), each on its own cache line.
+ * inbound: I/O thread produces, host consumes. outbound: host produces, I/O thread consumes.
+ * Producers write the frame then store tail with release; consumers load tail with acquire.
+ * Hosts without C11 atomics (e.g. Python over ctypes) go through epoch_aeron_ring_publish,
+ * epoch_aeron_ring_inbound_tail and epoch_aeron_ring_consume for those index accesses.
+ * status: 0 while the subscription polls cleanly, else the negative result of the failed poll or of a
+ * terminal offer (publication closed, max position exceeded); the I/O thread stops polling inbound and
+ * offering outbound once it is set.
+ * outbound_status: the last offer result (a negative AERON_PUBLICATION_* code) while outbound frames
+ * are waiting, 0 once an offer goes through; the I/O thread parks between retries instead of spinning.
+ */
+#define EPOCH_AERON_RING_MAGIC 0x474E5245u
+#define EPOCH_AERON_RING_VERSION 1
+#define EPOCH_AERON_RING_OFFSET_MAGIC 0
+#define EPOCH_AERON_RING_OFFSET_VERSION 4
+#define EPOCH_AERON_RING_OFFSET_FRAME_LENGTH 8
+#define EPOCH_AERON_RING_OFFSET_CAPACITY 16
+#define EPOCH_AERON_RING_OFFSET_INBOUND_FRAMES 24
+#define EPOCH_AERON_RING_OFFSET_OUTBOUND_FRAMES 32
+#define EPOCH_AERON_RING_OFFSET_INBOUND_TAIL 64
+#define EPOCH_AERON_RING_OFFSET_INBOUND_HEAD 128
+#define EPOCH_AERON_RING_OFFSET_OUTBOUND_TAIL 192
+#define EPOCH_AERON_RING_OFFSET_OUTBOUND_HEAD 256
+#define EPOCH_AERON_RING_OFFSET_IO_PARKED 320
+#define EPOCH_AERON_RING_OFFSET_HOST_PARKED 384
+#define EPOCH_AERON_RING_OFFSET_STATUS 448
+#define EPOCH_AERON_RING_OFFSET_OUTBOUND_STATUS 452
+#define EPOCH_AERON_RING_HEADER_LENGTH 512
 
 typedef struct epoch_aeron_config
 {
@@ -34,6 +66,15 @@ typedef struct epoch_aeron_stats
 }
 epoch_aeron_stats_t;
 
+typedef struct epoch_aeron_ring_config
+{
+    size_t capacity;
+    const char *shm_name;
+    int32_t idle_spin_count;
+    int64_t idle_park_ns;
+}
+epoch_aeron_ring_config_t;
+
 epoch_aeron_transport_t *epoch_aeron_open(
     const epoch_aeron_config_t *config,
     char *error,
@@ -54,10 +95,52 @@ int epoch_aeron_poll(
     char *error,
     size_t error_len);
 
+int epoch_aeron_send_batch(
+    epoch_aeron_transport_t *transport,
+    const uint8_t *frames,
+    size_t frame_count,
+    size_t *out_sent,
+    char *error,
+    size_t error_len);
+
+int epoch_aeron_poll_batch(
+    epoch_aeron_transport_t *transport,
+    uint8_t *frames,
+    size_t frame_capacity,
+    size_t *out_count,
+    char *error,
+    size_t error_len);
+
 int epoch_aeron_stats(epoch_aeron_transport_t *transport, epoch_aeron_stats_t *out_stats);
 
 void epoch_aeron_close(epoch_aeron_transport_t *transport);
 
+epoch_aeron_ring_t *epoch_aeron_ring_open(
+    const epoch_aeron_config_t *config,
+    const epoch_aeron_ring_config_t *ring_config,
+    char *error,
+    size_t error_len);
+
+uint8_t *epoch_aeron_ring_region(epoch_aeron_ring_t *ring, size_t *out_length);
+
+int epoch_aeron_ring_wake(epoch_aeron_ring_t *ring);
+
+/* Publishes outbound frames below tail (release store, then a full fence before checking io_parked) and
+ * wakes a parked I/O thread. Returns 1 if it woke the thread, 0 if not, -1 on error. */
+int epoch_aeron_ring_publish(epoch_aeron_ring_t *ring, uint64_t tail);
+
+/* Acquire load of the inbound tail: frames below it are safe to read once this returns. */
+uint64_t epoch_aeron_ring_inbound_tail(epoch_aeron_ring_t *ring);
+
+/* Release store of the inbound head after the host copied the frames below it. */
+int epoch_aeron_ring_consume(epoch_aeron_ring_t *ring, uint64_t head);
+
+int epoch_aeron_ring_park(epoch_aeron_ring_t *ring, int64_t timeout_ns);
+
+int epoch_aeron_ring_stats(epoch_aeron_ring_t *ring, epoch_aeron_stats_t *out_stats);
+
+void epoch_aeron_ring_close(epoch_aeron_ring_t *ring);
+
 #ifdef __cplusplus
 }
 #endif
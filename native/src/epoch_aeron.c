@@ -1,4 +1,5 @@
 #include "epoch_aeron.h"
+#include "epoch_aeron_internal.h"
 
 #include <aeronc.h>
 #include <concurrent/aeron_thread.h>
@@ -7,18 +8,7 @@
 #include <string.h>
 #include <stdio.h>
 
-struct epoch_aeron_transport
-{
-    aeron_context_t *context;
-    aeron_t *client;
-    aeron_publication_t *publication;
-    aeron_subscription_t *subscription;
-    epoch_aeron_config_t config;
-    epoch_aeron_stats_t stats;
-    int closed;
-};
-
-static void epoch_aeron_set_error(char *error, size_t error_len, const char *message)
+void epoch_aeron_set_error(char *error, size_t error_len, const char *message)
 {
     if (error == NULL || error_len == 0)
     {
@@ -32,7 +22,7 @@ static void epoch_aeron_set_error(char *error, size_t error_len, const char *mes
     snprintf(error, error_len, "%s", message);
 }
 
-static void epoch_aeron_set_error_with_aeron(char *error, size_t error_len, const char *context)
+void epoch_aeron_set_error_with_aeron(char *error, size_t error_len, const char *context)
 {
     if (error == NULL || error_len == 0)
     {
@@ -217,6 +207,56 @@ epoch_aeron_transport_t *epoch_aeron_open(
     return transport;
 }
 
+int64_t epoch_aeron_offer_once(epoch_aeron_transport_t *transport, const uint8_t *frame)
+{
+    int64_t result = aeron_publication_offer(
+        transport->publication, frame, EPOCH_AERON_FRAME_LENGTH, NULL, NULL);
+    if (result >= 0)
+    {
+        transport->stats.sent_count++;
+    }
+    else if (result == AERON_PUBLICATION_BACK_PRESSURED)
+    {
+        transport->stats.offer_back_pressure++;
+    }
+    else if (result == AERON_PUBLICATION_NOT_CONNECTED)
+    {
+        transport->stats.offer_not_connected++;
+    }
+    else if (result == AERON_PUBLICATION_ADMIN_ACTION)
+    {
+        transport->stats.offer_admin_action++;
+    }
+    else if (result == AERON_PUBLICATION_CLOSED)
+    {
+        transport->stats.offer_closed++;
+    }
+    else if (result == AERON_PUBLICATION_MAX_POSITION_EXCEEDED)
+    {
+        transport->stats.offer_max_position++;
+    }
+    else
+    {
+        transport->stats.offer_failed++;
+    }
+    return result;
+}
+
+static int epoch_aeron_offer_frame(epoch_aeron_transport_t *transport, const uint8_t *frame)
+{
+    int attempts = 0;
+    while (attempts < transport->config.offer_max_attempts)
+    {
+        if (epoch_aeron_offer_once(transport, frame) >= 0)
+        {
+            return 0;
+        }
+        attempts++;
+        sched_yield();
+    }
+    return -1;
+}
+
 int epoch_aeron_send(
     epoch_aeron_transport_t *transport,
     const uint8_t *frame,
@@ -235,46 +275,54 @@ int epoch_aeron_send(
         return -1;
     }
 
-    int attempts = 0;
-    while (attempts < transport->config.offer_max_attempts)
+    if (epoch_aeron_offer_frame(transport, frame) < 0)
     {
-        int64_t result = aeron_publication_offer(
-            transport->publication, frame, EPOCH_AERON_FRAME_LENGTH, NULL, NULL);
-        if (result >= 0)
-        {
-            transport->stats.sent_count++;
-            return 0;
-        }
-        if (result == AERON_PUBLICATION_BACK_PRESSURED)
-        {
-            transport->stats.offer_back_pressure++;
-        }
-        else if (result == AERON_PUBLICATION_NOT_CONNECTED)
-        {
-            transport->stats.offer_not_connected++;
-        }
-        else if (result == AERON_PUBLICATION_ADMIN_ACTION)
-        {
-            transport->stats.offer_admin_action++;
-        }
-        else if (result == AERON_PUBLICATION_CLOSED)
-        {
-            transport->stats.offer_closed++;
-        }
-        else if (result == AERON_PUBLICATION_MAX_POSITION_EXCEEDED)
+        epoch_aeron_set_error(error, error_len, "aeron offer failed");
+        return -1;
+    }
+    return 0;
+}
+
+int epoch_aeron_send_batch(
+    epoch_aeron_transport_t *transport,
+    const uint8_t *frames,
+    size_t frame_count,
+    size_t *out_sent,
+    char *error,
+    size_t error_len)
+{
+    if (out_sent != NULL)
+    {
+        *out_sent = 0;
+    }
+    if (transport == NULL || transport->closed)
+    {
+        epoch_aeron_set_error(error, error_len, "transport closed");
+        return -1;
+    }
+    if (frame_count == 0)
+    {
+        return 0;
+    }
+    if (frames == NULL)
+    {
+        epoch_aeron_set_error(error, error_len, "invalid frame");
+        return -1;
+    }
+
+    for (size_t i = 0; i < frame_count; i++)
+    {
+        if (epoch_aeron_offer_frame(transport, frames + (i * EPOCH_AERON_FRAME_LENGTH)) < 0)
         {
-            transport->stats.offer_max_position++;
+            epoch_aeron_set_error(error, error_len, "aeron offer failed");
+            return -1;
         }
-        else
+        if (out_sent != NULL)
         {
-            transport->stats.offer_failed++;
+            *out_sent = i + 1;
         }
-        attempts++;
-        sched_yield();
     }
-
-    epoch_aeron_set_error(error, error_len, "aeron offer failed");
-    return -1;
+    return 0;
 }
 
 typedef struct epoch_aeron_poll_context
@@ -285,27 +333,30 @@ typedef struct epoch_aeron_poll_context
 }
 epoch_aeron_poll_context_t;
 
-static void epoch_aeron_fragment_handler(void *clientd, const uint8_t *buffer, size_t length, aeron_header_t *header)
+static aeron_controlled_fragment_handler_action_t epoch_aeron_fragment_handler(
+    void *clientd, const uint8_t *buffer, size_t length, aeron_header_t *header)
 {
     (void)header;
     epoch_aeron_poll_context_t *ctx = (epoch_aeron_poll_context_t *)clientd;
     if (ctx->count >= ctx->capacity)
     {
-        return;
+        return AERON_ACTION_ABORT;
     }
     if (length < EPOCH_AERON_FRAME_LENGTH)
     {
-        return;
+        return AERON_ACTION_CONTINUE;
     }
     memcpy(ctx->frames + (ctx->count * EPOCH_AERON_FRAME_LENGTH), buffer, EPOCH_AERON_FRAME_LENGTH);
     ctx->count++;
+    return AERON_ACTION_CONTINUE;
 }
 
-int epoch_aeron_poll(
+static int epoch_aeron_poll_frames(
     epoch_aeron_transport_t *transport,
     uint8_t *frames,
     size_t frame_capacity,
     size_t *out_count,
+    int drain,
     char *error,
     size_t error_len)
 {
@@ -328,19 +379,32 @@ int epoch_aeron_poll(
     context.capacity = frame_capacity;
     context.count = 0;
 
-    size_t fragment_limit = frame_capacity;
-    if (transport->config.fragment_limit > 0 && fragment_limit > (size_t)transport->config.fragment_limit)
+    do
     {
-        fragment_limit = (size_t)transport->config.fragment_limit;
-    }
+        size_t fragment_limit = frame_capacity - context.count;
+        if (transport->config.fragment_limit > 0 && fragment_limit > (size_t)transport->config.fragment_limit)
+        {
+            fragment_limit = (size_t)transport->config.fragment_limit;
+        }
 
-    int fragments = aeron_subscription_poll(
-        transport->subscription, epoch_aeron_fragment_handler, &context, fragment_limit);
-    if (fragments < 0)
-    {
-        epoch_aeron_set_error_with_aeron(error, error_len, "aeron_subscription_poll failed");
-        return -1;
+        int fragments = aeron_subscription_controlled_poll(
+            transport->subscription, epoch_aeron_fragment_handler, &context, fragment_limit);
+        if (fragments < 0)
+        {
+            transport->stats.received_count += (int64_t)context.count;
+            if (out_count != NULL)
+            {
+                *out_count = context.count;
+            }
+            epoch_aeron_set_error_with_aeron(error, error_len, "aeron_subscription_controlled_poll failed");
+            return -1;
+        }
+        if (fragments == 0)
+        {
+            break;
+        }
     }
+    while (drain && context.count < frame_capacity);
 
     if (out_count != NULL)
     {
@@ -350,6 +414,28 @@ int epoch_aeron_poll(
     return 0;
 }
 
+int epoch_aeron_poll(
+    epoch_aeron_transport_t *transport,
+    uint8_t *frames,
+    size_t frame_capacity,
+    size_t *out_count,
+    char *error,
+    size_t error_len)
+{
+    return epoch_aeron_poll_frames(transport, frames, frame_capacity, out_count, 0, error, error_len);
+}
+
+int epoch_aeron_poll_batch(
+    epoch_aeron_transport_t *transport,
+    uint8_t *frames,
+    size_t frame_capacity,
+    size_t *out_count,
+    char *error,
+    size_t error_len)
+{
+    return epoch_aeron_poll_frames(transport, frames, frame_capacity, out_count, 1, error, error_len);
+}
+
 int epoch_aeron_stats(epoch_aeron_transport_t *transport, epoch_aeron_stats_t *out_stats)
 {
     if (transport == NULL || out_stats == NULL)
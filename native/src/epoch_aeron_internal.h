@@ -0,0 +1,22 @@
+#pragma once
+
+#include "epoch_aeron.h"
+
+#include <aeronc.h>
+
+struct epoch_aeron_transport
+{
+    aeron_context_t *context;
+    aeron_t *client;
+    aeron_publication_t *publication;
+    aeron_subscription_t *subscription;
+    epoch_aeron_config_t config;
+    epoch_aeron_stats_t stats;
+    int closed;
+};
+
+void epoch_aeron_set_error(char *error, size_t error_len, const char *message);
+
+void epoch_aeron_set_error_with_aeron(char *error, size_t error_len, const char *context);
+
+int64_t epoch_aeron_offer_once(epoch_aeron_transport_t *transport, const uint8_t *frame);
@@ -0,0 +1,556 @@
+#include "epoch_aeron.h"
+#include "epoch_aeron_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+
+epoch_aeron_ring_t *epoch_aeron_ring_open(
+    const epoch_aeron_config_t *config,
+    const epoch_aeron_ring_config_t *ring_config,
+    char *error,
+    size_t error_len)
+{
+    (void)config;
+    (void)ring_config;
+    epoch_aeron_set_error(error, error_len, "ring mode not supported on this platform");
+    return NULL;
+}
+
+uint8_t *epoch_aeron_ring_region(epoch_aeron_ring_t *ring, size_t *out_length)
+{
+    (void)ring;
+    if (out_length != NULL)
+    {
+        *out_length = 0;
+    }
+    return NULL;
+}
+
+int epoch_aeron_ring_wake(epoch_aeron_ring_t *ring)
+{
+    (void)ring;
+    return -1;
+}
+
+int epoch_aeron_ring_publish(epoch_aeron_ring_t *ring, uint64_t tail)
+{
+    (void)ring;
+    (void)tail;
+    return -1;
+}
+
+uint64_t epoch_aeron_ring_inbound_tail(epoch_aeron_ring_t *ring)
+{
+    (void)ring;
+    return 0;
+}
+
+int epoch_aeron_ring_consume(epoch_aeron_ring_t *ring, uint64_t head)
+{
+    (void)ring;
+    (void)head;
+    return -1;
+}
+
+int epoch_aeron_ring_park(epoch_aeron_ring_t *ring, int64_t timeout_ns)
+{
+    (void)ring;
+    (void)timeout_ns;
+    return -1;
+}
+
+int epoch_aeron_ring_stats(epoch_aeron_ring_t *ring, epoch_aeron_stats_t *out_stats)
+{
+    (void)ring;
+    (void)out_stats;
+    return -1;
+}
+
+void epoch_aeron_ring_close(epoch_aeron_ring_t *ring)
+{
+    (void)ring;
+}
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#define EPOCH_AERON_RING_DEFAULT_CAPACITY 4096
+#define EPOCH_AERON_RING_DEFAULT_SPIN 1000
+#define EPOCH_AERON_RING_DEFAULT_PARK_NS 1000000
+
+struct epoch_aeron_ring
+{
+    epoch_aeron_transport_t *transport;
+    uint8_t *region;
+    size_t region_length;
+    char *shm_name;
+    uint64_t capacity;
+    uint8_t *inbound_frames;
+    uint8_t *outbound_frames;
+    _Atomic uint64_t *inbound_tail;
+    _Atomic uint64_t *inbound_head;
+    _Atomic uint64_t *outbound_tail;
+    _Atomic uint64_t *outbound_head;
+    _Atomic uint32_t *io_parked;
+    _Atomic uint32_t *host_parked;
+    _Atomic int32_t *status;
+    _Atomic int32_t *outbound_status;
+    /* Outbound tail the last drain saw; the I/O thread parks unless the host published past it. */
+    uint64_t offered_tail;
+    int32_t idle_spin_count;
+    int64_t idle_park_ns;
+    pthread_t thread;
+    int thread_started;
+    atomic_int running;
+    pthread_mutex_t lock;
+    pthread_cond_t io_cond;
+    pthread_cond_t host_cond;
+    epoch_aeron_stats_t stats;
+};
+
+typedef struct epoch_aeron_ring_poll_context
+{
+    epoch_aeron_ring_t *ring;
+    uint64_t tail;
+    uint64_t limit;
+}
+epoch_aeron_ring_poll_context_t;
+
+static uint64_t epoch_aeron_ring_round_capacity(size_t requested)
+{
+    uint64_t capacity = 1;
+    while (capacity < (uint64_t)requested)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+static void epoch_aeron_ring_deadline(struct timespec *deadline, int64_t timeout_ns)
+{
+    clock_gettime(CLOCK_REALTIME, deadline);
+    int64_t nanos = (int64_t)deadline->tv_nsec + timeout_ns;
+    deadline->tv_sec += (time_t)(nanos / 1000000000LL);
+    deadline->tv_nsec = (long)(nanos % 1000000000LL);
+}
+
+static int epoch_aeron_ring_map(epoch_aeron_ring_t *ring, char *error, size_t error_len)
+{
+    if (ring->shm_name == NULL)
+    {
+        void *region = mmap(
+            NULL, ring->region_length, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (region == MAP_FAILED)
+        {
+            epoch_aeron_set_error(error, error_len, "ring mmap failed");
+            return -1;
+        }
+        ring->region = (uint8_t *)region;
+        return 0;
+    }
+
+    int fd = shm_open(ring->shm_name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        epoch_aeron_set_error(error, error_len, "ring shm_open failed");
+        return -1;
+    }
+    if (ftruncate(fd, (off_t)ring->region_length) < 0)
+    {
+        close(fd);
+        shm_unlink(ring->shm_name);
+        epoch_aeron_set_error(error, error_len, "ring ftruncate failed");
+        return -1;
+    }
+    void *region = mmap(NULL, ring->region_length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED)
+    {
+        shm_unlink(ring->shm_name);
+        epoch_aeron_set_error(error, error_len, "ring mmap failed");
+        return -1;
+    }
+    ring->region = (uint8_t *)region;
+    return 0;
+}
+
+static void epoch_aeron_ring_init_layout(epoch_aeron_ring_t *ring)
+{
+    uint8_t *base = ring->region;
+    uint64_t inbound_offset = EPOCH_AERON_RING_HEADER_LENGTH;
+    uint64_t outbound_offset = inbound_offset + (ring->capacity * EPOCH_AERON_FRAME_LENGTH);
+    uint32_t magic = EPOCH_AERON_RING_MAGIC;
+    uint32_t version = EPOCH_AERON_RING_VERSION;
+    uint32_t frame_length = EPOCH_AERON_FRAME_LENGTH;
+
+    memset(base, 0, EPOCH_AERON_RING_HEADER_LENGTH);
+    memcpy(base + EPOCH_AERON_RING_OFFSET_VERSION, &version, sizeof(version));
+    memcpy(base + EPOCH_AERON_RING_OFFSET_FRAME_LENGTH, &frame_length, sizeof(frame_length));
+    memcpy(base + EPOCH_AERON_RING_OFFSET_CAPACITY, &ring->capacity, sizeof(ring->capacity));
+    memcpy(base + EPOCH_AERON_RING_OFFSET_INBOUND_FRAMES, &inbound_offset, sizeof(inbound_offset));
+    memcpy(base + EPOCH_AERON_RING_OFFSET_OUTBOUND_FRAMES, &outbound_offset, sizeof(outbound_offset));
+
+    ring->inbound_frames = base + inbound_offset;
+    ring->outbound_frames = base + outbound_offset;
+    ring->inbound_tail = (_Atomic uint64_t *)(base + EPOCH_AERON_RING_OFFSET_INBOUND_TAIL);
+    ring->inbound_head = (_Atomic uint64_t *)(base + EPOCH_AERON_RING_OFFSET_INBOUND_HEAD);
+    ring->outbound_tail = (_Atomic uint64_t *)(base + EPOCH_AERON_RING_OFFSET_OUTBOUND_TAIL);
+    ring->outbound_head = (_Atomic uint64_t *)(base + EPOCH_AERON_RING_OFFSET_OUTBOUND_HEAD);
+    ring->io_parked = (_Atomic uint32_t *)(base + EPOCH_AERON_RING_OFFSET_IO_PARKED);
+    ring->host_parked = (_Atomic uint32_t *)(base + EPOCH_AERON_RING_OFFSET_HOST_PARKED);
+    ring->status = (_Atomic int32_t *)(base + EPOCH_AERON_RING_OFFSET_STATUS);
+    ring->outbound_status = (_Atomic int32_t *)(base + EPOCH_AERON_RING_OFFSET_OUTBOUND_STATUS);
+
+    atomic_store_explicit(
+        (_Atomic uint32_t *)(base + EPOCH_AERON_RING_OFFSET_MAGIC), magic, memory_order_release);
+}
+
+static aeron_controlled_fragment_handler_action_t epoch_aeron_ring_fragment_handler(
+    void *clientd, const uint8_t *buffer, size_t length, aeron_header_t *header)
+{
+    (void)header;
+    epoch_aeron_ring_poll_context_t *ctx = (epoch_aeron_ring_poll_context_t *)clientd;
+    if (ctx->tail >= ctx->limit)
+    {
+        return AERON_ACTION_ABORT;
+    }
+    if (length < EPOCH_AERON_FRAME_LENGTH)
+    {
+        return AERON_ACTION_CONTINUE;
+    }
+    uint64_t slot = ctx->tail & (ctx->ring->capacity - 1);
+    memcpy(ctx->ring->inbound_frames + (slot * EPOCH_AERON_FRAME_LENGTH), buffer, EPOCH_AERON_FRAME_LENGTH);
+    ctx->tail++;
+    return AERON_ACTION_CONTINUE;
+}
+
+static int epoch_aeron_ring_drain_outbound(epoch_aeron_ring_t *ring)
+{
+    uint64_t head = atomic_load_explicit(ring->outbound_head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(ring->outbound_tail, memory_order_acquire);
+    uint64_t start = head;
+    int64_t result = 0;
+    ring->offered_tail = tail;
+    if (atomic_load_explicit(ring->status, memory_order_relaxed) < 0)
+    {
+        return 0;
+    }
+    while (head < tail)
+    {
+        uint64_t slot = head & (ring->capacity - 1);
+        result = epoch_aeron_offer_once(ring->transport, ring->outbound_frames + (slot * EPOCH_AERON_FRAME_LENGTH));
+        if (result < 0)
+        {
+            break;
+        }
+        head++;
+    }
+    if (head != start)
+    {
+        atomic_store_explicit(ring->outbound_head, head, memory_order_release);
+    }
+    atomic_store_explicit(ring->outbound_status, result < 0 ? (int32_t)result : 0, memory_order_release);
+    if (result == AERON_PUBLICATION_CLOSED || result == AERON_PUBLICATION_MAX_POSITION_EXCEEDED)
+    {
+        /* No later offer can succeed: surface it to the host instead of retrying forever. */
+        atomic_store_explicit(ring->status, (int32_t)result, memory_order_release);
+        return -1;
+    }
+    return (int)(head - start);
+}
+
+static int epoch_aeron_ring_fill_inbound(epoch_aeron_ring_t *ring)
+{
+    epoch_aeron_ring_poll_context_t context;
+    context.ring = ring;
+    context.tail = atomic_load_explicit(ring->inbound_tail, memory_order_relaxed);
+    context.limit = atomic_load_explicit(ring->inbound_head, memory_order_acquire) + ring->capacity;
+    if (context.tail >= context.limit || atomic_load_explicit(ring->status, memory_order_relaxed) < 0)
+    {
+        return 0;
+    }
+
+    uint64_t start = context.tail;
+    size_t fragment_limit = (size_t)ring->transport->config.fragment_limit;
+    int rc = aeron_subscription_controlled_poll(
+        ring->transport->subscription, epoch_aeron_ring_fragment_handler, &context, fragment_limit);
+    if (rc < 0)
+    {
+        /* Closed or failed subscription: surface it to the host instead of polling it forever. */
+        atomic_store_explicit(ring->status, (int32_t)rc, memory_order_release);
+        return -1;
+    }
+    if (context.tail != start)
+    {
+        ring->transport->stats.received_count += (int64_t)(context.tail - start);
+        atomic_store_explicit(ring->inbound_tail, context.tail, memory_order_release);
+    }
+    return (int)(context.tail - start);
+}
+
+static void *epoch_aeron_ring_run(void *arg)
+{
+    epoch_aeron_ring_t *ring = (epoch_aeron_ring_t *)arg;
+    int32_t idle = 0;
+    while (atomic_load_explicit(&ring->running, memory_order_acquire))
+    {
+        int sent = epoch_aeron_ring_drain_outbound(ring);
+        int received = epoch_aeron_ring_fill_inbound(ring);
+        if (sent < 0 || received < 0)
+        {
+            pthread_mutex_lock(&ring->lock);
+            pthread_cond_broadcast(&ring->host_cond);
+            pthread_mutex_unlock(&ring->lock);
+            sent = sent < 0 ? 0 : sent;
+            received = received < 0 ? 0 : received;
+        }
+        if (sent > 0 || received > 0)
+        {
+            idle = 0;
+            pthread_mutex_lock(&ring->lock);
+            ring->stats = ring->transport->stats;
+            if (received > 0 && atomic_load_explicit(ring->host_parked, memory_order_acquire))
+            {
+                pthread_cond_broadcast(&ring->host_cond);
+            }
+            pthread_mutex_unlock(&ring->lock);
+            continue;
+        }
+        if (++idle < ring->idle_spin_count)
+        {
+            sched_yield();
+            continue;
+        }
+
+        struct timespec deadline;
+        epoch_aeron_ring_deadline(&deadline, ring->idle_park_ns);
+        pthread_mutex_lock(&ring->lock);
+        ring->stats = ring->transport->stats;
+        atomic_store_explicit(ring->io_parked, 1, memory_order_seq_cst);
+        /* Frames the last drain could not offer do not keep the thread awake: it retries them after the
+         * timed wait, or sooner if the host publishes more. */
+        if (atomic_load_explicit(ring->outbound_tail, memory_order_seq_cst) == ring->offered_tail &&
+            atomic_load_explicit(&ring->running, memory_order_acquire))
+        {
+            pthread_cond_timedwait(&ring->io_cond, &ring->lock, &deadline);
+        }
+        atomic_store_explicit(ring->io_parked, 0, memory_order_release);
+        pthread_mutex_unlock(&ring->lock);
+        idle = 0;
+    }
+    return NULL;
+}
+
+epoch_aeron_ring_t *epoch_aeron_ring_open(
+    const epoch_aeron_config_t *config,
+    const epoch_aeron_ring_config_t *ring_config,
+    char *error,
+    size_t error_len)
+{
+    epoch_aeron_ring_t *ring = calloc(1, sizeof(epoch_aeron_ring_t));
+    if (ring == NULL)
+    {
+        epoch_aeron_set_error(error, error_len, "out of memory");
+        return NULL;
+    }
+    pthread_mutex_init(&ring->lock, NULL);
+    pthread_cond_init(&ring->io_cond, NULL);
+    pthread_cond_init(&ring->host_cond, NULL);
+
+    size_t capacity = EPOCH_AERON_RING_DEFAULT_CAPACITY;
+    ring->idle_spin_count = EPOCH_AERON_RING_DEFAULT_SPIN;
+    ring->idle_park_ns = EPOCH_AERON_RING_DEFAULT_PARK_NS;
+    if (ring_config != NULL)
+    {
+        if (ring_config->capacity > 0)
+        {
+            capacity = ring_config->capacity;
+        }
+        if (ring_config->idle_spin_count > 0)
+        {
+            ring->idle_spin_count = ring_config->idle_spin_count;
+        }
+        if (ring_config->idle_park_ns > 0)
+        {
+            ring->idle_park_ns = ring_config->idle_park_ns;
+        }
+        if (ring_config->shm_name != NULL && ring_config->shm_name[0] != '\0')
+        {
+            ring->shm_name = strdup(ring_config->shm_name);
+            if (ring->shm_name == NULL)
+            {
+                epoch_aeron_set_error(error, error_len, "out of memory");
+                epoch_aeron_ring_close(ring);
+                return NULL;
+            }
+        }
+    }
+    ring->capacity = epoch_aeron_ring_round_capacity(capacity);
+    ring->region_length =
+        EPOCH_AERON_RING_HEADER_LENGTH + (size_t)(2 * ring->capacity * EPOCH_AERON_FRAME_LENGTH);
+
+    ring->transport = epoch_aeron_open(config, error, error_len);
+    if (ring->transport == NULL)
+    {
+        epoch_aeron_ring_close(ring);
+        return NULL;
+    }
+    if (epoch_aeron_ring_map(ring, error, error_len) < 0)
+    {
+        epoch_aeron_ring_close(ring);
+        return NULL;
+    }
+    epoch_aeron_ring_init_layout(ring);
+
+    atomic_store_explicit(&ring->running, 1, memory_order_release);
+    if (pthread_create(&ring->thread, NULL, epoch_aeron_ring_run, ring) != 0)
+    {
+        atomic_store_explicit(&ring->running, 0, memory_order_release);
+        epoch_aeron_set_error(error, error_len, "ring thread start failed");
+        epoch_aeron_ring_close(ring);
+        return NULL;
+    }
+    ring->thread_started = 1;
+    return ring;
+}
+
+uint8_t *epoch_aeron_ring_region(epoch_aeron_ring_t *ring, size_t *out_length)
+{
+    if (out_length != NULL)
+    {
+        *out_length = ring == NULL ? 0 : ring->region_length;
+    }
+    return ring == NULL ? NULL : ring->region;
+}
+
+int epoch_aeron_ring_wake(epoch_aeron_ring_t *ring)
+{
+    if (ring == NULL)
+    {
+        return -1;
+    }
+    pthread_mutex_lock(&ring->lock);
+    pthread_cond_signal(&ring->io_cond);
+    pthread_mutex_unlock(&ring->lock);
+    return 0;
+}
+
+int epoch_aeron_ring_publish(epoch_aeron_ring_t *ring, uint64_t tail)
+{
+    if (ring == NULL)
+    {
+        return -1;
+    }
+    atomic_store_explicit(ring->outbound_tail, tail, memory_order_release);
+    /* Pairs with the seq_cst io_parked store and tail load in epoch_aeron_ring_run: either the I/O thread
+     * sees the new tail before it waits, or this sees it parked and signals under the lock. */
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(ring->io_parked, memory_order_relaxed) == 0)
+    {
+        return 0;
+    }
+    epoch_aeron_ring_wake(ring);
+    return 1;
+}
+
+uint64_t epoch_aeron_ring_inbound_tail(epoch_aeron_ring_t *ring)
+{
+    return ring == NULL ? 0 : atomic_load_explicit(ring->inbound_tail, memory_order_acquire);
+}
+
+int epoch_aeron_ring_consume(epoch_aeron_ring_t *ring, uint64_t head)
+{
+    if (ring == NULL)
+    {
+        return -1;
+    }
+    atomic_store_explicit(ring->inbound_head, head, memory_order_release);
+    return 0;
+}
+
+int epoch_aeron_ring_park(epoch_aeron_ring_t *ring, int64_t timeout_ns)
+{
+    if (ring == NULL)
+    {
+        return -1;
+    }
+    struct timespec deadline;
+    epoch_aeron_ring_deadline(&deadline, timeout_ns > 0 ? timeout_ns : 0);
+
+    pthread_mutex_lock(&ring->lock);
+    atomic_store_explicit(ring->host_parked, 1, memory_order_seq_cst);
+    int rc = 0;
+    while (atomic_load_explicit(ring->inbound_tail, memory_order_seq_cst) ==
+               atomic_load_explicit(ring->inbound_head, memory_order_acquire) &&
+           atomic_load_explicit(ring->status, memory_order_acquire) >= 0 && rc != ETIMEDOUT)
+    {
+        rc = pthread_cond_timedwait(&ring->host_cond, &ring->lock, &deadline);
+    }
+    atomic_store_explicit(ring->host_parked, 0, memory_order_release);
+    pthread_mutex_unlock(&ring->lock);
+
+    if (atomic_load_explicit(ring->inbound_tail, memory_order_acquire) !=
+        atomic_load_explicit(ring->inbound_head, memory_order_acquire))
+    {
+        return 1;
+    }
+    return atomic_load_explicit(ring->status, memory_order_acquire) < 0 ? -1 : 0;
+}
+
+int epoch_aeron_ring_stats(epoch_aeron_ring_t *ring, epoch_aeron_stats_t *out_stats)
+{
+    if (ring == NULL || out_stats == NULL)
+    {
+        return -1;
+    }
+    pthread_mutex_lock(&ring->lock);
+    *out_stats = ring->stats;
+    pthread_mutex_unlock(&ring->lock);
+    return 0;
+}
+
+void epoch_aeron_ring_close(epoch_aeron_ring_t *ring)
+{
+    if (ring == NULL)
+    {
+        return;
+    }
+    if (ring->thread_started)
+    {
+        atomic_store_explicit(&ring->running, 0, memory_order_release);
+        epoch_aeron_ring_wake(ring);
+        pthread_join(ring->thread, NULL);
+        ring->thread_started = 0;
+    }
+    if (ring->transport != NULL)
+    {
+        epoch_aeron_close(ring->transport);
+        ring->transport = NULL;
+    }
+    if (ring->region != NULL)
+    {
+        munmap(ring->region, ring->region_length);
+        ring->region = NULL;
+        if (ring->shm_name != NULL)
+        {
+            shm_unlink(ring->shm_name);
+        }
+    }
+    pthread_cond_destroy(&ring->host_cond);
+    pthread_cond_destroy(&ring->io_cond);
+    pthread_mutex_destroy(&ring->lock);
+    free(ring->shm_name);
+    free(ring);
+}
+
+#endif
@@ -17,6 +17,7 @@ export type AeronStats = {
 export type AeronNative = {
   open(config: AeronConfig): unknown;
   send(handle: unknown, frame: Buffer): void;
+  sendBatch(handle: unknown, frames: Buffer, count: number): void;
   poll(handle: unknown, max: number): Buffer[];
   stats(handle: unknown): AeronStats;
   close(handle: unknown): void;
@@ -57,8 +58,13 @@ export function loadAeronNative(koffiImpl?: any, libraryPath?: string): AeronNat
     "int",
     [AeronHandle, "const uint8_t *", "size_t", "char *", "size_t"]
   );
+  const sendBatchFn = lib.func(
+    "epoch_aeron_send_batch",
+    "int",
+    [AeronHandle, "const uint8_t *", "size_t", "size_t *", "char *", "size_t"]
+  );
   const pollFn = lib.func(
-    "epoch_aeron_poll",
+    "epoch_aeron_poll_batch",
     "int",
     [AeronHandle, "uint8_t *", "size_t", "size_t *", "char *", "size_t"]
   );
@@ -97,6 +103,17 @@ export function loadAeronNative(koffiImpl?: any, libraryPath?: string): AeronNat
         throw new Error(trimCString(errBuf));
       }
     },
+    sendBatch(handle: unknown, frames: Buffer, count: number) {
+      if (!count) {
+        return;
+      }
+      const errBuf = Buffer.alloc(256);
+      const sentRef = [0];
+      const result = sendBatchFn(handle, frames, count, sentRef, errBuf, errBuf.length);
+      if (result < 0) {
+        throw new Error(`${trimCString(errBuf)} (sent ${sentRef[0] ?? 0} of ${count})`);
+      }
+    },
     poll(handle: unknown, max: number) {
       if (!max) {
         return [];
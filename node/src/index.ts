@@ -37,6 +37,63 @@ export function fnv1a64Hex(input: string): string {
   return hash.toString(16).padStart(16, "0");
 }
 
+function mix64(value: bigint): bigint {
+  value ^= value >> 30n;
+  value = (value * 0xbf58476d1ce4e5b9n) & FNV_MASK;
+  value ^= value >> 27n;
+  value = (value * 0x94d049bb133111ebn) & FNV_MASK;
+  value ^= value >> 31n;
+  return value;
+}
+
+// mix64(fnv1a64(le64(key) || value)); a number or bigint value is encoded as 8 little-endian bytes.
+export function digestEntry(key: bigint | number, value: bigint | number | Uint8Array): bigint {
+  const prefix = Buffer.alloc(8);
+  prefix.writeBigUInt64LE(BigInt.asUintN(64, BigInt(key)));
+  let data: Uint8Array;
+  if (value instanceof Uint8Array) {
+    data = value;
+  } else {
+    data = Buffer.alloc(8);
+    (data as Buffer).writeBigUInt64LE(BigInt.asUintN(64, BigInt(value)));
+  }
+  let hash = FNV_OFFSET_BASIS;
+  for (const bytes of [prefix, data]) {
+    for (const b of bytes) {
+      hash ^= BigInt(b);
+      hash = (hash * FNV_PRIME) & FNV_MASK;
+    }
+  }
+  return mix64(hash);
+}
+
+// Order-independent multiset digest from behavior.md: the sum of entry hashes mod 2^64.
+export class StateDigest {
+  value = 0n;
+
+  add(key: bigint | number, value: bigint | number | Uint8Array) {
+    this.value = (this.value + digestEntry(key, value)) & FNV_MASK;
+  }
+
+  remove(key: bigint | number, value: bigint | number | Uint8Array) {
+    this.value = (this.value - digestEntry(key, value)) & FNV_MASK;
+  }
+
+  replace(key: bigint | number, oldValue: bigint | number, newValue: bigint | number) {
+    this.remove(key, oldValue);
+    this.add(key, newValue);
+  }
+
+  hex(): string {
+    return this.value.toString(16).padStart(16, "0");
+  }
+}
+
+// The sum model's digest: the single entry (0, state).
+export function stateDigestHex(state: bigint | number): string {
+  return digestEntry(0, state).toString(16).padStart(16, "0");
+}
+
 export function processMessages(messages: Message[]) {
   messages.sort((a, b) => {
     if (a.epoch !== b.epoch) return a.epoch - b.epoch;
@@ -48,7 +105,7 @@ export function processMessages(messages: Message[]) {
     return a.sourceSeq - b.sourceSeq;
   });
 
-  const results: { epoch: number; state: number; hash: string }[] = [];
+  const results: { epoch: number; state: number; hash: string; digest: string }[] = [];
   let state = 0;
   let currentEpoch: number | null = null;
 
@@ -60,7 +117,8 @@ export function processMessages(messages: Message[]) {
       results.push({
         epoch: currentEpoch,
         state,
-        hash: fnv1a64Hex(`state:${state}`)
+        hash: fnv1a64Hex(`state:${state}`),
+        digest: stateDigestHex(state)
       });
       currentEpoch = message.epoch;
     }
@@ -71,7 +129,8 @@ export function processMessages(messages: Message[]) {
     results.push({
       epoch: currentEpoch,
       state,
-      hash: fnv1a64Hex(`state:${state}`)
+      hash: fnv1a64Hex(`state:${state}`),
+      digest: stateDigestHex(state)
     });
   }
 
@@ -150,6 +209,17 @@ export class AeronTransport {
     this.native.send(this.handle, frame);
   }
 
+  sendBatch(messages: Message[]) {
+    if (this.closed) {
+      throw new Error("Aeron transport closed");
+    }
+    if (messages.length === 0) {
+      return;
+    }
+    const frames = Buffer.concat(messages.map(encodeAeronFrame));
+    this.native.sendBatch(this.handle, frames, messages.length);
+  }
+
   poll(max: number) {
     if (this.closed || max <= 0) {
       return [];
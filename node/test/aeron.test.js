@@ -17,6 +17,12 @@ class FakeNative {
     this.frames.push(Buffer.from(frame));
   }
 
+  sendBatch(_handle, frames, count) {
+    for (let i = 0; i < count; i++) {
+      this.frames.push(Buffer.from(frames.subarray(i * 56, (i + 1) * 56)));
+    }
+  }
+
   poll(_handle, max) {
     const out = this.frames.slice(0, max);
     this.frames = this.frames.slice(max);
@@ -72,6 +78,16 @@ test("AeronTransport uses native adapter", () => {
   assert.deepEqual(transport.poll(1), []);
 });
 
+test("AeronTransport sends batches through one native call", () => {
+  const native = new FakeNative();
+  const transport = new epoch.AeronTransport({ channel: "aeron:ipc", streamId: 1, aeronDirectory: "" }, native);
+  transport.sendBatch([]);
+  transport.sendBatch([1, 2, 3].map((seq) => ({
+    epoch: 1, channelId: 1, sourceId: 1, sourceSeq: seq, schemaId: 1, qos: 0, payload: seq * 10
+  })));
+  assert.deepEqual(transport.poll(8).map((m) => m.payload), [10, 20, 30]);
+});
+
 test("Aeron native adapter wrapper", () => {
   const fakeKoffi = {
     struct() {
@@ -92,7 +108,13 @@ test("Aeron native adapter wrapper", () => {
           if (name === "epoch_aeron_send") {
             return () => 0;
           }
-          if (name === "epoch_aeron_poll") {
+          if (name === "epoch_aeron_send_batch") {
+            return (_handle, _frames, count, sentRef) => {
+              sentRef[0] = count;
+              return 0;
+            };
+          }
+          if (name === "epoch_aeron_poll_batch") {
             return (_handle, frameBuf, _max, countRef) => {
               frameBuf.fill(0);
               countRef[0] = 1;
@@ -126,6 +148,7 @@ test("Aeron native adapter wrapper", () => {
   const native = loadAeronNative(fakeKoffi);
   const handle = native.open({ channel: "aeron:ipc", streamId: 1, aeronDirectory: "" });
   native.send(handle, Buffer.alloc(56));
+  native.sendBatch(handle, Buffer.alloc(112), 2);
   const frames = native.poll(handle, 1);
   assert.equal(frames.length, 1);
   const stats = native.stats(handle);
@@ -56,6 +56,30 @@ test("fnv1a64Hex matches known vectors", () => {
   assert.equal(epoch.fnv1a64Hex("hello"), "a430d84680aabd0b");
 });
 
+test("stateDigest matches known vectors", () => {
+  assert.equal(epoch.stateDigestHex(0), "68752350ae1d483f");
+
+  const forward = new epoch.StateDigest();
+  forward.add(7, Buffer.from("bid"));
+  forward.add(3, -5);
+  assert.equal(forward.hex(), "beba82641d751f3b");
+
+  const backward = new epoch.StateDigest();
+  backward.add(3, 1);
+  backward.add(7, Buffer.from("bid"));
+  backward.replace(3, 1, -5);
+  assert.equal(backward.value, forward.value);
+
+  backward.remove(7, Buffer.from("bid"));
+  backward.remove(3, -5);
+  assert.equal(backward.value, 0n);
+
+  const results = epoch.processMessages([
+    { epoch: 1, channelId: 1, sourceId: 1, sourceSeq: 1, schemaId: 100, qos: 0, payload: 10 }
+  ]);
+  assert.equal(results[0].digest, "b492f0b01aa70577");
+});
+
 test("processMessages handles empty input", () => {
   assert.deepEqual(epoch.processMessages([]), []);
 });
@@ -70,9 +94,9 @@ test("processMessages orders epochs and carries state", () => {
 
   const results = epoch.processMessages(messages);
   assert.deepEqual(results, [
-    { epoch: 1, state: 1, hash: "c3c43ef01be7b74f" },
-    { epoch: 2, state: 6, hash: "c3c43bf01be7b236" },
-    { epoch: 3, state: 10, hash: "8e2e70ff6abccccd" }
+    { epoch: 1, state: 1, hash: "c3c43ef01be7b74f", digest: "3a0af29cda6d2c3d" },
+    { epoch: 2, state: 6, hash: "c3c43bf01be7b236", digest: "55ac104db240b84a" },
+    { epoch: 3, state: 10, hash: "8e2e70ff6abccccd", digest: "b492f0b01aa70577" }
   ]);
 });
 
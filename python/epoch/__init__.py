@@ -5,8 +5,17 @@ from .actor_id import (
     default_actor_id_codec,
     encode_actor_id,
 )
-from .aeron_transport import AeronConfig, AeronStats, AeronTransport
-from .engine import EpochResult, Message, fnv1a64_hex, process_messages
+from .aeron_transport import AeronConfig, AeronRingConfig, AeronRingTransport, AeronStats, AeronTransport
+from .engine import (
+    EpochResult,
+    Message,
+    StateDigest,
+    digest_entry,
+    fnv1a64_hex,
+    process_messages,
+    state_digest_hex,
+)
+from .results import read_results_file, write_results_file
 from .transport import InMemoryTransport, Transport
 
 __all__ = [
@@ -20,9 +29,16 @@ __all__ = [
     "EpochResult",
     "fnv1a64_hex",
     "process_messages",
+    "StateDigest",
+    "digest_entry",
+    "state_digest_hex",
+    "write_results_file",
+    "read_results_file",
     "Transport",
     "InMemoryTransport",
     "AeronConfig",
+    "AeronRingConfig",
+    "AeronRingTransport",
     "AeronStats",
     "AeronTransport",
 ]
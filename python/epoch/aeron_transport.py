@@ -1,12 +1,13 @@
 from __future__ import annotations
 
 from dataclasses import dataclass
-from typing import List, Optional
+from typing import List, Optional, Tuple
 
 import ctypes
 import os
 import struct
 import sys
+import time
 
 from .engine import Message
 from .transport import Transport
@@ -16,6 +17,20 @@ FRAME_VERSION = 1
 FRAME_LENGTH = 56
 _FRAME_STRUCT = struct.Struct("<BB6xqqqqqq")
 
+RING_MAGIC = 0x474E5245
+RING_OFFSET_MAGIC = 0
+RING_OFFSET_CAPACITY = 16
+RING_OFFSET_INBOUND_FRAMES = 24
+RING_OFFSET_OUTBOUND_FRAMES = 32
+RING_OFFSET_INBOUND_TAIL = 64
+RING_OFFSET_INBOUND_HEAD = 128
+RING_OFFSET_OUTBOUND_TAIL = 192
+RING_OFFSET_OUTBOUND_HEAD = 256
+RING_OFFSET_IO_PARKED = 320
+RING_OFFSET_STATUS = 448
+RING_OFFSET_OUTBOUND_STATUS = 452
+RING_HEADER_LENGTH = 512
+
 
 @dataclass(frozen=True)
 class AeronConfig:
@@ -26,6 +41,14 @@ class AeronConfig:
     offer_max_attempts: int = 10
 
 
+@dataclass(frozen=True)
+class AeronRingConfig:
+    capacity: int = 4096
+    shm_name: str = ""
+    idle_spin_count: int = 1000
+    idle_park_ns: int = 1_000_000
+
+
 @dataclass(frozen=True)
 class AeronStats:
     sent_count: int
@@ -84,8 +107,17 @@ class _NativeAeron:
             ctypes.c_char_p,
             ctypes.c_size_t,
         ]
-        self._lib.epoch_aeron_poll.restype = ctypes.c_int
-        self._lib.epoch_aeron_poll.argtypes = [
+        self._lib.epoch_aeron_send_batch.restype = ctypes.c_int
+        self._lib.epoch_aeron_send_batch.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_uint8),
+            ctypes.c_size_t,
+            ctypes.POINTER(ctypes.c_size_t),
+            ctypes.c_char_p,
+            ctypes.c_size_t,
+        ]
+        self._lib.epoch_aeron_poll_batch.restype = ctypes.c_int
+        self._lib.epoch_aeron_poll_batch.argtypes = [
             ctypes.c_void_p,
             ctypes.POINTER(ctypes.c_uint8),
             ctypes.c_size_t,
@@ -96,6 +128,28 @@ class _NativeAeron:
         self._lib.epoch_aeron_stats.restype = ctypes.c_int
         self._lib.epoch_aeron_stats.argtypes = [ctypes.c_void_p, ctypes.POINTER(_CStats)]
         self._lib.epoch_aeron_close.argtypes = [ctypes.c_void_p]
+        self._lib.epoch_aeron_ring_open.restype = ctypes.c_void_p
+        self._lib.epoch_aeron_ring_open.argtypes = [
+            ctypes.POINTER(_CConfig),
+            ctypes.POINTER(_CRingConfig),
+            ctypes.c_char_p,
+            ctypes.c_size_t,
+        ]
+        self._lib.epoch_aeron_ring_region.restype = ctypes.c_void_p
+        self._lib.epoch_aeron_ring_region.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_size_t)]
+        self._lib.epoch_aeron_ring_wake.restype = ctypes.c_int
+        self._lib.epoch_aeron_ring_wake.argtypes = [ctypes.c_void_p]
+        self._lib.epoch_aeron_ring_publish.restype = ctypes.c_int
+        self._lib.epoch_aeron_ring_publish.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
+        self._lib.epoch_aeron_ring_inbound_tail.restype = ctypes.c_uint64
+        self._lib.epoch_aeron_ring_inbound_tail.argtypes = [ctypes.c_void_p]
+        self._lib.epoch_aeron_ring_consume.restype = ctypes.c_int
+        self._lib.epoch_aeron_ring_consume.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
+        self._lib.epoch_aeron_ring_park.restype = ctypes.c_int
+        self._lib.epoch_aeron_ring_park.argtypes = [ctypes.c_void_p, ctypes.c_int64]
+        self._lib.epoch_aeron_ring_stats.restype = ctypes.c_int
+        self._lib.epoch_aeron_ring_stats.argtypes = [ctypes.c_void_p, ctypes.POINTER(_CStats)]
+        self._lib.epoch_aeron_ring_close.argtypes = [ctypes.c_void_p]
 
     def open(self, config: AeronConfig) -> ctypes.c_void_p:
         err_buf = ctypes.create_string_buffer(256)
@@ -112,6 +166,27 @@ class _NativeAeron:
         if result < 0:
             raise RuntimeError(err_buf.value.decode("utf-8", errors="ignore"))
 
+    def send_batch(self, handle: ctypes.c_void_p, frames: bytes) -> int:
+        count = len(frames) // FRAME_LENGTH
+        if count == 0:
+            return 0
+        err_buf = ctypes.create_string_buffer(256)
+        data = (ctypes.c_uint8 * len(frames)).from_buffer_copy(frames)
+        out_sent = ctypes.c_size_t()
+        result = self._lib.epoch_aeron_send_batch(
+            handle,
+            data,
+            count,
+            ctypes.byref(out_sent),
+            err_buf,
+            ctypes.sizeof(err_buf),
+        )
+        if result < 0:
+            raise RuntimeError(
+                "%s (sent %d of %d)" % (err_buf.value.decode("utf-8", errors="ignore"), out_sent.value, count)
+            )
+        return out_sent.value
+
     def poll(self, handle: ctypes.c_void_p, max_items: int) -> List[bytes]:
         if max_items <= 0:
             return []
@@ -119,7 +194,7 @@ class _NativeAeron:
         total_len = FRAME_LENGTH * max_items
         buffer = (ctypes.c_uint8 * total_len)()
         out_count = ctypes.c_size_t()
-        result = self._lib.epoch_aeron_poll(
+        result = self._lib.epoch_aeron_poll_batch(
             handle,
             buffer,
             max_items,
@@ -129,11 +204,8 @@ class _NativeAeron:
         )
         if result < 0:
             raise RuntimeError(err_buf.value.decode("utf-8", errors="ignore"))
-        frames = []
-        for i in range(out_count.value):
-            start = i * FRAME_LENGTH
-            frames.append(bytes(buffer[start : start + FRAME_LENGTH]))
-        return frames
+        raw = bytes(buffer)
+        return [raw[i * FRAME_LENGTH : (i + 1) * FRAME_LENGTH] for i in range(out_count.value)]
 
     def stats(self, handle: ctypes.c_void_p) -> AeronStats:
         c_stats = _CStats()
@@ -145,6 +217,49 @@ class _NativeAeron:
         if handle:
             self._lib.epoch_aeron_close(handle)
 
+    def ring_open(self, config: AeronConfig, ring_config: AeronRingConfig) -> ctypes.c_void_p:
+        err_buf = ctypes.create_string_buffer(256)
+        c_config = _CConfig.from_config(config)
+        c_ring = _CRingConfig.from_config(ring_config)
+        handle = self._lib.epoch_aeron_ring_open(
+            ctypes.byref(c_config), ctypes.byref(c_ring), err_buf, ctypes.sizeof(err_buf)
+        )
+        if not handle:
+            raise RuntimeError(err_buf.value.decode("utf-8", errors="ignore"))
+        return ctypes.c_void_p(handle)
+
+    def ring_region(self, handle: ctypes.c_void_p) -> Tuple[int, int]:
+        length = ctypes.c_size_t()
+        address = self._lib.epoch_aeron_ring_region(handle, ctypes.byref(length))
+        if not address:
+            raise RuntimeError("aeron ring region unavailable")
+        return address, length.value
+
+    def ring_wake(self, handle: ctypes.c_void_p) -> None:
+        self._lib.epoch_aeron_ring_wake(handle)
+
+    def ring_publish(self, handle: ctypes.c_void_p, tail: int) -> None:
+        self._lib.epoch_aeron_ring_publish(handle, tail)
+
+    def ring_inbound_tail(self, handle: ctypes.c_void_p) -> int:
+        return self._lib.epoch_aeron_ring_inbound_tail(handle)
+
+    def ring_consume(self, handle: ctypes.c_void_p, head: int) -> None:
+        self._lib.epoch_aeron_ring_consume(handle, head)
+
+    def ring_park(self, handle: ctypes.c_void_p, timeout_ns: int) -> bool:
+        return self._lib.epoch_aeron_ring_park(handle, timeout_ns) > 0
+
+    def ring_stats(self, handle: ctypes.c_void_p) -> AeronStats:
+        c_stats = _CStats()
+        if self._lib.epoch_aeron_ring_stats(handle, ctypes.byref(c_stats)) < 0:
+            return AeronStats(0, 0, 0, 0, 0, 0, 0, 0)
+        return c_stats.to_stats()
+
+    def ring_close(self, handle: ctypes.c_void_p) -> None:
+        if handle:
+            self._lib.epoch_aeron_ring_close(handle)
+
 
 class _CConfig(ctypes.Structure):
     _fields_ = [
@@ -166,6 +281,24 @@ class _CConfig(ctypes.Structure):
         )
 
 
+class _CRingConfig(ctypes.Structure):
+    _fields_ = [
+        ("capacity", ctypes.c_size_t),
+        ("shm_name", ctypes.c_char_p),
+        ("idle_spin_count", ctypes.c_int32),
+        ("idle_park_ns", ctypes.c_int64),
+    ]
+
+    @staticmethod
+    def from_config(config: AeronRingConfig) -> "_CRingConfig":
+        return _CRingConfig(
+            capacity=config.capacity,
+            shm_name=config.shm_name.encode("utf-8") if config.shm_name else None,
+            idle_spin_count=config.idle_spin_count,
+            idle_park_ns=config.idle_park_ns,
+        )
+
+
 class _CStats(ctypes.Structure):
     _fields_ = [
         ("sent_count", ctypes.c_int64),
@@ -213,6 +346,15 @@ class AeronTransport(Transport):
         frame = encode_aeron_frame(message)
         self._native.send(self._handle, frame)
 
+    def send_batch(self, messages: List[Message]) -> None:
+        if self._closed:
+            raise RuntimeError("aeron transport closed")
+        if not messages:
+            return None
+        frames = b"".join(encode_aeron_frame(message) for message in messages)
+        self._native.send_batch(self._handle, frames)
+        return None
+
     def poll(self, max_items: int) -> List[Message]:
         if self._closed:
             return []
@@ -227,6 +369,143 @@ class AeronTransport(Transport):
         return None
 
 
+class _RingView:
+    """Host half of the native SPSC rings. Frames are copied through the shared region; the index accesses
+    that order them (outbound tail, inbound tail and head) go through the native helpers, because plain ctypes
+    loads and stores carry no acquire/release ordering on weakly ordered CPUs such as arm64."""
+
+    def __init__(self, address: int, length: int) -> None:
+        self._buffer = (ctypes.c_uint8 * length).from_address(address)
+        self._view = memoryview(self._buffer).cast("B")
+        if ctypes.c_uint32.from_buffer(self._buffer, RING_OFFSET_MAGIC).value != RING_MAGIC:
+            raise RuntimeError("invalid aeron ring region")
+        self.capacity = ctypes.c_uint64.from_buffer(self._buffer, RING_OFFSET_CAPACITY).value
+        self._mask = self.capacity - 1
+        self._inbound = ctypes.c_uint64.from_buffer(self._buffer, RING_OFFSET_INBOUND_FRAMES).value
+        self._outbound = ctypes.c_uint64.from_buffer(self._buffer, RING_OFFSET_OUTBOUND_FRAMES).value
+        self._inbound_head = ctypes.c_uint64.from_buffer(self._buffer, RING_OFFSET_INBOUND_HEAD)
+        self._outbound_tail = ctypes.c_uint64.from_buffer(self._buffer, RING_OFFSET_OUTBOUND_TAIL)
+        self._outbound_head = ctypes.c_uint64.from_buffer(self._buffer, RING_OFFSET_OUTBOUND_HEAD)
+        self._status = ctypes.c_int32.from_buffer(self._buffer, RING_OFFSET_STATUS)
+        self._outbound_status = ctypes.c_int32.from_buffer(self._buffer, RING_OFFSET_OUTBOUND_STATUS)
+
+    def outbound_tail(self) -> int:
+        # Only the host writes the outbound tail, so its own last store is always visible to it.
+        return self._outbound_tail.value
+
+    def write(self, tail: int, frame: bytes) -> bool:
+        """Copies frame into outbound slot tail if the I/O thread has freed it; publishing is separate."""
+        if tail - self._outbound_head.value >= self.capacity:
+            return False
+        start = self._outbound + (tail & self._mask) * FRAME_LENGTH
+        self._view[start : start + FRAME_LENGTH] = frame
+        return True
+
+    def inbound_head(self) -> int:
+        return self._inbound_head.value
+
+    def read(self, head: int, tail: int, max_items: int) -> List[bytes]:
+        count = min(tail - head, max_items)
+        frames = []
+        for i in range(count):
+            start = self._inbound + ((head + i) & self._mask) * FRAME_LENGTH
+            frames.append(bytes(self._view[start : start + FRAME_LENGTH]))
+        return frames
+
+    def status(self) -> int:
+        return self._status.value
+
+    def outbound_status(self) -> int:
+        return self._outbound_status.value
+
+    def release(self) -> None:
+        self._view.release()
+
+
+class AeronRingTransport(Transport):
+    """Frames move through shared SPSC rings serviced by a native I/O thread. Each send, send_batch and
+    poll makes one or two small FFI calls to order the ring indices (and wake a parked I/O thread); the
+    frame bytes themselves never cross the FFI boundary."""
+
+    def __init__(
+        self,
+        config: AeronConfig,
+        ring_config: AeronRingConfig = AeronRingConfig(),
+        native: Optional[_NativeAeron] = None,
+    ) -> None:
+        self._config = config
+        self._native = native or _NativeAeron()
+        self._handle = self._native.ring_open(config, ring_config)
+        address, length = self._native.ring_region(self._handle)
+        self._ring = _RingView(address, length)
+        self._closed = False
+
+    @property
+    def config(self) -> AeronConfig:
+        return self._config
+
+    def stats(self) -> AeronStats:
+        if self._closed:
+            return AeronStats(0, 0, 0, 0, 0, 0, 0, 0)
+        return self._native.ring_stats(self._handle)
+
+    def send(self, message: Message) -> None:
+        self._offer([encode_aeron_frame(message)])
+
+    def send_batch(self, messages: List[Message]) -> None:
+        self._offer([encode_aeron_frame(message) for message in messages])
+
+    def poll(self, max_items: int) -> List[Message]:
+        if self._closed or max_items <= 0:
+            return []
+        head = self._ring.inbound_head()
+        frames = self._ring.read(head, self._native.ring_inbound_tail(self._handle), max_items)
+        if frames:
+            self._native.ring_consume(self._handle, head + len(frames))
+        elif self._ring.status() < 0:
+            raise RuntimeError(f"aeron ring failed ({self._ring.status()})")
+        return [decode_aeron_frame(frame) for frame in frames]
+
+    def wait(self, timeout_ns: int) -> bool:
+        if self._closed:
+            return False
+        return self._native.ring_park(self._handle, timeout_ns)
+
+    def close(self) -> None:
+        if self._closed:
+            return None
+        self._closed = True
+        self._ring.release()
+        self._native.ring_close(self._handle)
+        return None
+
+    def _offer(self, frames: List[bytes]) -> None:
+        if self._closed:
+            raise RuntimeError("aeron transport closed")
+        if not frames:
+            return None
+        if self._ring.status() < 0:
+            raise RuntimeError(f"aeron ring failed ({self._ring.status()})")
+        tail = self._ring.outbound_tail()
+        index = 0
+        attempts = 0
+        while index < len(frames):
+            if self._ring.write(tail, frames[index]):
+                tail += 1
+                index += 1
+                attempts = 0
+                continue
+            # Full: hand over what is written so far and let the I/O thread drain it.
+            self._native.ring_publish(self._handle, tail)
+            attempts += 1
+            if attempts >= max(1, self._config.offer_max_attempts):
+                raise RuntimeError(f"aeron ring outbound full (last offer {self._ring.outbound_status()})")
+            self._native.ring_wake(self._handle)
+            time.sleep(0)
+        self._native.ring_publish(self._handle, tail)
+        return None
+
+
 def _find_native_library() -> Optional[str]:
     env_path = os.getenv("EPOCH_AERON_LIBRARY")
     if env_path:
@@ -1,7 +1,7 @@
 from __future__ import annotations
 
-from dataclasses import dataclass
-from typing import Iterable, List
+from dataclasses import dataclass, field
+from typing import Iterable, List, Union
 
 FNV_OFFSET_BASIS = 0xCBF29CE484222325
 FNV_PRIME = 0x100000001B3
@@ -24,6 +24,7 @@ class EpochResult:
     epoch: int
     state: int
     hash: str
+    digest: str = field(default="", compare=False)
 
 
 def fnv1a64_hex(value: str) -> str:
@@ -34,6 +35,55 @@ def fnv1a64_hex(value: str) -> str:
     return f"{h:016x}"
 
 
+def _fnv_bytes(h: int, data: bytes) -> int:
+    for b in data:
+        h ^= b
+        h = (h * FNV_PRIME) & FNV_MASK
+    return h
+
+
+def _mix64(value: int) -> int:
+    value ^= value >> 30
+    value = (value * 0xBF58476D1CE4E5B9) & FNV_MASK
+    value ^= value >> 27
+    value = (value * 0x94D049BB133111EB) & FNV_MASK
+    value ^= value >> 31
+    return value
+
+
+def digest_entry(key: int, value: Union[int, bytes]) -> int:
+    data = (key & FNV_MASK).to_bytes(8, "little")
+    if isinstance(value, int):
+        data += (value & FNV_MASK).to_bytes(8, "little")
+    else:
+        data += bytes(value)
+    return _mix64(_fnv_bytes(FNV_OFFSET_BASIS, data))
+
+
+class StateDigest:
+    """Order-independent multiset digest: sum of digest_entry mod 2^64."""
+
+    def __init__(self) -> None:
+        self.value = 0
+
+    def add(self, key: int, value: Union[int, bytes]) -> None:
+        self.value = (self.value + digest_entry(key, value)) & FNV_MASK
+
+    def remove(self, key: int, value: Union[int, bytes]) -> None:
+        self.value = (self.value - digest_entry(key, value)) & FNV_MASK
+
+    def replace(self, key: int, old_value: int, new_value: int) -> None:
+        self.remove(key, old_value)
+        self.add(key, new_value)
+
+    def hex(self) -> str:
+        return f"{self.value:016x}"
+
+
+def state_digest_hex(state: int) -> str:
+    return f"{digest_entry(0, state):016x}"
+
+
 def process_messages(messages: Iterable[Message]) -> List[EpochResult]:
     ordered = sorted(
         messages,
@@ -52,6 +102,7 @@ def process_messages(messages: Iterable[Message]) -> List[EpochResult]:
                     epoch=current_epoch,
                     state=state,
                     hash=fnv1a64_hex(f"state:{state}"),
+                    digest=state_digest_hex(state),
                 )
             )
             current_epoch = message.epoch
@@ -63,6 +114,7 @@ def process_messages(messages: Iterable[Message]) -> List[EpochResult]:
                 epoch=current_epoch,
                 state=state,
                 hash=fnv1a64_hex(f"state:{state}"),
+                digest=state_digest_hex(state),
             )
         )
 
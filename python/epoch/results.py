@@ -0,0 +1,41 @@
+from __future__ import annotations
+
+import struct
+from typing import Iterable, List
+
+from .engine import EpochResult
+
+RESULTS_MAGIC = b"EPRS"
+RESULTS_VERSION = 1
+_HEADER = struct.Struct("<4sIQ")
+_RECORD = struct.Struct("<qqQQ")
+
+
+def write_results_file(path: str, results: Iterable[EpochResult]) -> int:
+    """Writes the binary results file shared with the C++ FileSink; returns the record count."""
+    count = 0
+    with open(path, "wb") as handle:
+        handle.write(_HEADER.pack(RESULTS_MAGIC, RESULTS_VERSION, 0))
+        for result in results:
+            digest = int(result.digest, 16) if result.digest else 0
+            handle.write(_RECORD.pack(result.epoch, result.state, int(result.hash, 16), digest))
+            count += 1
+    return count
+
+
+def read_results_file(path: str) -> List[EpochResult]:
+    with open(path, "rb") as handle:
+        data = handle.read()
+    if len(data) < _HEADER.size:
+        raise ValueError("not a results file")
+    magic, version, _ = _HEADER.unpack_from(data, 0)
+    if magic != RESULTS_MAGIC:
+        raise ValueError("not a results file")
+    if version != RESULTS_VERSION:
+        raise ValueError(f"unsupported results file version {version}")
+    results: List[EpochResult] = []
+    end = len(data) - (len(data) - _HEADER.size) % _RECORD.size
+    for offset in range(_HEADER.size, end, _RECORD.size):
+        epoch, state, hash_value, digest = _RECORD.unpack_from(data, offset)
+        results.append(EpochResult(epoch=epoch, state=state, hash=f"{hash_value:016x}", digest=f"{digest:016x}"))
+    return results
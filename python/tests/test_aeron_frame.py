@@ -1,7 +1,13 @@
+import ctypes
+import struct
 import unittest
 
 from epoch.aeron_transport import (
+    RING_HEADER_LENGTH,
+    RING_MAGIC,
     AeronConfig,
+    AeronRingConfig,
+    AeronRingTransport,
     AeronStats,
     AeronTransport,
     decode_aeron_frame,
@@ -20,6 +26,12 @@ class FakeNative:
     def send(self, handle: object, frame: bytes) -> None:
         self.frames.append(frame)
 
+    def send_batch(self, handle: object, frames: bytes) -> int:
+        count = len(frames) // 56
+        for i in range(count):
+            self.frames.append(frames[i * 56 : (i + 1) * 56])
+        return count
+
     def poll(self, handle: object, max_items: int) -> list[bytes]:
         out = self.frames[:max_items]
         self.frames = self.frames[max_items:]
@@ -32,6 +44,62 @@ class FakeNative:
         return None
 
 
+class FakeRingNative:
+    """Lays out the ring region like the native library and loops outbound frames back on wake."""
+
+    def __init__(self) -> None:
+        self.wakes = 0
+        self.region = None
+
+    def ring_open(self, config: AeronConfig, ring_config: AeronRingConfig) -> object:
+        capacity = ring_config.capacity
+        length = RING_HEADER_LENGTH + 2 * capacity * 56
+        self.region = (ctypes.c_uint8 * length)()
+        struct.pack_into("<I", self.region, 0, RING_MAGIC)
+        struct.pack_into("<Q", self.region, 16, capacity)
+        struct.pack_into("<Q", self.region, 24, RING_HEADER_LENGTH)
+        struct.pack_into("<Q", self.region, 32, RING_HEADER_LENGTH + capacity * 56)
+        struct.pack_into("<I", self.region, 320, 1)
+        self.capacity = capacity
+        return object()
+
+    def ring_region(self, handle: object) -> tuple:
+        return ctypes.addressof(self.region), len(self.region)
+
+    def ring_wake(self, handle: object) -> None:
+        self.wakes += 1
+        read = lambda offset: struct.unpack_from("<Q", self.region, offset)[0]
+        in_tail, in_head, out_tail, out_head = read(64), read(128), read(192), read(256)
+        while out_head < out_tail and in_tail - in_head < self.capacity:
+            src = RING_HEADER_LENGTH + self.capacity * 56 + (out_head % self.capacity) * 56
+            dst = RING_HEADER_LENGTH + (in_tail % self.capacity) * 56
+            self.region[dst : dst + 56] = self.region[src : src + 56]
+            out_head += 1
+            in_tail += 1
+        struct.pack_into("<Q", self.region, 64, in_tail)
+        struct.pack_into("<Q", self.region, 256, out_head)
+
+    def ring_publish(self, handle: object, tail: int) -> None:
+        struct.pack_into("<Q", self.region, 192, tail)
+        if struct.unpack_from("<I", self.region, 320)[0]:
+            self.ring_wake(handle)
+
+    def ring_inbound_tail(self, handle: object) -> int:
+        return struct.unpack_from("<Q", self.region, 64)[0]
+
+    def ring_consume(self, handle: object, head: int) -> None:
+        struct.pack_into("<Q", self.region, 128, head)
+
+    def ring_park(self, handle: object, timeout_ns: int) -> bool:
+        return struct.unpack_from("<Q", self.region, 64)[0] != struct.unpack_from("<Q", self.region, 128)[0]
+
+    def ring_stats(self, handle: object) -> AeronStats:
+        return AeronStats(0, 0, 0, 0, 0, 0, 0, 0)
+
+    def ring_close(self, handle: object) -> None:
+        return None
+
+
 class AeronFrameTests(unittest.TestCase):
     def test_round_trip(self) -> None:
         message = Message(1, 2, 3, 4, 5, 6, -7)
@@ -55,6 +123,56 @@ class AeronFrameTests(unittest.TestCase):
         transport.close()
         self.assertEqual(transport.poll(1), [])
 
+    def test_transport_send_batch(self) -> None:
+        native = FakeNative()
+        transport = AeronTransport(AeronConfig("aeron:ipc", 1, ""), native=native)
+        transport.send_batch([Message(1, 1, 1, seq, 1, 0, seq * 10) for seq in range(1, 4)])
+        transport.send_batch([])
+        self.assertEqual([m.payload for m in transport.poll(8)], [10, 20, 30])
+        transport.close()
+        with self.assertRaises(RuntimeError):
+            transport.send_batch([Message(1, 1, 1, 4, 1, 0, 40)])
+
+    def test_ring_transport_loopback(self) -> None:
+        native = FakeRingNative()
+        transport = AeronRingTransport(
+            AeronConfig("aeron:ipc", 1, "", offer_max_attempts=2), AeronRingConfig(capacity=4), native=native
+        )
+        self.assertFalse(transport.wait(0))
+        transport.send_batch([Message(1, 1, 1, seq, 1, 0, seq) for seq in range(1, 7)])
+        self.assertTrue(transport.wait(0))
+        self.assertEqual([m.payload for m in transport.poll(3)], [1, 2, 3])
+        self.assertEqual([m.payload for m in transport.poll(8)], [4])
+        native.ring_wake(None)
+        self.assertEqual([m.payload for m in transport.poll(8)], [5, 6])
+        self.assertGreater(native.wakes, 0)
+        transport.close()
+        self.assertEqual(transport.poll(1), [])
+        with self.assertRaises(RuntimeError):
+            transport.send(Message(1, 1, 1, 9, 1, 0, 9))
+
+    def test_ring_transport_reports_failed_subscription(self) -> None:
+        native = FakeRingNative()
+        transport = AeronRingTransport(AeronConfig("aeron:ipc", 1, ""), AeronRingConfig(capacity=4), native=native)
+        transport.send(Message(1, 1, 1, 1, 1, 0, 5))
+        struct.pack_into("<i", native.region, 448, -1)
+        self.assertEqual([m.payload for m in transport.poll(8)], [5])
+        with self.assertRaises(RuntimeError):
+            transport.poll(8)
+        with self.assertRaises(RuntimeError):
+            transport.send(Message(1, 1, 1, 2, 1, 0, 6))
+        transport.close()
+
+    def test_ring_transport_reports_stalled_offers(self) -> None:
+        native = FakeRingNative()
+        transport = AeronRingTransport(
+            AeronConfig("aeron:ipc", 1, "", offer_max_attempts=2), AeronRingConfig(capacity=4), native=native
+        )
+        native.ring_wake = lambda handle: struct.pack_into("<i", native.region, 452, -1)
+        with self.assertRaisesRegex(RuntimeError, "last offer -1"):
+            transport.send_batch([Message(1, 1, 1, seq, 1, 0, seq) for seq in range(1, 7)])
+        transport.close()
+
 
 if __name__ == "__main__":
     unittest.main()
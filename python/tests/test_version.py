@@ -1,4 +1,5 @@
 import os
+import tempfile
 import unittest
 
 import epoch
@@ -49,6 +50,23 @@ class VectorTest(unittest.TestCase):
         self.assertEqual(epoch.fnv1a64_hex("state:0"), "c3c43df01be7b59c")
         self.assertEqual(epoch.fnv1a64_hex("hello"), "a430d84680aabd0b")
 
+    def test_state_digest(self):
+        self.assertEqual(epoch.state_digest_hex(0), "68752350ae1d483f")
+        forward = epoch.StateDigest()
+        forward.add(7, b"bid")
+        forward.add(3, -5)
+        self.assertEqual(forward.hex(), "beba82641d751f3b")
+        backward = epoch.StateDigest()
+        backward.add(3, 1)
+        backward.add(7, b"bid")
+        backward.replace(3, 1, -5)
+        self.assertEqual(backward.value, forward.value)
+        backward.remove(7, b"bid")
+        backward.remove(3, -5)
+        self.assertEqual(backward.value, 0)
+        results = epoch.process_messages([epoch.Message(1, 1, 1, 1, 100, 0, 10)])
+        self.assertEqual(results[0].digest, "b492f0b01aa70577")
+
     def test_process_messages_empty(self):
         self.assertEqual(epoch.process_messages([]), [])
 
@@ -65,6 +83,22 @@ class VectorTest(unittest.TestCase):
         self.assertEqual(results[1], epoch.EpochResult(2, 6, "c3c43bf01be7b236"))
         self.assertEqual(results[2], epoch.EpochResult(3, 10, "8e2e70ff6abccccd"))
 
+    def test_results_file_round_trip(self):
+        results = epoch.process_messages(
+            [epoch.Message(1, 1, 1, 1, 100, 0, -7), epoch.Message(2, 1, 1, 2, 100, 0, 10)]
+        )
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "results.bin")
+            self.assertEqual(epoch.write_results_file(path, results), 2)
+            with open(path, "rb") as handle:
+                data = handle.read()
+            self.assertEqual(len(data), 16 + 2 * 32)
+            self.assertEqual(data[:16], b"EPRS\x01" + bytes(11))
+            self.assertEqual(data[24:32], (-7).to_bytes(8, "little", signed=True))
+            loaded = epoch.read_results_file(path)
+        self.assertEqual(loaded, results)
+        self.assertEqual([r.digest for r in loaded], [r.digest for r in results])
+
     def test_in_memory_transport(self):
         transport = epoch.InMemoryTransport()
         transport.send(epoch.Message(1, 1, 1, 1, 100, 0, 1))